@@ -0,0 +1,3 @@
+DELETE FROM `command` WHERE `name`='server mapstats';
+INSERT INTO `command` (`name`,`security`,`help`) VALUES
+('server mapstats',3,'Syntax: .server mapstats [#count|reset]\r\n\r\nShow update timing (last, average, max and histogram in ms) of the #count most expensive maps (default 10), or reset the collected statistics.');
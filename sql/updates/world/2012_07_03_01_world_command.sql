@@ -0,0 +1,5 @@
+DELETE FROM `command` WHERE `name` IN ('server profile','server profile dump','server profile reset');
+INSERT INTO `command` (`name`,`security`,`help`) VALUES
+('server profile',3,'Syntax: .server profile [#count]\r\n\r\nShow the #count (default 10) most expensive world phases, maps, opcode handlers and scripts recorded by the tick profiler.'),
+('server profile dump',3,'Syntax: .server profile dump [$filename]\r\n\r\nWrite the samples recorded by the tick profiler to $filename (default profile.json) in the logs directory, in Chrome trace format.'),
+('server profile reset',3,'Syntax: .server profile reset\r\n\r\nDrop all samples recorded by the tick profiler so far.');
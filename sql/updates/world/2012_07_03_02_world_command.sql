@@ -0,0 +1,3 @@
+DELETE FROM `command` WHERE `name`='server dbstats';
+INSERT INTO `command` (`name`,`security`,`help`) VALUES
+('server dbstats',3,'Syntax: .server dbstats\r\n\r\nShow the queued and executed asynchronous operations of the world, character and login databases and the average and max latency (ms) from queueing to execution.');
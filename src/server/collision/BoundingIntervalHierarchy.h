@@ -30,12 +30,19 @@
 #include <algorithm>
 #include <limits>
 #include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  define BIH_SSE2
+#  include <emmintrin.h>
+#endif
 
 #ifdef __APPLE__
   #define isnan(x) ( std::isnan(x) )
 #endif
 
 #define MAX_STACK_SIZE 64
+#define MAX_RAY_PACKET_SIZE 32                              // rays traversing the tree together, see BIH::intersectRays
 
 #ifdef _MSC_VER
     #define isnan(x) _isnan(x)
@@ -133,35 +140,16 @@ class BIH
         template<typename RayCallback>
         void intersectRay(const Ray &r, RayCallback& intersectCallback, float &maxDist, bool stopAtFirst=false) const
         {
-            float intervalMin = -1.f;
-            float intervalMax = -1.f;
+            float intervalMin;
+            float intervalMax;
             Vector3 org = r.origin();
             Vector3 dir = r.direction();
             Vector3 invDir;
             for (int i=0; i<3; ++i)
-            {
                 invDir[i] = 1.f / dir[i];
-                if (G3D::fuzzyNe(dir[i], 0.0f))
-                {
-                    float t1 = (bounds.low()[i]  - org[i]) * invDir[i];
-                    float t2 = (bounds.high()[i] - org[i]) * invDir[i];
-                    if (t1 > t2)
-                        std::swap(t1, t2);
-                    if (t1 > intervalMin)
-                        intervalMin = t1;
-                    if (t2 < intervalMax || intervalMax < 0.f)
-                        intervalMax = t2;
-                    // intervalMax can only become smaller for other axis,
-                    //  and intervalMin only larger respectively, so stop early
-                    if (intervalMax <= 0 || intervalMin >= maxDist)
-                        return;
-                }
-            }
 
-            if (intervalMin > intervalMax)
+            if (!clipToBounds(org, dir, invDir, maxDist, intervalMin, intervalMax))
                 return;
-            intervalMin = std::max(intervalMin, 0.f);
-            intervalMax = std::min(intervalMax, maxDist);
 
             uint32 offsetFront[3];
             uint32 offsetBack[3];
@@ -269,6 +257,19 @@ class BIH
             }
         }
 
+        /** Intersects count rays with the tree, rays are traversed in packets of up to MAX_RAY_PACKET_SIZE.
+            A packet visits each node once and the clip planes are tested for all its rays together,
+            a node is entered if at least one ray of the packet passes it. Unlike intersectRay the
+            children are not visited front to back, callbacks may see farther objects first.
+            intersectCallback(index, ray, object, maxDist, stopAtFirst) gets the index of the ray
+            in rays, a ray is not tested anymore after its callback returned true with stopAtFirst. */
+        template<typename RayCallback>
+        void intersectRays(const Ray* rays, float* maxDist, uint32 count, RayCallback& intersectCallback, bool stopAtFirst=false) const
+        {
+            for (uint32 first = 0; first < count; first += MAX_RAY_PACKET_SIZE)
+                intersectRayPacket(rays, maxDist, first, std::min<uint32>(count - first, MAX_RAY_PACKET_SIZE), intersectCallback, stopAtFirst);
+        }
+
         template<typename IsectCallback>
         void intersectPoint(const Vector3 &p, IsectCallback& intersectCallback) const
         {
@@ -369,6 +370,291 @@ class BIH
             float tfar;
         };
 
+        // rays of a packet, stored by component so that four rays are clipped with one instruction
+        struct RayPacket
+        {
+            float org[3][MAX_RAY_PACKET_SIZE];
+            float invDir[3][MAX_RAY_PACKET_SIZE];
+            uint32 negDir[3][MAX_RAY_PACKET_SIZE];          // all bits set for negative direction components
+        };
+
+        struct PacketStackNode
+        {
+            uint32 node;
+            uint32 mask;                                    // rays entering the node
+            float tnear[MAX_RAY_PACKET_SIZE];
+            float tfar[MAX_RAY_PACKET_SIZE];
+        };
+
+        // clips the ray to the bounds of the tree, false if the ray misses them within maxDist
+        bool clipToBounds(const Vector3& org, const Vector3& dir, const Vector3& invDir, float maxDist, float& intervalMin, float& intervalMax) const
+        {
+            intervalMin = -1.f;
+            intervalMax = -1.f;
+            for (int i=0; i<3; ++i)
+            {
+                if (G3D::fuzzyNe(dir[i], 0.0f))
+                {
+                    float t1 = (bounds.low()[i]  - org[i]) * invDir[i];
+                    float t2 = (bounds.high()[i] - org[i]) * invDir[i];
+                    if (t1 > t2)
+                        std::swap(t1, t2);
+                    if (t1 > intervalMin)
+                        intervalMin = t1;
+                    if (t2 < intervalMax || intervalMax < 0.f)
+                        intervalMax = t2;
+                    // intervalMax can only become smaller for other axis,
+                    //  and intervalMin only larger respectively, so stop early
+                    if (intervalMax <= 0 || intervalMin >= maxDist)
+                        return false;
+                }
+            }
+
+            if (intervalMin > intervalMax)
+                return false;
+            intervalMin = std::max(intervalMin, 0.f);
+            intervalMax = std::min(intervalMax, maxDist);
+            return true;
+        }
+
+#ifdef BIH_SSE2
+        static inline __m128 selectPs(__m128 mask, __m128 a, __m128 b)
+        {
+            return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+        }
+#endif
+
+        /* Splits the intervals of the rays at an interior node, the rays enter the left child for the part
+           with coordinate <= leftClip and the right child for the part with coordinate >= rightClip.
+           The left intervals replace tnear/tfar. A NaN clip distance (ray in the plane) keeps the interval. */
+        static void splitPacket(const RayPacket& packet, uint32 lanes, uint32 axis, float leftClip, float rightClip,
+            float* tnear, float* tfar, float* rightNear, float* rightFar, uint32& leftMask, uint32& rightMask)
+        {
+            const float* org = packet.org[axis];
+            const float* invDir = packet.invDir[axis];
+            const uint32* negDir = packet.negDir[axis];
+            leftMask = 0;
+            rightMask = 0;
+            uint32 i = 0;
+#ifdef BIH_SSE2
+            __m128 inf = _mm_set1_ps(std::numeric_limits<float>::infinity());
+            __m128 negInf = _mm_set1_ps(-std::numeric_limits<float>::infinity());
+            __m128 left = _mm_set1_ps(leftClip);
+            __m128 right = _mm_set1_ps(rightClip);
+            for (; i + 4 <= lanes; i += 4)
+            {
+                __m128 o = _mm_loadu_ps(org + i);
+                __m128 inv = _mm_loadu_ps(invDir + i);
+                __m128 neg = _mm_castsi128_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(negDir + i)));
+                __m128 n = _mm_loadu_ps(tnear + i);
+                __m128 f = _mm_loadu_ps(tfar + i);
+                __m128 tl = _mm_mul_ps(_mm_sub_ps(left, o), inv);
+                __m128 tr = _mm_mul_ps(_mm_sub_ps(right, o), inv);
+                // min/max return their second operand for NaN
+                __m128 ln = _mm_max_ps(selectPs(neg, tl, negInf), n);
+                __m128 lf = _mm_min_ps(selectPs(neg, inf, tl), f);
+                __m128 rn = _mm_max_ps(selectPs(neg, negInf, tr), n);
+                __m128 rf = _mm_min_ps(selectPs(neg, tr, inf), f);
+                _mm_storeu_ps(tnear + i, ln);
+                _mm_storeu_ps(tfar + i, lf);
+                _mm_storeu_ps(rightNear + i, rn);
+                _mm_storeu_ps(rightFar + i, rf);
+                leftMask |= uint32(_mm_movemask_ps(_mm_cmple_ps(ln, lf))) << i;
+                rightMask |= uint32(_mm_movemask_ps(_mm_cmple_ps(rn, rf))) << i;
+            }
+#endif
+            for (; i < lanes; ++i)
+            {
+                float tl = (leftClip - org[i]) * invDir[i];
+                float tr = (rightClip - org[i]) * invDir[i];
+                float n = tnear[i];
+                float f = tfar[i];
+                if (negDir[i])
+                {
+                    tnear[i] = std::max(n, tl);
+                    rightFar[i] = std::min(f, tr);
+                    rightNear[i] = n;
+                }
+                else
+                {
+                    tfar[i] = std::min(f, tl);
+                    rightNear[i] = std::max(n, tr);
+                    rightFar[i] = f;
+                }
+                if (tnear[i] <= tfar[i])
+                    leftMask |= 1u << i;
+                if (rightNear[i] <= rightFar[i])
+                    rightMask |= 1u << i;
+            }
+        }
+
+        // clips the intervals of the rays to the slab [lo, hi] of a BVH2 node, returns the mask of rays still passing
+        static uint32 clipPacket(const RayPacket& packet, uint32 lanes, uint32 axis, float lo, float hi, float* tnear, float* tfar)
+        {
+            const float* org = packet.org[axis];
+            const float* invDir = packet.invDir[axis];
+            const uint32* negDir = packet.negDir[axis];
+            uint32 mask = 0;
+            uint32 i = 0;
+#ifdef BIH_SSE2
+            __m128 low = _mm_set1_ps(lo);
+            __m128 high = _mm_set1_ps(hi);
+            for (; i + 4 <= lanes; i += 4)
+            {
+                __m128 o = _mm_loadu_ps(org + i);
+                __m128 inv = _mm_loadu_ps(invDir + i);
+                __m128 neg = _mm_castsi128_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(negDir + i)));
+                __m128 tl = _mm_mul_ps(_mm_sub_ps(low, o), inv);
+                __m128 th = _mm_mul_ps(_mm_sub_ps(high, o), inv);
+                __m128 n = _mm_max_ps(selectPs(neg, th, tl), _mm_loadu_ps(tnear + i));
+                __m128 f = _mm_min_ps(selectPs(neg, tl, th), _mm_loadu_ps(tfar + i));
+                _mm_storeu_ps(tnear + i, n);
+                _mm_storeu_ps(tfar + i, f);
+                mask |= uint32(_mm_movemask_ps(_mm_cmple_ps(n, f))) << i;
+            }
+#endif
+            for (; i < lanes; ++i)
+            {
+                float tl = (lo - org[i]) * invDir[i];
+                float th = (hi - org[i]) * invDir[i];
+                tnear[i] = std::max(tnear[i], negDir[i] ? th : tl);
+                tfar[i] = std::min(tfar[i], negDir[i] ? tl : th);
+                if (tnear[i] <= tfar[i])
+                    mask |= 1u << i;
+            }
+            return mask;
+        }
+
+        template<typename RayCallback>
+        void intersectRayPacket(const Ray* rays, float* maxDist, uint32 first, uint32 count, RayCallback& intersectCallback, bool stopAtFirst) const
+        {
+            RayPacket packet;
+            float tnear[MAX_RAY_PACKET_SIZE];
+            float tfar[MAX_RAY_PACKET_SIZE];
+            // whole groups of four, the unused rays never enter a node
+            uint32 lanes = (count + 3) & ~3;
+            uint32 mask = 0;
+
+            for (uint32 i = 0; i < lanes; ++i)
+            {
+                tnear[i] = 1.f;
+                tfar[i] = 0.f;
+                for (int a = 0; a < 3; ++a)
+                {
+                    packet.org[a][i] = 0.f;
+                    packet.invDir[a][i] = 0.f;
+                    packet.negDir[a][i] = 0;
+                }
+
+                if (i >= count)
+                    continue;
+
+                const Ray& r = rays[first + i];
+                Vector3 invDir;
+                for (int a = 0; a < 3; ++a)
+                {
+                    invDir[a] = 1.f / r.direction()[a];
+                    packet.org[a][i] = r.origin()[a];
+                    packet.invDir[a][i] = invDir[a];
+                    packet.negDir[a][i] = (floatToRawIntBits(r.direction()[a]) >> 31) ? 0xFFFFFFFF : 0;
+                }
+
+                if (clipToBounds(r.origin(), r.direction(), invDir, maxDist[first + i], tnear[i], tfar[i]))
+                    mask |= 1u << i;
+            }
+
+            PacketStackNode stack[MAX_STACK_SIZE];
+            int stackPos = 0;
+            uint32 node = 0;
+            uint32 finished = 0;                            // rays which hit with stopAtFirst
+
+            while (true)
+            {
+                while (mask)
+                {
+                    uint32 tn = tree[node];
+                    uint32 axis = (tn & (3 << 30)) >> 30;
+                    bool BVH2 = tn & (1 << 29);
+                    uint32 offset = tn & ~(7 << 29);
+                    if (!BVH2)
+                    {
+                        if (axis < 3)
+                        {
+                            // "normal" interior node, the left child continues, the right one is pushed if both are entered
+                            PacketStackNode& right = stack[stackPos];
+                            uint32 leftMask, rightMask;
+                            splitPacket(packet, lanes, axis, intBitsToFloat(tree[node + 1]), intBitsToFloat(tree[node + 2]),
+                                tnear, tfar, right.tnear, right.tfar, leftMask, rightMask);
+                            leftMask &= mask;
+                            rightMask &= mask;
+                            if (leftMask && rightMask)
+                            {
+                                right.node = offset + 3;
+                                right.mask = rightMask;
+                                ++stackPos;
+                            }
+                            else if (rightMask)
+                            {
+                                memcpy(tnear, right.tnear, lanes * sizeof(float));
+                                memcpy(tfar, right.tfar, lanes * sizeof(float));
+                                node = offset + 3;
+                                mask = rightMask;
+                                continue;
+                            }
+                            node = offset;
+                            mask = leftMask;
+                            continue;
+                        }
+                        else
+                        {
+                            // leaf - test some objects
+                            for (uint32 n = tree[node + 1]; n > 0; --n, ++offset)
+                            {
+                                for (uint32 i = 0; i < count; ++i)
+                                {
+                                    if (!(mask & (1u << i)))
+                                        continue;
+
+                                    bool hit = intersectCallback(first + i, rays[first + i], objects[offset], maxDist[first + i], stopAtFirst);
+                                    if (stopAtFirst && hit)
+                                    {
+                                        finished |= 1u << i;
+                                        mask &= ~(1u << i);
+                                    }
+                                }
+                            }
+                            break;
+                        }
+                    }
+                    else
+                    {
+                        if (axis>2)
+                            return; // should not happen
+                        mask &= clipPacket(packet, lanes, axis, intBitsToFloat(tree[node + 1]), intBitsToFloat(tree[node + 2]), tnear, tfar);
+                        node = offset;
+                    }
+                } // traversal loop
+
+                do
+                {
+                    // stack is empty?
+                    if (stackPos == 0)
+                        return;
+                    // move back up the stack, without the rays which hit or found a closer hit in the meantime
+                    stackPos--;
+                    PacketStackNode const& entry = stack[stackPos];
+                    mask = entry.mask & ~finished;
+                    for (uint32 i = 0; i < count; ++i)
+                        if ((mask & (1u << i)) && maxDist[first + i] < entry.tnear[i])
+                            mask &= ~(1u << i);
+                } while (!mask);
+
+                node = stack[stackPos].node;
+                memcpy(tnear, stack[stackPos].tnear, lanes * sizeof(float));
+                memcpy(tfar, stack[stackPos].tfar, lanes * sizeof(float));
+            }
+        }
+
         class BuildStats
         {
             private:
@@ -22,6 +22,11 @@
 #include <string>
 #include "Define.h"
 
+namespace G3D
+{
+    class Vector3;
+}
+
 //===========================================================
 
 /**
@@ -63,6 +68,12 @@ namespace VMAP
             virtual bool isInLineOfSight(unsigned int pMapId, float x1, float y1, float z1, float x2, float y2, float z2) = 0;
             virtual float getHeight(unsigned int pMapId, float x, float y, float z, float maxSearchDist) = 0;
             /**
+            batch versions of isInLineOfSight and getHeight for count segments or points in game coordinates,
+            all of them are tested in shared traversals of the map tree
+            */
+            virtual void isInLineOfSight(unsigned int pMapId, const G3D::Vector3* pos1, const G3D::Vector3* pos2, uint32 count, bool* results) = 0;
+            virtual void getHeights(unsigned int pMapId, const G3D::Vector3* pos, uint32 count, float maxSearchDist, float* heights) = 0;
+            /**
             test if we hit an object. return true if we hit one. rx, ry, rz will hold the hit position or the dest position, if no intersection was found
             return a position, that is pReduceDist closer to the origin
             */
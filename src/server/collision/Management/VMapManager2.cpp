@@ -150,6 +150,28 @@ namespace VMAP
         return true;
     }
 
+    void VMapManager2::isInLineOfSight(unsigned int mapId, const Vector3* pos1, const Vector3* pos2, uint32 count, bool* results)
+    {
+        InstanceTreeMap::iterator instanceTree = iInstanceMapTrees.find(mapId);
+        if (!isLineOfSightCalcEnabled() || DisableMgr::IsDisabledFor(DISABLE_TYPE_VMAP, mapId, NULL, VMAP_DISABLE_LOS) ||
+            instanceTree == iInstanceMapTrees.end())
+        {
+            std::fill(results, results + count, true);
+            return;
+        }
+
+        std::vector<Vector3> from(count);
+        std::vector<Vector3> to(count);
+        for (uint32 i = 0; i < count; ++i)
+        {
+            from[i] = convertPositionToInternalRep(pos1[i].x, pos1[i].y, pos1[i].z);
+            to[i] = convertPositionToInternalRep(pos2[i].x, pos2[i].y, pos2[i].z);
+        }
+
+        if (count)
+            instanceTree->second->isInLineOfSight(&from[0], &to[0], count, results);
+    }
+
     /**
     get the hit position and return true if we hit something
     otherwise the result pos will be the dest pos
@@ -203,6 +225,28 @@ namespace VMAP
         return VMAP_INVALID_HEIGHT_VALUE;
     }
 
+    void VMapManager2::getHeights(unsigned int mapId, const Vector3* pos, uint32 count, float maxSearchDist, float* heights)
+    {
+        InstanceTreeMap::iterator instanceTree = iInstanceMapTrees.find(mapId);
+        if (!isHeightCalcEnabled() || DisableMgr::IsDisabledFor(DISABLE_TYPE_VMAP, mapId, NULL, VMAP_DISABLE_HEIGHT) ||
+            instanceTree == iInstanceMapTrees.end())
+        {
+            std::fill(heights, heights + count, VMAP_INVALID_HEIGHT_VALUE);
+            return;
+        }
+
+        std::vector<Vector3> internalPos(count);
+        for (uint32 i = 0; i < count; ++i)
+            internalPos[i] = convertPositionToInternalRep(pos[i].x, pos[i].y, pos[i].z);
+
+        if (count)
+            instanceTree->second->getHeights(&internalPos[0], count, maxSearchDist, heights);
+
+        for (uint32 i = 0; i < count; ++i)
+            if (!(heights[i] < G3D::inf()))
+                heights[i] = VMAP_INVALID_HEIGHT_VALUE;     // No height
+    }
+
     bool VMapManager2::getAreaInfo(unsigned int mapId, float x, float y, float& z, uint32& flags, int32& adtId, int32& rootId, int32& groupId) const
     {
         if (!DisableMgr::IsDisabledFor(DISABLE_TYPE_VMAP, mapId, NULL, VMAP_DISABLE_AREAFLAG))
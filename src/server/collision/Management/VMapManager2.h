@@ -92,11 +92,13 @@ namespace VMAP
             void unloadMap(unsigned int mapId);
 
             bool isInLineOfSight(unsigned int mapId, float x1, float y1, float z1, float x2, float y2, float z2) ;
+            void isInLineOfSight(unsigned int mapId, const G3D::Vector3* pos1, const G3D::Vector3* pos2, uint32 count, bool* results);
             /**
             fill the hit pos and return true, if an object was hit
             */
             bool getObjectHitPos(unsigned int mapId, float x1, float y1, float z1, float x2, float y2, float z2, float& rx, float& ry, float& rz, float modifyDist);
             float getHeight(unsigned int mapId, float x, float y, float z, float maxSearchDist);
+            void getHeights(unsigned int mapId, const G3D::Vector3* pos, uint32 count, float maxSearchDist, float* heights);
 
             bool processCommand(char* /*command*/) { return false; } // for debug and extensions
 
@@ -55,6 +55,22 @@ namespace VMAP
         bool hit;
     };
 
+    class MapRayPacketCallback
+    {
+        public:
+            MapRayPacketCallback(ModelInstance* val, bool* hits): prims(val), hits(hits) {}
+            bool operator()(uint32 index, const G3D::Ray& ray, uint32 entry, float& distance, bool pStopAtFirstHit=true)
+            {
+                bool result = prims[entry].intersectRay(ray, distance, pStopAtFirstHit);
+                if (result)
+                    hits[index] = true;
+                return result;
+            }
+    protected:
+        ModelInstance* prims;
+        bool* hits;
+    };
+
     class AreaInfoCallback
     {
         public:
@@ -172,6 +188,70 @@ namespace VMAP
 
         return true;
     }
+    //=========================================================
+
+    void StaticMapTree::isInLineOfSight(const Vector3* pos1, const Vector3* pos2, uint32 count, bool* results) const
+    {
+        std::vector<G3D::Ray> rays;
+        std::vector<float> maxDist;
+        std::vector<uint32> indices;
+        rays.reserve(count);
+        maxDist.reserve(count);
+        indices.reserve(count);
+
+        for (uint32 i = 0; i < count; ++i)
+        {
+            results[i] = true;
+            float dist = (pos2[i] - pos1[i]).magnitude();
+            // valid map coords should *never ever* produce float overflow, but this would produce NaNs too
+            ASSERT(dist < std::numeric_limits<float>::max());
+            // prevent NaN values which can cause BIH intersection to enter infinite loop
+            if (dist < 1e-10f)
+                continue;
+
+            rays.push_back(G3D::Ray::fromOriginAndDirection(pos1[i], (pos2[i] - pos1[i])/dist));
+            maxDist.push_back(dist);
+            indices.push_back(i);
+        }
+
+        if (rays.empty())
+            return;
+
+        bool* hits = new bool[rays.size()];
+        memset(hits, 0, rays.size() * sizeof(bool));
+
+        MapRayPacketCallback intersectionCallBack(iTreeValues, hits);
+        iTree.intersectRays(&rays[0], &maxDist[0], uint32(rays.size()), intersectionCallBack, true);
+
+        for (size_t i = 0; i < rays.size(); ++i)
+            results[indices[i]] = !hits[i];
+
+        delete[] hits;
+    }
+
+    void StaticMapTree::getHeights(const Vector3* pos, uint32 count, float maxSearchDist, float* heights) const
+    {
+        if (!count)
+            return;
+
+        std::vector<G3D::Ray> rays;
+        std::vector<float> maxDist(count, maxSearchDist);
+        rays.reserve(count);
+        for (uint32 i = 0; i < count; ++i)
+            rays.push_back(G3D::Ray(pos[i], Vector3(0, 0, -1)));   // direction with length of 1
+
+        bool* hits = new bool[count];
+        memset(hits, 0, count * sizeof(bool));
+
+        MapRayPacketCallback intersectionCallBack(iTreeValues, hits);
+        iTree.intersectRays(&rays[0], &maxDist[0], count, intersectionCallBack, false);
+
+        for (uint32 i = 0; i < count; ++i)
+            heights[i] = hits[i] ? pos[i].z - maxDist[i] : G3D::inf();
+
+        delete[] hits;
+    }
+
     //=========================================================
     /**
     When moving from pos1 to pos2 check if we hit an object. Return true and the position if we hit one
@@ -71,6 +71,9 @@ namespace VMAP
             bool isInLineOfSight(const G3D::Vector3& pos1, const G3D::Vector3& pos2) const;
             bool getObjectHitPos(const G3D::Vector3& pos1, const G3D::Vector3& pos2, G3D::Vector3& pResultHitPos, float pModifyDist) const;
             float getHeight(const G3D::Vector3& pPos, float maxSearchDist) const;
+            // batch versions, all segments or points are tested in shared traversals of the tree
+            void isInLineOfSight(const G3D::Vector3* pos1, const G3D::Vector3* pos2, uint32 count, bool* results) const;
+            void getHeights(const G3D::Vector3* pos, uint32 count, float maxSearchDist, float* heights) const;
             bool getAreaInfo(G3D::Vector3 &pos, uint32 &flags, int32 &adtId, int32 &rootId, int32 &groupId) const;
             bool GetLocationInfo(const Vector3 &pos, LocationInfo &info) const;
 
@@ -35,6 +35,22 @@
 #include "ScriptedGossip.h"
 #include "CreatureTextMgr.h"
 #include "MoveSplineInit.h"
+#include "TickProfiler.h"
+
+// names of the SmartScriptType values for the tick profiler
+static char const* const SmartScriptProfileNames[SMART_SCRIPT_TYPE_MAX] =
+{
+    "SmartScript creature",
+    "SmartScript gameobject",
+    "SmartScript areatrigger",
+    "SmartScript event",
+    "SmartScript gossip",
+    "SmartScript quest",
+    "SmartScript spell",
+    "SmartScript transport",
+    "SmartScript instance",
+    "SmartScript timed actionlist"
+};
 
 class TrinityStringTextBuilder
 {
@@ -2379,6 +2395,8 @@ void SmartScript::ProcessEvent(SmartScriptHolder& e, Unit* unit, uint32 var0, ui
     if ((e.event.event_phase_mask && !IsInPhase(e.event.event_phase_mask)) || ((e.event.event_flags & SMART_EVENT_FLAG_NOT_REPEATABLE) && e.runOnce))
         return;
 
+    ProfileScope profile(PROFILE_SMARTSCRIPT, e.GetScriptType() < SMART_SCRIPT_TYPE_MAX ? SmartScriptProfileNames[e.GetScriptType()] : NULL, uint32(e.entryOrGuid));
+
     switch (e.GetEventType())
     {
         case SMART_EVENT_LINK://special handling
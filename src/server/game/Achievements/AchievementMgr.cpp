@@ -505,7 +505,7 @@ void AchievementMgr::DeleteFromDB(uint32 lowguid)
     stmt->setUInt32(0, lowguid);
     trans->Append(stmt);
 
-    CharacterDatabase.CommitTransaction(trans);
+    CharacterDatabase.CommitTransaction(trans, lowguid);
 }
 
 void AchievementMgr::SaveToDB(SQLTransaction& trans)
@@ -612,7 +612,7 @@ void AchievementMgr::SaveToDB(SQLTransaction& trans)
     }
 }
 
-void AchievementMgr::LoadFromDB(PreparedQueryResult achievementResult, PreparedQueryResult criteriaResult)
+void AchievementMgr::LoadFromDB(PreparedQueryResult achievementResult, PreparedQueryResult criteriaResult, CompletedAchievementMap& completed, CriteriaProgressMap& progress)
 {
     if (achievementResult)
     {
@@ -626,17 +626,9 @@ void AchievementMgr::LoadFromDB(PreparedQueryResult achievementResult, PreparedQ
             if (!achievement)
                 continue;
 
-            CompletedAchievementData& ca = m_completedAchievements[achievementid];
+            CompletedAchievementData& ca = completed[achievementid];
             ca.date = time_t(fields[1].GetUInt32());
             ca.changed = false;
-
-            // title achievement rewards are retroactive
-            if (AchievementReward const* reward = sAchievementMgr->GetAchievementReward(achievement))
-                if (uint32 titleId = reward->titleId[Player::TeamForRace(GetPlayer()->getRace()) == ALLIANCE ? 0 : 1])
-                    if (CharTitlesEntry const* titleEntry = sCharTitlesStore.LookupEntry(titleId))
-                        if (!GetPlayer()->HasTitle(titleEntry))
-                            GetPlayer()->SetTitle(titleEntry);
-
         } while (achievementResult->NextRow());
     }
 
@@ -659,7 +651,7 @@ void AchievementMgr::LoadFromDB(PreparedQueryResult achievementResult, PreparedQ
 
                 stmt->setUInt16(0, uint16(id));
 
-                CharacterDatabase.Execute(stmt);
+                CharacterDatabase.ExecuteForAllKeys(stmt);
 
                 continue;
             }
@@ -667,14 +659,28 @@ void AchievementMgr::LoadFromDB(PreparedQueryResult achievementResult, PreparedQ
             if (criteria->timeLimit && time_t(date + criteria->timeLimit) < time(NULL))
                 continue;
 
-            CriteriaProgress& progress = m_criteriaProgress[id];
-            progress.counter = counter;
-            progress.date    = date;
-            progress.changed = false;
+            CriteriaProgress& criteriaProgress = progress[id];
+            criteriaProgress.counter = counter;
+            criteriaProgress.date    = date;
+            criteriaProgress.changed = false;
         } while (criteriaResult->NextRow());
     }
 }
 
+void AchievementMgr::LoadFromDB(CompletedAchievementMap& completed, CriteriaProgressMap& progress)
+{
+    m_completedAchievements.swap(completed);
+    m_criteriaProgress.swap(progress);
+
+    // title achievement rewards are retroactive
+    for (CompletedAchievementMap::const_iterator itr = m_completedAchievements.begin(); itr != m_completedAchievements.end(); ++itr)
+        if (AchievementReward const* reward = sAchievementMgr->GetAchievementReward(sAchievementStore.LookupEntry(itr->first)))
+            if (uint32 titleId = reward->titleId[Player::TeamForRace(GetPlayer()->getRace()) == ALLIANCE ? 0 : 1])
+                if (CharTitlesEntry const* titleEntry = sCharTitlesStore.LookupEntry(titleId))
+                    if (!GetPlayer()->HasTitle(titleEntry))
+                        GetPlayer()->SetTitle(titleEntry);
+}
+
 void AchievementMgr::SendAchievementEarned(AchievementEntry const* achievement) const
 {
     if (GetPlayer()->GetSession()->PlayerLoading())
@@ -2099,7 +2105,7 @@ void AchievementMgr::CompletedAchievement(AchievementEntry const* achievement)
         }
 
         draft.SendMailTo(trans, GetPlayer(), MailSender(MAIL_CREATURE, reward->sender));
-        CharacterDatabase.CommitTransaction(trans);
+        CharacterDatabase.CommitTransaction(trans, GetPlayer()->GetGUIDLow());
     }
 }
 
@@ -2428,7 +2434,7 @@ void AchievementGlobalMgr::LoadCompletedAchievements()
 
             stmt->setUInt16(0, uint16(achievementId));
 
-            CharacterDatabase.Execute(stmt);
+            CharacterDatabase.ExecuteForAllKeys(stmt);
 
             continue;
         }
@@ -251,7 +251,10 @@ class AchievementMgr
 
         void Reset();
         static void DeleteFromDB(uint32 lowguid);
-        void LoadFromDB(PreparedQueryResult achievementResult, PreparedQueryResult criteriaResult);
+        // reads the completed achievements and the criteria progress of a character, touches no player and may run on any thread
+        static void LoadFromDB(PreparedQueryResult achievementResult, PreparedQueryResult criteriaResult, CompletedAchievementMap& completed, CriteriaProgressMap& progress);
+        // takes over the data read by the static LoadFromDB by swapping it with the current one
+        void LoadFromDB(CompletedAchievementMap& completed, CriteriaProgressMap& progress);
         void SaveToDB(SQLTransaction& trans);
         void ResetAchievementCriteria(AchievementCriteriaTypes type, uint32 miscvalue1 = 0, uint32 miscvalue2 = 0, bool evenIfCriteriaComplete = false);
         void UpdateAchievementCriteria(AchievementCriteriaTypes type, uint32 miscValue1 = 0, uint32 miscValue2 = 0, Unit* unit = NULL);
@@ -30,6 +30,7 @@
 #include "Item.h"
 #include "Language.h"
 #include "Logging/Log.h"
+#include <algorithm>
 #include <vector>
 
 enum eAuctionHouse
@@ -459,13 +460,33 @@ void AuctionHouseObject::AddAuction(AuctionEntry* auction)
     ASSERT(auction);
 
     AuctionsMap[auction->Id] = auction;
+
+    if (ItemTemplate const* proto = sObjectMgr->GetItemTemplate(auction->item_template))
+    {
+        ItemIndex[MakeItemIndexKey(proto->Class, proto->SubClass, proto->ItemId)].insert(auction);
+        ClearSearchResults(proto);
+    }
+
     sScriptMgr->OnAuctionAdd(this, auction);
 }
 
-bool AuctionHouseObject::RemoveAuction(AuctionEntry* auction, uint32 /*item_template*/)
+bool AuctionHouseObject::RemoveAuction(AuctionEntry* auction, uint32 item_template)
 {
     bool wasInMap = AuctionsMap.erase(auction->Id) ? true : false;
 
+    if (ItemTemplate const* proto = sObjectMgr->GetItemTemplate(item_template))
+    {
+        AuctionItemIndex::iterator itr = ItemIndex.find(MakeItemIndexKey(proto->Class, proto->SubClass, proto->ItemId));
+        if (itr != ItemIndex.end())
+        {
+            itr->second.erase(auction);
+            if (itr->second.empty())
+                ItemIndex.erase(itr);
+        }
+
+        ClearSearchResults(proto);
+    }
+
     sScriptMgr->OnAuctionRemove(this, auction);
 
     // we need to delete the entry, it is not referenced any more
@@ -520,7 +541,7 @@ void AuctionHouseObject::Update()
 
         ///- In any case clear the auction
         auction->DeleteFromDB(trans);
-        CharacterDatabase.CommitTransaction(trans);
+        CharacterDatabase.CommitTransaction(trans, 0, auction->owner, auction->bidder);
 
         RemoveAuction(auction, item_template);
         sAuctionMgr->RemoveAItem(auction->item_guidlow);
@@ -564,89 +585,225 @@ void AuctionHouseObject::BuildListAuctionItems(WorldPacket& data, Player* player
     uint32& count, uint32& totalcount)
 {
     int loc_idx = player->GetSession()->GetSessionDbLocaleIndex();
-    int locdbc_idx = player->GetSession()->GetSessionDbcLocale();
 
-    for (AuctionEntryMap::const_iterator itr = AuctionsMap.begin(); itr != AuctionsMap.end(); ++itr)
+    // the client asks for the following pages with the same query, they are listed from its result
+    // as long as no auction it may list was added or removed since, the first page always searches again
+    SearchResultMap::iterator itr = SearchResults.find(player->GetGUIDLow());
+    if (listfrom == 0 || itr == SearchResults.end() || !itr->second.IsSameQuery(wsearchedname, levelmin, levelmax, usable,
+        inventoryType, itemClass, itemSubClass, quality, loc_idx))
     {
-        AuctionEntry* Aentry = itr->second;
-        Item* item = sAuctionMgr->GetAItem(Aentry->item_guidlow);
-        if (!item)
-            continue;
+        SearchResult result;
+        result.Name = wsearchedname;
+        result.LevelMin = levelmin;
+        result.LevelMax = levelmax;
+        result.Usable = usable;
+        result.InventoryType = inventoryType;
+        result.ItemClass = itemClass;
+        result.ItemSubClass = itemSubClass;
+        result.Quality = quality;
+        result.Locale = loc_idx;
+        SearchAuctions(result, player);
+
+        if (itr != SearchResults.end())
+        {
+            SearchResultsSize -= itr->second.Auctions.size();
+            SearchResults.erase(itr);
+        }
 
-        ItemTemplate const* proto = item->GetTemplate();
+        if (SearchResultsSize + result.Auctions.size() > MAX_AUCTION_SEARCH_RESULTS)
+            ClearSearchResults();
 
-        if (itemClass != 0xffffffff && proto->Class != itemClass)
-            continue;
+        itr = SearchResults.insert(SearchResultMap::value_type(player->GetGUIDLow(), result)).first;
+        SearchResultsSize += result.Auctions.size();
+    }
 
-        if (itemSubClass != 0xffffffff && proto->SubClass != itemSubClass)
-            continue;
+    std::vector<AuctionEntry*> const& auctions = itr->second.Auctions;
+    totalcount = auctions.size();
+    for (uint32 i = listfrom; i < auctions.size() && count < 50; ++i)
+    {
+        auctions[i]->BuildAuctionInfo(data);
+        ++count;
+    }
+}
 
-        if (inventoryType != 0xffffffff && proto->InventoryType != inventoryType)
-            continue;
+void AuctionHouseObject::SearchAuctions(SearchResult& result, Player* player)
+{
+    int locdbc_idx = player->GetSession()->GetSessionDbcLocale();
+    std::wstring const& wsearchedname = result.Name;
 
-        if (quality != 0xffffffff && proto->Quality != quality)
-            continue;
+    // a class narrows the search to the groups of that class, a subclass of that class to the groups of both
+    AuctionItemIndex::const_iterator itr = ItemIndex.begin();
+    AuctionItemIndex::const_iterator end = ItemIndex.end();
+    if (result.ItemClass != 0xffffffff)
+    {
+        if (result.ItemSubClass != 0xffffffff)
+        {
+            itr = ItemIndex.lower_bound(MakeItemIndexKey(result.ItemClass, result.ItemSubClass, 0));
+            end = ItemIndex.upper_bound(MakeItemIndexKey(result.ItemClass, result.ItemSubClass, 0xffffffff));
+        }
+        else
+        {
+            itr = ItemIndex.lower_bound(MakeItemIndexKey(result.ItemClass, 0, 0));
+            end = ItemIndex.upper_bound(MakeItemIndexKey(result.ItemClass, 0xffff, 0xffffffff));
+        }
+    }
+
+    std::wstring suffixedName;
 
-        if (levelmin != 0x00 && (proto->RequiredLevel < levelmin || (levelmax != 0x00 && proto->RequiredLevel > levelmax)))
+    for (; itr != end; ++itr)
+    {
+        ItemTemplate const* proto = sObjectMgr->GetItemTemplate(uint32(itr->first));
+        if (!proto)
             continue;
 
-        if (usable != 0x00 && player->CanUseItem(item) != EQUIP_ERR_OK)
+        std::wstring const* name = NULL;
+        bool nameMatches = true;
+        if (!MatchesItemTemplate(result, proto, name, nameMatches))
             continue;
 
-        // Allow search by suffix (ie: of the Monkey) or partial name (ie: Monkey)
-        // No need to do any of this if no search term was entered
-        if (!wsearchedname.empty())
+        for (std::set<AuctionEntry*>::const_iterator aItr = itr->second.begin(); aItr != itr->second.end(); ++aItr)
         {
-            std::string name = proto->Name1;
-            if (name.empty())
+            AuctionEntry* Aentry = *aItr;
+            Item* item = sAuctionMgr->GetAItem(Aentry->item_guidlow);
+            if (!item)
                 continue;
 
-            // local name
-            if (loc_idx >= 0)
-                if (ItemLocale const* il = sObjectMgr->GetItemLocale(proto->ItemId))
-                    ObjectMgr::GetLocaleString(il->Name, loc_idx, name);
-
-            // DO NOT use GetItemEnchantMod(proto->RandomProperty) as it may return a result
-            //  that matches the search but it may not equal item->GetItemRandomPropertyId()
-            //  used in BuildAuctionInfo() which then causes wrong items to be listed
-            int32 propRefID = item->GetItemRandomPropertyId();
+            if (result.Usable != 0x00 && player->CanUseItem(item) != EQUIP_ERR_OK)
+                continue;
 
-            if (propRefID)
+            if (!nameMatches)
             {
-                // Append the suffix to the name (ie: of the Monkey) if one exists
-                // These are found in ItemRandomProperties.dbc, not ItemRandomSuffix.dbc
+                // DO NOT use GetItemEnchantMod(proto->RandomProperty) as it may return a result
+                //  that matches the search but it may not equal item->GetItemRandomPropertyId()
+                //  used in BuildAuctionInfo() which then causes wrong items to be listed
+                // The suffixes are found in ItemRandomProperties.dbc, not ItemRandomSuffix.dbc
                 //  even though the DBC names seem misleading
-                const ItemRandomPropertiesEntry* itemRandProp = sItemRandomPropertiesStore.LookupEntry(propRefID);
-
-                if (itemRandProp)
-                {
-                    char* const* temp = itemRandProp->nameSuffix;
-                    //char* temp = itemRandProp->nameSuffix;
-
-                    // dbc local name
-                    if (temp)
-                    {
-                        // Append the suffix (ie: of the Monkey) to the name using localization
-                        // or default enUS if localization is invalid
-                        name += ' ';
-                        name += temp[locdbc_idx >= 0 ? locdbc_idx : LOCALE_enUS];
-                    }
-                }
+                int32 propRefID = item->GetItemRandomPropertyId();
+                ItemRandomPropertiesEntry const* itemRandProp = propRefID ? sItemRandomPropertiesStore.LookupEntry(propRefID) : NULL;
+                if (!itemRandProp)
+                    continue;
+
+                // Perform the search with the suffix appended to the name (ie: of the Monkey)
+                suffixedName = *name;
+                suffixedName += L' ';
+                suffixedName += sAuctionMgr->GetRandomPropertySearchName(itemRandProp, locdbc_idx);
+                if (suffixedName.find(wsearchedname) == std::wstring::npos)
+                    continue;
             }
 
-            // Perform the search (with or without suffix)
-            if (!Utf8FitTo(name, wsearchedname))
-                continue;
+            result.Auctions.push_back(Aentry);
         }
+    }
+
+    // listed in the order of the auction ids like before the index existed
+    std::sort(result.Auctions.begin(), result.Auctions.end(), AuctionEntry::IdOrderPred());
+}
+
+void AuctionHouseObject::ClearSearchResults()
+{
+    SearchResults.clear();
+    SearchResultsSize = 0;
+}
 
-        // Add the item if no search term or if entered search term was found
-        if (count < 50 && totalcount >= listfrom)
+void AuctionHouseObject::ClearSearchResults(ItemTemplate const* proto)
+{
+    for (SearchResultMap::iterator itr = SearchResults.begin(); itr != SearchResults.end();)
+    {
+        std::wstring const* name = NULL;
+        bool nameMatches = true;
+        if (MatchesItemTemplate(itr->second, proto, name, nameMatches))
         {
-            ++count;
-            Aentry->BuildAuctionInfo(data);
+            SearchResultsSize -= itr->second.Auctions.size();
+            SearchResults.erase(itr++);
         }
-        ++totalcount;
+        else
+            ++itr;
+    }
+}
+
+bool AuctionHouseObject::MatchesItemTemplate(SearchResult const& result, ItemTemplate const* proto, std::wstring const*& name, bool& nameMatches)
+{
+    if (result.ItemClass != 0xffffffff && proto->Class != result.ItemClass)
+        return false;
+
+    if (result.ItemSubClass != 0xffffffff && proto->SubClass != result.ItemSubClass)
+        return false;
+
+    if (result.InventoryType != 0xffffffff && proto->InventoryType != result.InventoryType)
+        return false;
+
+    if (result.Quality != 0xffffffff && proto->Quality != result.Quality)
+        return false;
+
+    if (result.LevelMin != 0x00 && (proto->RequiredLevel < result.LevelMin || (result.LevelMax != 0x00 && proto->RequiredLevel > result.LevelMax)))
+        return false;
+
+    // Allow search by suffix (ie: of the Monkey) or partial name (ie: Monkey)
+    // No need to do any of this if no search term was entered
+    nameMatches = true;
+    if (!result.Name.empty())
+    {
+        if (proto->Name1.empty())
+            return false;
+
+        name = &sAuctionMgr->GetItemSearchName(proto, result.Locale);
+        nameMatches = name->find(result.Name) != std::wstring::npos;
+
+        // only items with a random property can still match with their suffix
+        if (!nameMatches && !proto->RandomProperty)
+            return false;
     }
+
+    return true;
+}
+
+std::wstring const& AuctionHouseMgr::GetItemSearchName(ItemTemplate const* proto, int loc_idx)
+{
+    uint64 key = uint64(proto->ItemId) << 8 | uint8(loc_idx + 1);
+    SearchNameMap::const_iterator itr = mItemSearchNames.find(key);
+    if (itr != mItemSearchNames.end())
+        return itr->second;
+
+    std::string name = proto->Name1;
+
+    // local name
+    if (loc_idx >= 0)
+        if (ItemLocale const* il = sObjectMgr->GetItemLocale(proto->ItemId))
+            ObjectMgr::GetLocaleString(il->Name, loc_idx, name);
+
+    std::wstring& wname = mItemSearchNames[key];
+    if (Utf8toWStr(name, wname))
+        wstrToLower(wname);
+    else
+        wname.clear();
+
+    return wname;
+}
+
+std::wstring const& AuctionHouseMgr::GetRandomPropertySearchName(ItemRandomPropertiesEntry const* entry, int locdbc_idx)
+{
+    // dbc local name or default enUS if localization is invalid
+    if (locdbc_idx < 0)
+        locdbc_idx = LOCALE_enUS;
+
+    uint64 key = uint64(entry->ID) << 8 | uint8(locdbc_idx);
+    SearchNameMap::const_iterator itr = mRandomPropertySearchNames.find(key);
+    if (itr != mRandomPropertySearchNames.end())
+        return itr->second;
+
+    std::wstring& wname = mRandomPropertySearchNames[key];
+    if (Utf8toWStr(entry->nameSuffix[locdbc_idx], wname))
+        wstrToLower(wname);
+    else
+        wname.clear();
+
+    return wname;
+}
+
+void AuctionHouseMgr::ClearSearchNames()
+{
+    mItemSearchNames.clear();
+    mRandomPropertySearchNames.clear();
 }
 
 //this function inserts to WorldPacket auction's data
@@ -824,7 +981,7 @@ void AuctionHouseMgr::DeleteExpiredAuctionsAtStartup()
 
         // Delete the auction from the DB
         auction->DeleteFromDB(trans);
-        CharacterDatabase.CommitTransaction(trans);
+        CharacterDatabase.CommitTransaction(trans, 0, auction->owner, auction->bidder);
 
         // Release memory
         delete auction;
@@ -27,10 +27,12 @@
 
 class Item;
 class Player;
+struct ItemTemplate;
 class WorldPacket;
 
 #define MIN_AUCTION_TIME (12*HOUR)
 #define MAX_AUCTION_ITEMS 160
+#define MAX_AUCTION_SEARCH_RESULTS 500000                   // auctions kept in the search results of one house
 
 enum AuctionError
 {
@@ -75,6 +77,10 @@ struct AuctionEntry
     bool LoadFromDB(Field* fields);
     bool LoadFromFieldList(Field* fields);
 
+    struct IdOrderPred
+    {
+        bool operator()(AuctionEntry const* left, AuctionEntry const* right) const { return left->Id < right->Id; }
+    };
 };
 
 //this class is used as auctionhouse instance
@@ -82,7 +88,7 @@ class AuctionHouseObject
 {
   public:
     // Initialize storage
-    AuctionHouseObject() { next = AuctionsMap.begin(); }
+    AuctionHouseObject() : SearchResultsSize(0) { next = AuctionsMap.begin(); }
     ~AuctionHouseObject()
     {
         for (AuctionEntryMap::iterator itr = AuctionsMap.begin(); itr != AuctionsMap.end(); ++itr)
@@ -116,7 +122,56 @@ class AuctionHouseObject
         uint32& count, uint32& totalcount);
 
   private:
+    // auctions grouped by class, subclass and entry of their item template, all browse filters
+    // but the usable check and random property names are checked once per group
+    typedef std::map<uint64, std::set<AuctionEntry*> > AuctionItemIndex;
+
+    static uint64 MakeItemIndexKey(uint32 itemClass, uint32 itemSubClass, uint32 entry)
+    {
+        return uint64(itemClass) << 48 | uint64(itemSubClass) << 32 | entry;
+    }
+
+    // matching auctions of the last browse query of a player, later pages of the same query
+    // are listed from it instead of searching again
+    struct SearchResult
+    {
+        bool IsSameQuery(std::wstring const& searchedname, uint8 levelmin, uint8 levelmax, uint8 usable,
+            uint32 inventoryType, uint32 itemClass, uint32 itemSubClass, uint32 quality, int locale) const
+        {
+            return Name == searchedname && LevelMin == levelmin && LevelMax == levelmax && Usable == usable &&
+                InventoryType == inventoryType && ItemClass == itemClass && ItemSubClass == itemSubClass &&
+                Quality == quality && Locale == locale;
+        }
+
+        std::wstring Name;
+        uint8 LevelMin;
+        uint8 LevelMax;
+        uint8 Usable;
+        uint32 InventoryType;
+        uint32 ItemClass;
+        uint32 ItemSubClass;
+        uint32 Quality;
+        int Locale;
+        std::vector<AuctionEntry*> Auctions;                // ordered by auction id
+    };
+
+    typedef std::map<uint32, SearchResult> SearchResultMap; // by player guid
+
+    void SearchAuctions(SearchResult& result, Player* player);
+    void ClearSearchResults();
+    // drops the results that may list auctions of the item, only those change when one is added or removed
+    void ClearSearchResults(ItemTemplate const* proto);
+
+    // all filters of the query that only depend on the item template, name points to the searched
+    // item name if the name has to be checked per auction for random property suffixes
+    static bool MatchesItemTemplate(SearchResult const& result, ItemTemplate const* proto, std::wstring const*& name, bool& nameMatches);
+
     AuctionEntryMap AuctionsMap;
+    AuctionItemIndex ItemIndex;
+
+    // dropped when an auction they may list is added or removed, the pointers would dangle
+    SearchResultMap SearchResults;
+    uint32 SearchResultsSize;                               // auctions stored in all results
 
     // storage for "next" auction item for next Update()
     AuctionEntryMap::const_iterator next;
@@ -154,6 +209,11 @@ class AuctionHouseMgr
         void SendAuctionOutbiddedMail(AuctionEntry* auction, uint32 newPrice, Player* newBidder, SQLTransaction& trans);
         void SendAuctionCancelledToBidderMail(AuctionEntry* auction, SQLTransaction& trans);
 
+        // lower case names of item templates and random properties as matched by browse queries
+        std::wstring const& GetItemSearchName(ItemTemplate const* proto, int loc_idx);
+        std::wstring const& GetRandomPropertySearchName(ItemRandomPropertiesEntry const* entry, int locdbc_idx);
+        void ClearSearchNames();
+
         static uint32 GetAuctionDeposit(AuctionHouseEntry const* entry, uint32 time, Item* pItem, uint32 count);
         static AuctionHouseEntry const* GetAuctionHouseEntry(uint32 factionTemplateId);
 
@@ -178,6 +238,10 @@ class AuctionHouseMgr
         AuctionHouseObject mNeutralAuctions;
 
         ItemMap mAitems;
+
+        typedef UNORDERED_MAP<uint64, std::wstring> SearchNameMap;
+        SearchNameMap mItemSearchNames;                     // by item entry and locale
+        SearchNameMap mRandomPropertySearchNames;           // by property id and dbc locale
 };
 
 #define sAuctionMgr ACE_Singleton<AuctionHouseMgr, ACE_Null_Mutex>::instance()
@@ -191,10 +191,7 @@ void Channel::Join(uint64 p, const char *pass)
 
     data.clear();
 
-    PlayerInfo pinfo;
-    pinfo.player = p;
-    pinfo.flags = MEMBER_FLAG_NONE;
-    players[p] = pinfo;
+    AddMember(p, player);
 
     MakeYouJoined(&data);
     SendToOne(&data, p);
@@ -244,7 +241,7 @@ void Channel::Leave(uint64 p, bool send)
 
         bool changeowner = players[p].IsOwner();
 
-        players.erase(p);
+        RemoveMember(p);
         if (m_announce && (!player || !AccountMgr::IsGMAccount(player->GetSession()->GetSecurity()) || !sWorld->getBoolConfig(CONFIG_SILENTLY_GM_JOIN_TO_CHANNEL)))
         {
             WorldPacket data;
@@ -325,7 +322,7 @@ void Channel::KickOrBan(uint64 good, const char *badname, bool ban)
             if (notify)
                 SendToAll(&data);
 
-            players.erase(bad->GetGUID());
+            RemoveMember(bad->GetGUID());
             bad->LeftChannel(this);
 
             if (changeowner && m_ownership && !players.empty())
@@ -748,30 +745,88 @@ void Channel::SetOwner(uint64 guid, bool exclaim)
     }
 }
 
-void Channel::SendToAll(WorldPacket* data, uint64 p)
+void Channel::AddMember(uint64 p, Player* player)
+{
+    PlayerInfo& pinfo = players[p];
+    pinfo.player = p;
+    pinfo.flags = MEMBER_FLAG_NONE;
+    pinfo.slot = m_sessions.size();
+
+    MemberSession member;
+    member.guid = p;
+    member.session = player ? player->GetSession() : NULL;
+    m_sessions.push_back(member);
+}
+
+void Channel::RemoveMember(uint64 p)
 {
-    for (PlayerList::const_iterator i = players.begin(); i != players.end(); ++i)
+    PlayerList::iterator itr = players.find(p);
+    if (itr == players.end())
+        return;
+
+    // the last session takes the free slot
+    uint32 slot = itr->second.slot;
+    if (slot != NO_SESSION_SLOT)
     {
-        Player* player = ObjectAccessor::FindPlayer(i->first);
-        if (player)
+        if (slot != m_sessions.size() - 1)
         {
-            if (!p || !player->GetSocial()->HasIgnore(GUID_LOPART(p)))
-                player->GetSession()->SendPacket(data);
+            m_sessions[slot] = m_sessions.back();
+            players[m_sessions[slot].guid].slot = slot;
         }
+
+        m_sessions.pop_back();
     }
+
+    players.erase(itr);
 }
 
-void Channel::SendToAllButOne(WorldPacket* data, uint64 who)
+bool Channel::MarkIgnoringMembers(uint64 p)
 {
-    for (PlayerList::const_iterator i = players.begin(); i != players.end(); ++i)
+    // one lookup per online player ignoring the sender instead of one ignore check per member
+    IgnorerList const* ignorers = sSocialMgr->GetIgnorers(GUID_LOPART(p));
+    if (!ignorers)
+        return false;
+
+    m_ignoreMask.assign((m_sessions.size() + 31) / 32, 0);
+
+    bool marked = false;
+    for (IgnorerList::const_iterator itr = ignorers->begin(); itr != ignorers->end(); ++itr)
     {
-        if (i->first != who)
-        {
-            Player* player = ObjectAccessor::FindPlayer(i->first);
-            if (player)
-                player->GetSession()->SendPacket(data);
-        }
+        PlayerList::const_iterator member = players.find(MAKE_NEW_GUID(*itr, 0, HIGHGUID_PLAYER));
+        if (member == players.end() || member->second.slot == NO_SESSION_SLOT)
+            continue;
+
+        m_ignoreMask[member->second.slot / 32] |= 1u << (member->second.slot % 32);
+        marked = true;
     }
+
+    return marked;
+}
+
+void Channel::SendToAll(WorldPacket* data, uint64 p)
+{
+    bool ignored = p && MarkIgnoringMembers(p);
+
+    // all members reference one copy of the packet
+    SharedPacketScope share(data);
+
+    for (uint32 slot = 0; slot < m_sessions.size(); ++slot)
+    {
+        if (ignored && (m_ignoreMask[slot / 32] & (1u << (slot % 32))))
+            continue;
+
+        if (WorldSession* session = m_sessions[slot].session)
+            session->SendPacket(data);
+    }
+}
+
+void Channel::SendToAllButOne(WorldPacket* data, uint64 who)
+{
+    SharedPacketScope share(data);
+
+    for (MemberSessionList::const_iterator itr = m_sessions.begin(); itr != m_sessions.end(); ++itr)
+        if (itr->guid != who && itr->session)
+            itr->session->SendPacket(data);
 }
 
 void Channel::SendToOne(WorldPacket* data, uint64 who)
@@ -22,6 +22,7 @@
 #include <list>
 #include <map>
 #include <string>
+#include <vector>
 
 #include "Common.h"
 
@@ -117,12 +118,17 @@ enum ChannelMemberFlags
     // 0x80
 };
 
+#define NO_SESSION_SLOT 0xFFFFFFFF
+
 class Channel
 {
     struct PlayerInfo
     {
+        PlayerInfo() : player(0), flags(MEMBER_FLAG_NONE), slot(NO_SESSION_SLOT) { }
+
         uint64 player;
         uint8 flags;
+        uint32 slot;                                        // position in m_sessions
 
         bool HasFlag(uint8 flag) const { return flags & flag; }
         void SetFlag(uint8 flag) { if (!HasFlag(flag)) flags |= flag; }
@@ -148,6 +154,17 @@ class Channel
 
     typedef     std::map<uint64, PlayerInfo> PlayerList;
     PlayerList  players;
+
+    // sessions of the members, packets for all members are handed to them without looking the players up
+    struct MemberSession
+    {
+        uint64 guid;
+        WorldSession* session;                              // NULL if the player was not found when joining
+    };
+
+    typedef     std::vector<MemberSession> MemberSessionList;
+    MemberSessionList m_sessions;
+    std::vector<uint32> m_ignoreMask;                       // bit per slot of m_sessions, set for members ignoring a sender
     typedef     std::set<uint64> BannedList;
     BannedList  banned;
     bool        m_announce;
@@ -198,6 +215,10 @@ class Channel
         void MakeVoiceOn(WorldPacket* data, uint64 guid);                       //+ 0x22
         void MakeVoiceOff(WorldPacket* data, uint64 guid);                      //+ 0x23
 
+        void AddMember(uint64 p, Player* player);
+        void RemoveMember(uint64 p);
+        bool MarkIgnoringMembers(uint64 p);
+
         void SendToAll(WorldPacket* data, uint64 p = 0);
         void SendToAllButOne(WorldPacket* data, uint64 who);
         void SendToOne(WorldPacket* data, uint64 who);
@@ -663,7 +663,7 @@ bool ChatHandler::HandleSendMailCommand(const char* args)
     MailDraft(subject, text)
         .SendMailTo(trans, MailReceiver(target, GUID_LOPART(target_guid)), sender);
 
-    CharacterDatabase.CommitTransaction(trans);
+    CharacterDatabase.CommitTransaction(trans, GUID_LOPART(target_guid));
 
     std::string nameLink = playerLink(target_name);
     PSendSysMessage(LANG_MAIL_SENT, nameLink.c_str());
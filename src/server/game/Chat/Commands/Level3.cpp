@@ -1835,7 +1835,7 @@ void ChatHandler::HandleCharacterLevel(Player* player, uint64 playerGuid, uint32
         stmt->setUInt8(0, uint8(newLevel));
         stmt->setUInt32(1, GUID_LOPART(playerGuid));
 
-        CharacterDatabase.Execute(stmt);
+        CharacterDatabase.Execute(stmt, GUID_LOPART(playerGuid));
     }
 }
 
@@ -3039,7 +3039,7 @@ bool ChatHandler::HandleSendItemsCommand(const char *args)
     }
 
     draft.SendMailTo(trans, MailReceiver(receiver, GUID_LOPART(receiver_guid)), sender);
-    CharacterDatabase.CommitTransaction(trans);
+    CharacterDatabase.CommitTransaction(trans, GUID_LOPART(receiver_guid));
 
     std::string nameLink = playerLink(receiver_name);
     PSendSysMessage(LANG_MAIL_SENT, nameLink.c_str());
@@ -3091,7 +3091,7 @@ bool ChatHandler::HandleSendMoneyCommand(const char *args)
         .AddMoney(money)
         .SendMailTo(trans, MailReceiver(receiver, GUID_LOPART(receiver_guid)), sender);
 
-    CharacterDatabase.CommitTransaction(trans);
+    CharacterDatabase.CommitTransaction(trans, GUID_LOPART(receiver_guid));
 
     std::string nameLink = playerLink(receiver_name);
     PSendSysMessage(LANG_MAIL_SENT, nameLink.c_str());
@@ -3320,7 +3320,7 @@ bool ChatHandler::HandleUnFreezeCommand(const char *args)
 
             stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_AURA_FROZEN);
             stmt->setUInt32(0, lowGuid);
-            CharacterDatabase.Execute(stmt);
+            CharacterDatabase.Execute(stmt, lowGuid);
 
             PSendSysMessage(LANG_COMMAND_UNFREEZE, name.c_str());
             return true;
@@ -99,6 +99,7 @@ HostileReference::HostileReference(Unit* refUnit, ThreatManager* threatManager,
     iUnitGuid = refUnit->GetGUID();
     iOnline = true;
     iAccessible = true;
+    iThreatChanged = false;
 }
 
 //============================================================
@@ -260,6 +261,54 @@ void ThreatContainer::clearReferences()
         delete (*i);
     }
     iThreatList.clear();
+    iReferenceIndex.clear();
+    iChangedReferences.clear();
+}
+
+//============================================================
+
+void ThreatContainer::addReference(HostileReference* hostileRef)
+{
+    iReferenceIndex[hostileRef->getUnitGuid()] = iThreatList.insert(iThreatList.end(), hostileRef);
+
+    // appended at the end, sorted in at the next update
+    setThreatChanged(hostileRef);
+}
+
+//============================================================
+
+void ThreatContainer::remove(HostileReference* hostileRef)
+{
+    ReferenceIndex::iterator itr = iReferenceIndex.find(hostileRef->getUnitGuid());
+    if (itr == iReferenceIndex.end() || *itr->second != hostileRef)
+        return;
+
+    iThreatList.erase(itr->second);
+    iReferenceIndex.erase(itr);
+
+    if (hostileRef->iThreatChanged)
+    {
+        iChangedReferences.erase(std::find(iChangedReferences.begin(), iChangedReferences.end(), hostileRef));
+        hostileRef->iThreatChanged = false;
+    }
+}
+
+//============================================================
+
+void ThreatContainer::threatChanged(HostileReference* hostileRef)
+{
+    ReferenceIndex::const_iterator itr = iReferenceIndex.find(hostileRef->getUnitGuid());
+    if (itr != iReferenceIndex.end() && *itr->second == hostileRef)
+        setThreatChanged(hostileRef);
+}
+
+void ThreatContainer::setThreatChanged(HostileReference* hostileRef)
+{
+    if (hostileRef->iThreatChanged)
+        return;
+
+    hostileRef->iThreatChanged = true;
+    iChangedReferences.push_back(hostileRef);
 }
 
 //============================================================
@@ -269,12 +318,8 @@ HostileReference* ThreatContainer::getReferenceByTarget(Unit* victim)
     if (!victim)
         return NULL;
 
-    uint64 guid = victim->GetGUID();
-    for (std::list<HostileReference*>::const_iterator i = iThreatList.begin(); i != iThreatList.end(); ++i)
-        if ((*i) && (*i)->getUnitGuid() == guid)
-            return (*i);
-
-    return NULL;
+    ReferenceIndex::const_iterator itr = iReferenceIndex.find(victim->GetGUID());
+    return itr != iReferenceIndex.end() ? *itr->second : NULL;
 }
 
 //============================================================
@@ -301,8 +346,26 @@ void ThreatContainer::modifyThreatPercent(Unit* victim, int32 percent)
 
 void ThreatContainer::update()
 {
-    if (iDirty && iThreatList.size() > 1)
-        iThreatList.sort(Trinity::ThreatOrderPred());
+    if (!iDirty)
+        return;
+
+    // only references whose threat changed since the last sort can be out of place:
+    // they are taken out, sorted on their own and merged back in one pass over the list
+    if (iThreatList.size() > 1 && !iChangedReferences.empty())
+    {
+        std::stable_sort(iChangedReferences.begin(), iChangedReferences.end(), Trinity::ThreatOrderPred());
+
+        std::list<HostileReference*> changed;
+        for (std::vector<HostileReference*>::const_iterator itr = iChangedReferences.begin(); itr != iChangedReferences.end(); ++itr)
+            changed.splice(changed.end(), iThreatList, iReferenceIndex[(*itr)->getUnitGuid()]);
+
+        // nodes are moved, not copied, so the positions in the index stay valid
+        iThreatList.merge(changed, Trinity::ThreatOrderPred());
+    }
+
+    for (std::vector<HostileReference*>::const_iterator itr = iChangedReferences.begin(); itr != iChangedReferences.end(); ++itr)
+        (*itr)->iThreatChanged = false;
+    iChangedReferences.clear();
 
     iDirty = false;
 }
@@ -525,6 +588,7 @@ void ThreatManager::processThreatEvent(ThreatRefStatusChangeEvent* threatRefStat
     switch (threatRefStatusChangeEvent->getType())
     {
         case UEV_THREAT_REF_THREAT_CHANGE:
+            iThreatContainer.threatChanged(hostilRef);
             if ((getCurrentVictim() == hostilRef && threatRefStatusChangeEvent->getFValue()<0.0f) ||
                 (getCurrentVictim() != hostilRef && threatRefStatusChangeEvent->getFValue()>0.0f))
                 setDirty(true);                             // the order in the threat list might have changed
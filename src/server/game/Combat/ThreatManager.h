@@ -25,6 +25,7 @@
 #include "UnitEvents.h"
 
 #include <list>
+#include <vector>
 
 //==============================================================
 
@@ -125,6 +126,8 @@ class HostileReference : public Reference<Unit, ThreatManager>
         // Tell our refFrom (source) object, that the link is cut (Target destroyed)
         void sourceObjectDestroyLink();
     private:
+        friend class ThreatContainer;
+
         // Inform the source, that the status of that reference was changed
         void fireStatusChanged(ThreatRefStatusChangeEvent& threatRefStatusChangeEvent);
 
@@ -135,6 +138,7 @@ class HostileReference : public Reference<Unit, ThreatManager>
         uint64 iUnitGuid;
         bool iOnline;
         bool iAccessible;
+        bool iThreatChanged;                                // waits in the changed references of its container
 };
 
 //==============================================================
@@ -143,15 +147,24 @@ class ThreatManager;
 class ThreatContainer
 {
     private:
+        typedef UNORDERED_MAP<uint64, std::list<HostileReference*>::iterator> ReferenceIndex;
+
         std::list<HostileReference*> iThreatList;
+        ReferenceIndex iReferenceIndex;                     // position of the reference to each target in iThreatList
+        std::vector<HostileReference*> iChangedReferences;  // references which may be out of place in iThreatList
         bool iDirty;
+
+        void setThreatChanged(HostileReference* hostileRef);
     protected:
         friend class ThreatManager;
 
-        void remove(HostileReference* hostileRef) { iThreatList.remove(hostileRef); }
-        void addReference(HostileReference* hostileRef) { iThreatList.push_back(hostileRef); }
+        void remove(HostileReference* hostileRef);
+        void addReference(HostileReference* hostileRef);
         void clearReferences();
 
+        // the threat of the reference changed, it is moved to its place at the next sort
+        void threatChanged(HostileReference* hostileRef);
+
         // Sort the list if necessary
         void update();
     public:
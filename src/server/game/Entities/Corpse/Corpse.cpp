@@ -124,7 +124,7 @@ void Corpse::SaveToDB()
     stmt->setUInt16(17, GetPhaseMask());                                        // phaseMask
     trans->Append(stmt);
 
-    CharacterDatabase.CommitTransaction(trans);
+    CharacterDatabase.CommitTransaction(trans, GUID_LOPART(GetOwnerGUID()));
 }
 
 void Corpse::DeleteBonesFromWorld()
@@ -51,6 +51,7 @@
 #include "MoveSplineInit.h"
 #include "MoveSpline.h"
 #include "Transport.h"
+#include "TickProfiler.h"
 
 TrainerSpell const* TrainerSpellData::Find(uint32 spell_id) const
 {
@@ -184,6 +185,7 @@ void Creature::AddToWorld()
         if (m_zoneScript)
             m_zoneScript->OnCreatureCreate(this);
         sObjectAccessor->AddObject(this);
+        GetMap()->AddToCreatureStore(this);
         Unit::AddToWorld();
         SearchFormation();
         AIM_Initialize();
@@ -201,6 +203,7 @@ void Creature::RemoveFromWorld()
         if (m_formation)
             sFormationMgr->RemoveCreatureFromGroup(m_formation, this);
         Unit::RemoveFromWorld();
+        GetMap()->RemoveFromCreatureStore(this);
         sObjectAccessor->RemoveObject(this);
     }
 }
@@ -546,6 +549,8 @@ void Creature::Update(uint32 diff)
 
             if (!IsInEvadeMode() && IsAIEnabled)
             {
+                ProfileScope profile(PROFILE_SCRIPT, GetCreatureTemplate()->ProfileName, GetEntry());
+
                 // do not allow the AI to be changed during update
                 m_AI_locked = true;
                 i_AI->UpdateAI(diff);
@@ -146,6 +146,7 @@ struct CreatureTemplate
     uint32  MechanicImmuneMask;
     uint32  flags_extra;
     uint32  ScriptID;
+    char const* ProfileName;                                // script or AI name shown by the tick profiler, outlives template reloads
     uint32  GetRandomValidModelId() const;
     uint32  GetFirstValidModelId() const;
 
@@ -218,6 +218,9 @@ void CreatureGroup::LeaderMoveTo(float x, float y, float z)
 
     float pathangle = atan2(m_leader->GetPositionY() - y, m_leader->GetPositionX() - x);
 
+    std::vector<Creature*> movers;
+    std::vector<G3D::Vector3> dests;
+    std::vector<uint32> phasemasks;
     for (CreatureGroupMemberType::iterator itr = m_members.begin(); itr != m_members.end(); ++itr)
     {
         Creature* member = itr->first;
@@ -229,12 +232,31 @@ void CreatureGroup::LeaderMoveTo(float x, float y, float z)
 
         float dx = x + cos(angle + pathangle) * dist;
         float dy = y + sin(angle + pathangle) * dist;
-        float dz = z;
 
         Trinity::NormalizeMapCoord(dx);
         Trinity::NormalizeMapCoord(dy);
 
-        member->UpdateGroundPositionZ(dx, dy, dz);
+        movers.push_back(member);
+        dests.push_back(G3D::Vector3(dx, dy, z));
+        phasemasks.push_back(member->GetPhaseMask());
+    }
+
+    if (movers.empty())
+        return;
+
+    // the ground under all members is looked up in one batch, see WorldObject::UpdateGroundPositionZ
+    std::vector<float> heights(movers.size());
+    m_leader->GetBaseMap()->GetHeights(&dests[0], &phasemasks[0], uint32(movers.size()), &heights[0], true);
+
+    for (size_t i = 0; i < movers.size(); ++i)
+    {
+        Creature* member = movers[i];
+        float dist = m_members[member]->follow_dist;
+        float dx = dests[i].x;
+        float dy = dests[i].y;
+        float dz = dests[i].z;
+        if (heights[i] > INVALID_HEIGHT)
+            dz = heights[i] + 0.05f;
 
         if (member->IsWithinDist(m_leader, dist + MAX_DESYNC))
             member->SetUnitMovementFlags(m_leader->GetUnitMovementFlags());
@@ -1982,6 +1982,10 @@ void GameObject::EnableCollision(bool enable)
         GetMap()->Insert(*m_model);*/
 
     m_model->enable(enable ? GetPhaseMask() : 0);
+
+    // the model stays in the dynamic tree, cached line of sight and height results around it may change
+    if (Map* map = FindMap())
+        map->InvalidateCollisionCache(*m_model);
 }
 
 void GameObject::UpdateModel()
@@ -374,7 +374,7 @@ void Item::SaveToDB(SQLTransaction& trans)
             }
 
             if (!isInTransaction)
-                CharacterDatabase.CommitTransaction(trans);
+                CharacterDatabase.CommitTransaction(trans, GUID_LOPART(GetOwnerGUID()));
 
             delete this;
             return;
@@ -386,7 +386,7 @@ void Item::SaveToDB(SQLTransaction& trans)
     SetState(ITEM_UNCHANGED);
 
     if (!isInTransaction)
-        CharacterDatabase.CommitTransaction(trans);
+        CharacterDatabase.CommitTransaction(trans, GUID_LOPART(GetOwnerGUID()));
 }
 
 bool Item::LoadFromDB(uint32 guid, uint64 owner_guid, Field* fields, uint32 entry)
@@ -464,7 +464,7 @@ bool Item::LoadFromDB(uint32 guid, uint64 owner_guid, Field* fields, uint32 entr
         stmt->setUInt32(1, GetUInt32Value(ITEM_FIELD_FLAGS));
         stmt->setUInt32(2, GetUInt32Value(ITEM_FIELD_DURABILITY));
         stmt->setUInt32(3, guid);
-        CharacterDatabase.Execute(stmt);
+        CharacterDatabase.Execute(stmt, GUID_LOPART(owner_guid));
     }
 
     return true;
@@ -1079,6 +1079,14 @@ void Item::BuildUpdate(UpdateDataMapType& data_map)
     ClearUpdateMask(false);
 }
 
+Map* Item::GetObjectUpdateMap() const
+{
+    // changes are sent to the owner only, from the update of the owner's map
+    if (Player* owner = GetOwner())
+        return owner->FindMap();
+    return NULL;
+}
+
 void Item::SaveRefundDataToDB()
 {
     SQLTransaction trans = CharacterDatabase.BeginTransaction();
@@ -1094,7 +1102,7 @@ void Item::SaveRefundDataToDB()
     stmt->setUInt16(3, uint16(GetPaidExtendedCost()));
     trans->Append(stmt);
 
-    CharacterDatabase.CommitTransaction(trans);
+    CharacterDatabase.CommitTransaction(trans, GUID_LOPART(GetOwnerGUID()));
 }
 
 void Item::DeleteRefundDataFromDB(SQLTransaction* trans)
@@ -1182,7 +1190,7 @@ void Item::ClearSoulboundTradeable(Player* currentOwner)
     SetState(ITEM_CHANGED, currentOwner);
     PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_ITEM_BOP_TRADE);
     stmt->setUInt32(0, GetGUIDLow());
-    CharacterDatabase.Execute(stmt);
+    CharacterDatabase.Execute(stmt, GUID_LOPART(GetOwnerGUID()));
 }
 
 bool Item::CheckSoulboundTradeExpire()
@@ -339,6 +339,7 @@ class Item : public Object
         bool CheckSoulboundTradeExpire();
 
         void BuildUpdate(UpdateDataMapType&);
+        Map* GetObjectUpdateMap() const;
 
         uint32 GetScriptId() const { return GetTemplate()->ScriptId; }
     private:
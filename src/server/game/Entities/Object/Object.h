@@ -22,7 +22,9 @@
 #include "Common.h"
 #include "UpdateFields.h"
 #include "UpdateData.h"
+#include "UpdateMask.h"
 #include "GridReference.h"
+#include "GridObjectIndex.h"
 #include "ObjectDefines.h"
 #include "GridDefines.h"
 #include "Map.h"
@@ -107,7 +109,6 @@ class ByteBuffer;
 class WorldSession;
 class Creature;
 class Player;
-class UpdateMask;
 class InstanceScript;
 class GameObject;
 class TempSummon;
@@ -146,6 +147,7 @@ class Object
         void SendUpdateToPlayer(Player* player);
 
         void BuildValuesUpdateBlockForPlayer(UpdateData* data, Player* target) const;
+        void BuildValuesUpdateBlock(ByteBuffer& buf, Player* target) const;
         void BuildOutOfRangeUpdateBlock(UpdateData* data) const;
         void BuildMovementUpdateBlock(UpdateData* data, uint32 flags = 0) const;
 
@@ -300,9 +302,16 @@ class Object
         virtual void BuildUpdate(UpdateDataMapType&) {}
         void BuildFieldsUpdate(Player*, UpdateDataMapType &) const;
 
+        // true if the pending values update is the same for every player but the object itself,
+        // it is then built once and copied to all players in range
+        bool IsValuesUpdateTargetIndependent() const;
+
         // FG: some hacky helpers
         void ForceValuesUpdateAtIndex(uint32);
 
+        // map whose update sends the changed values of the object to the players in range
+        virtual Map* GetObjectUpdateMap() const { return NULL; }
+
         Player* ToPlayer() { if (GetTypeId() == TYPEID_PLAYER) return reinterpret_cast<Player*>(this); else return NULL; }
         Player const* ToPlayer() const { if (GetTypeId() == TYPEID_PLAYER) return (Player const*)((Player*)this); else return NULL; }
         Creature* ToCreature() { if (GetTypeId() == TYPEID_UNIT) return reinterpret_cast<Creature*>(this); else return NULL; }
@@ -342,11 +351,14 @@ class Object
             float  *m_floatValues;
         };
 
-        bool* _changedFields;
+        UpdateMask _changesMask;                            // fields changed since the last values update
 
         uint16 m_valuesCount;
 
-        bool m_objectUpdated;
+        // queues the object in the update list of its map after the first change of a value
+        void AddToObjectUpdateIfNeeded();
+
+        Map* m_objectUpdateMap;                             // map whose update list holds the object, NULL if not queued
 
     private:
         bool m_inWorld;
@@ -536,8 +548,8 @@ class GridObject
 {
     public:
         bool IsInGrid() const { return _gridRef.isValid(); }
-        void AddToGrid(GridRefManager<T>& m) { ASSERT(!IsInGrid()); _gridRef.link(&m, (T*)this); }
-        void RemoveFromGrid() { ASSERT(IsInGrid()); _gridRef.unlink(); }
+        void AddToGrid(GridRefManager<T>& m) { ASSERT(!IsInGrid()); _gridRef.link(&m, (T*)this); m.GetIndex().Insert((T*)this); }
+        void RemoveFromGrid() { ASSERT(IsInGrid()); _gridRef.getTarget()->GetIndex().Remove((T*)this); _gridRef.unlink(); }
     private:
         GridReference<T> _gridRef;
 };
@@ -606,6 +618,17 @@ class WorldObject : public Object, public WorldLocation
 
         void _Create(uint32 guidlow, HighGuid guidhigh, uint32 phaseMask);
 
+        // hide the Position and WorldLocation ones, the grid cell index must follow the object
+        void Relocate(float x, float y) { Position::Relocate(x, y); UpdateGridIndex(); }
+        void Relocate(float x, float y, float z) { Position::Relocate(x, y, z); UpdateGridIndex(); }
+        void Relocate(float x, float y, float z, float orientation) { Position::Relocate(x, y, z, orientation); UpdateGridIndex(); }
+        void Relocate(const Position &pos) { Position::Relocate(pos); UpdateGridIndex(); }
+        void Relocate(const Position* pos) { Position::Relocate(pos); UpdateGridIndex(); }
+        void WorldRelocate(const WorldLocation &loc) { WorldLocation::WorldRelocate(loc); UpdateGridIndex(); }
+
+        // refreshes position, size and phase in the index of the grid cell the object is linked into, if any
+        void UpdateGridIndex() { if (m_gridIndex) m_gridIndex->Update(this); }
+
         virtual void RemoveFromWorld()
         {
             if (!IsInWorld())
@@ -796,6 +819,7 @@ class WorldObject : public Object, public WorldLocation
         Map* GetMap() const { ASSERT(m_currMap); return m_currMap; }
         Map* FindMap() const { return m_currMap; }
         //used to check all object's GetMap() calls when object is not in world!
+        Map* GetObjectUpdateMap() const { return m_currMap; }
 
         //this function should be removed in nearest time...
         Map const* GetBaseMap() const;
@@ -898,6 +922,11 @@ class WorldObject : public Object, public WorldLocation
 
         uint16 m_notifyflags;
         uint16 m_executed_notifies;
+
+        friend class GridObjectIndex;
+        GridObjectIndex* m_gridIndex;                       // index of the grid cell the object is linked into
+        uint32 m_gridIndexPos;                              // position in m_gridIndex
+
         virtual bool _IsWithinDist(WorldObject const* obj, float dist2compare, bool is3D) const;
 
         bool CanNeverSee(WorldObject const* obj) const { return GetMap() != obj->GetMap() || !InSamePhase(obj); }
@@ -25,6 +25,8 @@
 #include "World.h"
 #include "zlib.h"
 
+#include <ace/TSS_T.h>
+
 UpdateData::UpdateData() : m_blockCount(0)
 {
 }
@@ -45,21 +47,67 @@ void UpdateData::AddUpdateBlock(const ByteBuffer &block)
     ++m_blockCount;
 }
 
+// deflate state of one thread, reset for every packet instead of initialized again
+struct UpdateDataCompressor
+{
+    UpdateDataCompressor() : Initialized(false), Level(0) { }
+
+    ~UpdateDataCompressor()
+    {
+        if (Initialized)
+            deflateEnd(&Stream);
+    }
+
+    z_stream Stream;
+    bool Initialized;
+    int Level;
+};
+
+static ACE_TSS<UpdateDataCompressor> Compressor;
+
 void UpdateData::Compress(void* dst, uint32 *dst_size, void* src, int src_size)
 {
-    z_stream c_stream;
+    UpdateDataCompressor* compressor = Compressor;
 
-    c_stream.zalloc = (alloc_func)0;
-    c_stream.zfree = (free_func)0;
-    c_stream.opaque = (voidpf)0;
+    z_stream& c_stream = compressor->Stream;
 
     // default Z_BEST_SPEED (1)
-    int z_res = deflateInit(&c_stream, sWorld->getIntConfig(CONFIG_COMPRESSION));
-    if (z_res != Z_OK)
+    int level = sWorld->getIntConfig(CONFIG_COMPRESSION);
+    if (compressor->Initialized && compressor->Level != level)
     {
-        sLog->outError("Can't compress update packet (zlib: deflateInit) Error code: %i (%s)", z_res, zError(z_res));
-        *dst_size = 0;
-        return;
+        deflateEnd(&c_stream);
+        compressor->Initialized = false;
+    }
+
+    int z_res;
+    if (!compressor->Initialized)
+    {
+        c_stream.zalloc = (alloc_func)0;
+        c_stream.zfree = (free_func)0;
+        c_stream.opaque = (voidpf)0;
+
+        z_res = deflateInit(&c_stream, level);
+        if (z_res != Z_OK)
+        {
+            sLog->outError("Can't compress update packet (zlib: deflateInit) Error code: %i (%s)", z_res, zError(z_res));
+            *dst_size = 0;
+            return;
+        }
+
+        compressor->Initialized = true;
+        compressor->Level = level;
+    }
+    else
+    {
+        z_res = deflateReset(&c_stream);
+        if (z_res != Z_OK)
+        {
+            sLog->outError("Can't compress update packet (zlib: deflateReset) Error code: %i (%s)", z_res, zError(z_res));
+            deflateEnd(&c_stream);
+            compressor->Initialized = false;
+            *dst_size = 0;
+            return;
+        }
     }
 
     c_stream.next_out = (Bytef*)dst;
@@ -90,14 +138,6 @@ void UpdateData::Compress(void* dst, uint32 *dst_size, void* src, int src_size)
         return;
     }
 
-    z_res = deflateEnd(&c_stream);
-    if (z_res != Z_OK)
-    {
-        sLog->outError("Can't compress update packet (zlib: deflateEnd) Error code: %i (%s)", z_res, zError(z_res));
-        *dst_size = 0;
-        return;
-    }
-
     *dst_size = c_stream.total_out;
 }
 
@@ -25,12 +25,26 @@
 class UpdateMask
 {
     public:
-        UpdateMask() : mCount(0), mBlocks(0), mUpdateMask(0) { }
-        UpdateMask(const UpdateMask& mask) : mUpdateMask(0) { *this = mask; }
+        enum
+        {
+            MAX_BLOCKS  = (PLAYER_END + 31) / 32            // blocks of the largest object type
+        };
+
+        UpdateMask() : mCount(0), mBlocks(0), mUpdateMask(0), mOwnsStorage(true) { }
+        UpdateMask(const UpdateMask& mask) : mCount(0), mBlocks(0), mUpdateMask(0), mOwnsStorage(true) { *this = mask; }
+
+        // cleared mask of valuesCount bits kept in storage of the caller (at least MAX_BLOCKS),
+        // used for the short lived masks of update blocks so that building them does not allocate
+        UpdateMask(uint32 valuesCount, uint32* storage) : mCount(valuesCount), mBlocks((valuesCount + 31) / 32), mUpdateMask(storage), mOwnsStorage(false)
+        {
+            ASSERT(mBlocks <= MAX_BLOCKS);
+            Clear();
+        }
 
         ~UpdateMask()
         {
-            delete [] mUpdateMask;
+            if (mOwnsStorage)
+                delete [] mUpdateMask;
         }
 
         void SetBit (uint32 index)
@@ -48,6 +62,35 @@ class UpdateMask
             return (((uint8 *)mUpdateMask)[ index >> 3 ] & (1 << (index & 0x7))) != 0;
         }
 
+        // index of the first set bit at or after index, GetCount() if there is none;
+        // empty blocks are skipped as a whole so the cost depends on the set bits, not on the count
+        uint32 GetNextBit(uint32 index) const
+        {
+            uint8 const* bytes = (uint8 const*)mUpdateMask;
+            while (index < mCount)
+            {
+                if (!(index & 31) && !mUpdateMask[index >> 5])
+                {
+                    index += 32;
+                    continue;
+                }
+
+                if (uint8 bits = uint8(bytes[index >> 3] >> (index & 7)))
+                {
+                    while (!(bits & 1))
+                    {
+                        bits >>= 1;
+                        ++index;
+                    }
+                    return index < mCount ? index : mCount;
+                }
+
+                index = (index | 7) + 1;
+            }
+
+            return mCount;
+        }
+
         uint32 GetBlockCount() const { return mBlocks; }
         uint32 GetLength() const { return mBlocks << 2; }
         uint32 GetCount() const { return mCount; }
@@ -55,12 +98,22 @@ class UpdateMask
 
         void SetCount (uint32 valuesCount)
         {
-            delete [] mUpdateMask;
+            uint32 blocks = (valuesCount + 31) / 32;
+
+            // storage of the caller is never replaced, other storage only if it is too small
+            if (!mOwnsStorage)
+            {
+                ASSERT(blocks <= MAX_BLOCKS);
+            }
+            else if (!mUpdateMask || blocks > mBlocks)
+            {
+                delete [] mUpdateMask;
+                mUpdateMask = new uint32[blocks];
+            }
 
             mCount = valuesCount;
-            mBlocks = (valuesCount + 31) / 32;
+            mBlocks = blocks;
 
-            mUpdateMask = new uint32[mBlocks];
             memset(mUpdateMask, 0, mBlocks << 2);
         }
 
@@ -121,6 +174,7 @@ class UpdateMask
         uint32 mCount;
         uint32 mBlocks;
         uint32 *mUpdateMask;
+        bool mOwnsStorage;
 };
 #endif
 
@@ -280,7 +280,7 @@ bool Pet::LoadPetFromDB(Player* owner, uint32 petentry, uint32 petnumber, bool c
         stmt->setUInt32(2, m_charmInfo->GetPetNumber());
         trans->Append(stmt);
 
-        CharacterDatabase.CommitTransaction(trans);
+        CharacterDatabase.CommitTransaction(trans, ownerid);
     }
 
     // Send fake summon spell cast - this is needed for correct cooldown application for spells
@@ -400,7 +400,7 @@ void Pet::SavePetToDB(PetSaveMode mode)
 
     _SaveSpells(trans);
     _SaveSpellCooldowns(trans);
-    CharacterDatabase.CommitTransaction(trans);
+    CharacterDatabase.CommitTransaction(trans, owner->GetGUIDLow());
 
     // current/stable/not_in_slot
     if (mode >= PET_SAVE_AS_CURRENT)
@@ -465,17 +465,17 @@ void Pet::SavePetToDB(PetSaveMode mode)
             << uint32(getPetType()) << ')';
 
         trans->Append(ss.str().c_str());
-        CharacterDatabase.CommitTransaction(trans);
+        CharacterDatabase.CommitTransaction(trans, owner->GetGUIDLow());
     }
     // delete
     else
     {
         RemoveAllAuras();
-        DeleteFromDB(m_charmInfo->GetPetNumber());
+        DeleteFromDB(m_charmInfo->GetPetNumber(), owner->GetGUIDLow());
     }
 }
 
-void Pet::DeleteFromDB(uint32 guidlow)
+void Pet::DeleteFromDB(uint32 guidlow, uint32 ownerGuidLow)
 {
     SQLTransaction trans = CharacterDatabase.BeginTransaction();
 
@@ -499,7 +499,7 @@ void Pet::DeleteFromDB(uint32 guidlow)
     stmt->setUInt32(0, guidlow);
     trans->Append(stmt);
 
-    CharacterDatabase.CommitTransaction(trans);
+    CharacterDatabase.CommitTransaction(trans, ownerGuidLow);
 }
 
 void Pet::setDeathState(DeathState s)                       // overwrite virtual Creature::setDeathState and Unit::setDeathState
@@ -1384,7 +1384,7 @@ bool Pet::addSpell(uint32 spellId, ActiveStates active /*= ACT_DECIDE*/, PetSpel
 
             stmt->setUInt32(0, spellId);
 
-            CharacterDatabase.Execute(stmt);
+            CharacterDatabase.ExecuteForAllKeys(stmt);
         }
         else
             sLog->outError("Pet::addSpell: Non-existed in SpellStore spell #%u request.", spellId);
@@ -1803,7 +1803,7 @@ void Pet::resetTalentsForAllPetsOf(Player* owner, Pet* online_pet /*= NULL*/)
 
     ss << ')';
 
-    CharacterDatabase.Execute(ss.str().c_str());
+    CharacterDatabase.Execute(ss.str().c_str(), owner->GetGUIDLow());
 }
 
 void Pet::InitTalentForLevel()
@@ -3071,7 +3071,7 @@ void Player::GiveLevel(uint8 level)
         //- TODO: Poor design of mail system
         SQLTransaction trans = CharacterDatabase.BeginTransaction();
         MailDraft(mailReward->mailTemplateId).SendMailTo(trans, this, MailSender(MAIL_CREATURE, mailReward->senderEntry));
-        CharacterDatabase.CommitTransaction(trans);
+        CharacterDatabase.CommitTransaction(trans, GetGUIDLow());
     }
 
     GetAchievementMgr().UpdateAchievementCriteria(ACHIEVEMENT_CRITERIA_TYPE_REACH_LEVEL);
@@ -3444,7 +3444,7 @@ bool Player::AddTalent(uint32 spellId, uint8 spec, bool learning)
 
             stmt->setUInt32(0, spellId);
 
-            CharacterDatabase.Execute(stmt);
+            CharacterDatabase.ExecuteForAllKeys(stmt);
         }
         else
             sLog->outError("Player::addSpell: Non-existed in SpellStore spell #%u request.", spellId);
@@ -3463,7 +3463,7 @@ bool Player::AddTalent(uint32 spellId, uint8 spec, bool learning)
 
             stmt->setUInt32(0, spellId);
 
-            CharacterDatabase.Execute(stmt);
+            CharacterDatabase.ExecuteForAllKeys(stmt);
         }
         else
             sLog->outError("Player::addTalent: Broken spell #%u learning not allowed.", spellId);
@@ -3517,7 +3517,7 @@ bool Player::addSpell(uint32 spellId, bool active, bool learning, bool dependent
 
             stmt->setUInt32(0, spellId);
 
-            CharacterDatabase.Execute(stmt);
+            CharacterDatabase.ExecuteForAllKeys(stmt);
         }
         else
             sLog->outError("Player::addSpell: Non-existed in SpellStore spell #%u request.", spellId);
@@ -3536,7 +3536,7 @@ bool Player::addSpell(uint32 spellId, bool active, bool learning, bool dependent
 
             stmt->setUInt32(0, spellId);
 
-            CharacterDatabase.Execute(stmt);
+            CharacterDatabase.ExecuteForAllKeys(stmt);
         }
         else
             sLog->outError("Player::addSpell: Broken spell #%u learning not allowed.", spellId);
@@ -4452,7 +4452,7 @@ bool Player::resetTalents(bool no_cost)
     SQLTransaction trans = CharacterDatabase.BeginTransaction();
     _SaveTalents(trans);
     _SaveSpells(trans);
-    CharacterDatabase.CommitTransaction(trans);
+    CharacterDatabase.CommitTransaction(trans, GetGUIDLow());
 
     SetFreeTalentPoints(talentPointsForLevel);
 
@@ -4498,8 +4498,8 @@ void Player::_SetCreateBits(UpdateMask* updateMask, Player* target) const
         Object::_SetCreateBits(updateMask, target);
     else
     {
-        for (uint16 index = 0; index < m_valuesCount; index++)
-            if (GetUInt32Value(index) != 0 && updateVisualBits.GetBit(index))
+        for (uint32 index = updateVisualBits.GetNextBit(0); index < m_valuesCount; index = updateVisualBits.GetNextBit(index + 1))
+            if (GetUInt32Value(index) != 0)
                 updateMask->SetBit(index);
     }
 }
@@ -4913,7 +4913,7 @@ void Player::DeleteFromDB(uint64 playerguid, uint32 accountId, bool updateRealmC
                 do
                 {
                     uint32 petguidlow = (*resultPets)[0].GetUInt32();
-                    Pet::DeleteFromDB(petguidlow);
+                    Pet::DeleteFromDB(petguidlow, guid);
                 } while (resultPets->NextRow());
             }
 
@@ -5066,7 +5066,7 @@ void Player::DeleteFromDB(uint64 playerguid, uint32 accountId, bool updateRealmC
             stmt->setUInt32(0, guid);
             trans->Append(stmt);
 
-            CharacterDatabase.CommitTransaction(trans);
+            CharacterDatabase.CommitTransaction(trans, guid);
             break;
         }
         // The character gets unlinked from the account, the name gets freed up and appears as deleted ingame
@@ -5076,7 +5076,7 @@ void Player::DeleteFromDB(uint64 playerguid, uint32 accountId, bool updateRealmC
 
             stmt->setUInt32(0, guid);
 
-            CharacterDatabase.Execute(stmt);
+            CharacterDatabase.Execute(stmt, guid);
             break;
         }
         default:
@@ -7479,7 +7479,7 @@ uint32 Player::GetZoneIdFromDB(uint64 guid)
             stmt->setUInt16(0, uint16(zone));
             stmt->setUInt32(1, guidLow);
 
-            CharacterDatabase.Execute(stmt);
+            CharacterDatabase.Execute(stmt, guidLow);
         }
     }
 
@@ -12196,7 +12196,7 @@ Item* Player::StoreNewItem(ItemPosCountVec const& dest, uint32 item, bool update
             PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_INS_ITEM_BOP_TRADE);
             stmt->setUInt32(0, pItem->GetGUIDLow());
             stmt->setString(1, ss.str());
-            CharacterDatabase.Execute(stmt);
+            CharacterDatabase.Execute(stmt, GetGUIDLow());
         }
     }
     return pItem;
@@ -12663,7 +12663,7 @@ void Player::DestroyItem(uint8 bag, uint8 slot, bool update)
 
             stmt->setUInt32(0, pItem->GetGUIDLow());
 
-            CharacterDatabase.Execute(stmt);
+            CharacterDatabase.Execute(stmt, GetGUIDLow());
         }
 
         RemoveEnchantmentDurations(pItem);
@@ -15256,7 +15256,7 @@ void Player::RewardQuest(Quest const* quest, uint32 reward, Object* questGiver,
         //- TODO: Poor design of mail system
         SQLTransaction trans = CharacterDatabase.BeginTransaction();
         MailDraft(mail_template_id).SendMailTo(trans, this, questGiver, MAIL_CHECK_MASK_HAS_BODY, quest->GetRewMailDelaySecs());
-        CharacterDatabase.CommitTransaction(trans);
+        CharacterDatabase.CommitTransaction(trans, GetGUIDLow());
     }
 
     if (quest->IsDaily() || quest->IsDFQuest())
@@ -16751,7 +16751,7 @@ void Player::SetHomebind(WorldLocation const& /*loc*/, uint32 /*area_id*/)
     stmt->setFloat (3, m_homebindY);
     stmt->setFloat (4, m_homebindZ);
     stmt->setUInt32(5, GetGUIDLow());
-    CharacterDatabase.Execute(stmt);
+    CharacterDatabase.Execute(stmt, GetGUIDLow());
 }
 
 uint32 Player::GetUInt32ValueFromArray(Tokens const& data, uint16 index)
@@ -16771,7 +16771,21 @@ float Player::GetFloatValueFromArray(Tokens const& data, uint16 index)
     return result;
 }
 
-bool Player::LoadFromDB(uint32 guid, SQLQueryHolder *holder)
+PlayerLoginData::~PlayerLoginData()
+{
+    for (LoginInventoryItems::const_iterator itr = inventory.begin(); itr != inventory.end(); ++itr)
+        delete itr->item;
+}
+
+void Player::LoadLoginDataFromDB(uint64 guid, SQLQueryHolder* holder, PlayerLoginData& loginData)
+{
+    _LoadInventoryItems(guid, holder->GetPreparedResult(PLAYER_LOGIN_QUERY_LOADINVENTORY), holder->GetPreparedResult(PLAYER_LOGIN_QUERY_LOADITEMREFUNDS),
+        holder->GetPreparedResult(PLAYER_LOGIN_QUERY_LOADITEMBOPTRADE), loginData.inventory);
+    AchievementMgr::LoadFromDB(holder->GetPreparedResult(PLAYER_LOGIN_QUERY_LOADACHIEVEMENTS), holder->GetPreparedResult(PLAYER_LOGIN_QUERY_LOADCRITERIAPROGRESS),
+        loginData.completedAchievements, loginData.criteriaProgress);
+}
+
+bool Player::LoadFromDB(uint32 guid, SQLQueryHolder *holder, PlayerLoginData& loginData)
 {
     ////                                                     0     1        2     3     4        5      6    7      8     9           10              11
     //QueryResult* result = CharacterDatabase.PQuery("SELECT guid, account, name, race, class, gender, level, xp, money, playerBytes, playerBytes2, playerFlags, "
@@ -16822,7 +16836,7 @@ bool Player::LoadFromDB(uint32 guid, SQLQueryHolder *holder)
         stmt->setUInt16(0, uint16(AT_LOGIN_RENAME));
         stmt->setUInt32(1, guid);
 
-        CharacterDatabase.Execute(stmt);
+        CharacterDatabase.Execute(stmt, guid);
 
         return false;
     }
@@ -16855,7 +16869,7 @@ bool Player::LoadFromDB(uint32 guid, SQLQueryHolder *holder)
     SetFloatValue(UNIT_FIELD_HOVERHEIGHT, 1.0f);
 
     // load achievements before anything else to prevent multiple gains for the same achievement/criteria on every loading (as loading does call UpdateAchievementCriteria)
-    m_achievementMgr.LoadFromDB(holder->GetPreparedResult(PLAYER_LOGIN_QUERY_LOADACHIEVEMENTS), holder->GetPreparedResult(PLAYER_LOGIN_QUERY_LOADCRITERIAPROGRESS));
+    m_achievementMgr.LoadFromDB(loginData.completedAchievements, loginData.criteriaProgress);
 
     uint32 money = fields[8].GetUInt32();
     if (money > MAX_MONEY_AMOUNT)
@@ -17300,7 +17314,7 @@ bool Player::LoadFromDB(uint32 guid, SQLQueryHolder *holder)
     // must be before inventory (some items required reputation check)
     m_reputationMgr.LoadFromDB(holder->GetPreparedResult(PLAYER_LOGIN_QUERY_LOADREPUTATION));
 
-    _LoadInventory(holder->GetPreparedResult(PLAYER_LOGIN_QUERY_LOADINVENTORY), time_diff);
+    _LoadInventory(loginData.inventory, time_diff);
 
     // update items with duration and realtime
     UpdateItemDuration(time_diff, true);
@@ -17606,7 +17620,82 @@ void Player::LoadCorpse()
     }
 }
 
-void Player::_LoadInventory(PreparedQueryResult result, uint32 timeDiff)
+void Player::_LoadInventoryItems(uint64 guid, PreparedQueryResult result, PreparedQueryResult refundResult, PreparedQueryResult tradeResult, LoginInventoryItems& items)
+{
+    if (!result)
+        return;
+
+    // refund and trade data of all items of the character, matched to the inventory rows by item guid
+    std::map<uint32, std::pair<uint32, uint16> > refunds;   // paid money and extended cost
+    if (refundResult)
+    {
+        do
+        {
+            Field* fields = refundResult->Fetch();
+            refunds[fields[0].GetUInt32()] = std::make_pair(fields[1].GetUInt32(), fields[2].GetUInt16());
+        }
+        while (refundResult->NextRow());
+    }
+
+    std::map<uint32, std::string> trades;                   // allowed players
+    if (tradeResult)
+    {
+        do
+        {
+            Field* fields = tradeResult->Fetch();
+            trades[fields[0].GetUInt32()] = fields[1].GetString();
+        }
+        while (tradeResult->NextRow());
+    }
+
+    items.reserve(size_t(result->GetRowCount()));
+    do
+    {
+        Field* fields = result->Fetch();
+
+        items.push_back(LoginInventoryItem());
+        LoginInventoryItem& data = items.back();
+        data.bagGuid   = fields[11].GetUInt32();
+        data.slot      = fields[12].GetUInt8();
+        data.itemGuid  = fields[13].GetUInt32();
+        data.itemEntry = fields[14].GetUInt32();
+
+        ItemTemplate const* proto = sObjectMgr->GetItemTemplate(data.itemEntry);
+        if (!proto)
+            continue;
+
+        data.item = NewItemOrBag(proto);
+        data.loaded = data.item->LoadFromDB(data.itemGuid, guid, fields, data.itemEntry);
+        if (!data.loaded)
+            continue;
+
+        // refund and trade data are attached here so that _LoadItem does not need them from the database
+        if (data.item->HasFlag(ITEM_FIELD_FLAGS, ITEM_FLAG_REFUNDABLE))
+        {
+            std::map<uint32, std::pair<uint32, uint16> >::const_iterator refund = refunds.find(data.itemGuid);
+            if (data.item->GetPlayedTime() <= 2 * HOUR && refund != refunds.end())
+            {
+                data.hasRefundData = true;
+                data.refundRecipient = GUID_LOPART(guid);
+                data.paidMoney = refund->second.first;
+                data.paidExtendedCost = refund->second.second;
+            }
+        }
+        else if (data.item->HasFlag(ITEM_FIELD_FLAGS, ITEM_FLAG_BOP_TRADEABLE))
+        {
+            std::map<uint32, std::string>::const_iterator trade = trades.find(data.itemGuid);
+            if (trade != trades.end())
+            {
+                data.hasTradeData = true;
+                Tokens GUIDlist(trade->second, ' ');
+                for (Tokens::iterator itr = GUIDlist.begin(); itr != GUIDlist.end(); ++itr)
+                    data.allowedLooters.insert(atol(*itr));
+            }
+        }
+    } while (result->NextRow());
+}
+
+void Player::_LoadInventory(LoginInventoryItems& items, uint32 timeDiff)
 {
     //QueryResult* result = CharacterDatabase.PQuery("SELECT data, text, bag, slot, item, item_template FROM character_inventory JOIN item_instance ON character_inventory.item = item_instance.guid WHERE character_inventory.guid = '%u' ORDER BY bag, slot", GetGUIDLow());
     //NOTE: the "order by `bag`" is important because it makes sure
@@ -17614,7 +17703,7 @@ void Player::_LoadInventory(PreparedQueryResult result, uint32 timeDiff)
     //NOTE2: the "order by `slot`" is needed because mainhand weapons are (wrongly?)
     //expected to be equipped before offhand items (TODO: fixme)
 
-    if (result)
+    if (!items.empty())
     {
         uint32 zoneId = GetZoneId();
 
@@ -17625,13 +17714,12 @@ void Player::_LoadInventory(PreparedQueryResult result, uint32 timeDiff)
 
         // Prevent items from being added to the queue while loading
         m_itemUpdateQueueBlocked = true;
-        do
+        for (LoginInventoryItems::iterator itemItr = items.begin(); itemItr != items.end(); ++itemItr)
         {
-            Field* fields = result->Fetch();
-            if (Item* item = _LoadItem(trans, zoneId, timeDiff, fields))
+            if (Item* item = _LoadItem(trans, zoneId, timeDiff, *itemItr))
             {
-                uint32 bagGuid  = fields[11].GetUInt32();
-                uint8  slot     = fields[12].GetUInt8();
+                uint32 bagGuid  = itemItr->bagGuid;
+                uint8  slot     = itemItr->slot;
 
                 uint8 err = EQUIP_ERR_OK;
                 // Item is not in bag
@@ -17714,7 +17802,7 @@ void Player::_LoadInventory(PreparedQueryResult result, uint32 timeDiff)
                     problematicItems.push_back(item);
                 }
             }
-        } while (result->NextRow());
+        }
 
         m_itemUpdateQueueBlocked = false;
 
@@ -17731,23 +17819,24 @@ void Player::_LoadInventory(PreparedQueryResult result, uint32 timeDiff)
             }
             draft.SendMailTo(trans, this, MailSender(this, MAIL_STATIONERY_GM), MAIL_CHECK_MASK_COPIED);
         }
-        CharacterDatabase.CommitTransaction(trans);
+        CharacterDatabase.CommitTransaction(trans, GetGUIDLow());
     }
     //if (isAlive())
     _ApplyAllItemMods();
 }
 
-Item* Player::_LoadItem(SQLTransaction& trans, uint32 zoneId, uint32 timeDiff, Field* fields)
+Item* Player::_LoadItem(SQLTransaction& trans, uint32 zoneId, uint32 timeDiff, LoginInventoryItem& data)
 {
     PreparedStatement* stmt = NULL;
-    Item* item = NULL;
-    uint32 itemGuid  = fields[13].GetUInt32();
-    uint32 itemEntry = fields[14].GetUInt32();
-    if (ItemTemplate const* proto = sObjectMgr->GetItemTemplate(itemEntry))
+    // the item built by _LoadInventoryItems is ours from here on
+    Item* item = data.item;
+    data.item = NULL;
+    uint32 itemGuid  = data.itemGuid;
+    uint32 itemEntry = data.itemEntry;
+    if (ItemTemplate const* proto = item ? sObjectMgr->GetItemTemplate(itemEntry) : NULL)
     {
         bool remove = false;
-        item = NewItemOrBag(proto);
-        if (item->LoadFromDB(itemGuid, GetGUID(), fields, itemEntry))
+        if (data.loaded)
         {
             // Do not allow to have item limited to another map/zone in alive state
             if (isAlive() && item->IsLimitedToAnotherMapOrZone(GetMapId(), zoneId))
@@ -17776,38 +17865,25 @@ Item* Player::_LoadItem(SQLTransaction& trans, uint32 zoneId, uint32 timeDiff, F
 
                     item->RemoveFlag(ITEM_FIELD_FLAGS, ITEM_FLAG_REFUNDABLE);
                 }
+                else if (data.hasRefundData)
+                {
+                    item->SetRefundRecipient(data.refundRecipient);
+                    item->SetPaidMoney(data.paidMoney);
+                    item->SetPaidExtendedCost(data.paidExtendedCost);
+                    AddRefundReference(item->GetGUIDLow());
+                }
                 else
                 {
-                    PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_ITEM_REFUNDS);
-                    stmt->setUInt32(0, item->GetGUIDLow());
-                    stmt->setUInt32(1, GetGUIDLow());
-                    if (PreparedQueryResult result = CharacterDatabase.Query(stmt))
-                    {
-                        item->SetRefundRecipient((*result)[0].GetUInt32());
-                        item->SetPaidMoney((*result)[1].GetUInt32());
-                        item->SetPaidExtendedCost((*result)[2].GetUInt16());
-                        AddRefundReference(item->GetGUIDLow());
-                    }
-                    else
-                    {
-                        sLog->outDebug(LOG_FILTER_PLAYER_LOADING, "Player::_LoadInventory: player (GUID: %u, name: '%s') has item (GUID: %u, entry: %u) with refundable flags, but without data in item_refund_instance. Removing flag.",
-                            GetGUIDLow(), GetName(), item->GetGUIDLow(), item->GetEntry());
-                        item->RemoveFlag(ITEM_FIELD_FLAGS, ITEM_FLAG_REFUNDABLE);
-                    }
+                    sLog->outDebug(LOG_FILTER_PLAYER_LOADING, "Player::_LoadInventory: player (GUID: %u, name: '%s') has item (GUID: %u, entry: %u) with refundable flags, but without data in item_refund_instance. Removing flag.",
+                        GetGUIDLow(), GetName(), item->GetGUIDLow(), item->GetEntry());
+                    item->RemoveFlag(ITEM_FIELD_FLAGS, ITEM_FLAG_REFUNDABLE);
                 }
             }
             else if (item->HasFlag(ITEM_FIELD_FLAGS, ITEM_FLAG_BOP_TRADEABLE))
             {
-                PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_ITEM_BOP_TRADE);
-                stmt->setUInt32(0, item->GetGUIDLow());
-                if (PreparedQueryResult result = CharacterDatabase.Query(stmt))
+                if (data.hasTradeData)
                 {
-                    std::string strGUID = (*result)[0].GetString();
-                    Tokens GUIDlist(strGUID, ' ');
-                    AllowedLooterSet looters;
-                    for (Tokens::iterator itr = GUIDlist.begin(); itr != GUIDlist.end(); ++itr)
-                        looters.insert(atol(*itr));
-                    item->SetSoulboundTradeable(looters);
+                    item->SetSoulboundTradeable(data.allowedLooters);
                     AddTradeableItem(item);
                 }
                 else
@@ -17884,11 +17960,11 @@ void Player::_LoadMailedItems(Mail* mail)
 
             stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_INVALID_MAIL_ITEM);
             stmt->setUInt32(0, itemGuid);
-            CharacterDatabase.Execute(stmt);
+            CharacterDatabase.Execute(stmt, GetGUIDLow());
 
             stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_ITEM_INSTANCE);
             stmt->setUInt32(0, itemGuid);
-            CharacterDatabase.Execute(stmt);
+            CharacterDatabase.Execute(stmt, GetGUIDLow());
             continue;
         }
 
@@ -17900,7 +17976,7 @@ void Player::_LoadMailedItems(Mail* mail)
 
             stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_MAIL_ITEM);
             stmt->setUInt32(0, itemGuid);
-            CharacterDatabase.Execute(stmt);
+            CharacterDatabase.Execute(stmt, GetGUIDLow());
 
             item->FSetState(ITEM_REMOVED);
 
@@ -18301,7 +18377,7 @@ void Player::_LoadBoundInstances(PreparedQueryResult result)
                 stmt->setUInt32(0, GetGUIDLow());
                 stmt->setUInt32(1, instanceId);
 
-                CharacterDatabase.Execute(stmt);
+                CharacterDatabase.Execute(stmt, GetGUIDLow());
 
                 continue;
             }
@@ -18357,7 +18433,7 @@ void Player::UnbindInstance(BoundInstancesMap::iterator &itr, Difficulty difficu
             stmt->setUInt32(0, GetGUIDLow());
             stmt->setUInt32(1, itr->second.save->GetInstanceId());
 
-            CharacterDatabase.Execute(stmt);
+            CharacterDatabase.Execute(stmt, GetGUIDLow());
         }
 
         if (itr->second.perm)
@@ -18386,7 +18462,7 @@ InstancePlayerBind* Player::BindToInstance(InstanceSave* save, bool permanent, b
                     stmt->setUInt32(2, GetGUIDLow());
                     stmt->setUInt32(3, bind.save->GetInstanceId());
 
-                    CharacterDatabase.Execute(stmt);
+                    CharacterDatabase.Execute(stmt, GetGUIDLow());
                 }
         }
         else
@@ -18398,7 +18474,7 @@ InstancePlayerBind* Player::BindToInstance(InstanceSave* save, bool permanent, b
                 stmt->setUInt32(1, save->GetInstanceId());
                 stmt->setBool(2, permanent);
 
-                CharacterDatabase.Execute(stmt);
+                CharacterDatabase.Execute(stmt, GetGUIDLow());
             }
 
         if (bind.save != save)
@@ -18661,7 +18737,7 @@ bool Player::_LoadHomeBind(PreparedQueryResult result)
         {
             PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_PLAYER_HOMEBIND);
             stmt->setUInt32(0, GetGUIDLow());
-            CharacterDatabase.Execute(stmt);
+            CharacterDatabase.Execute(stmt, GetGUIDLow());
         }
     }
 
@@ -18680,7 +18756,7 @@ bool Player::_LoadHomeBind(PreparedQueryResult result)
         stmt->setFloat (3, m_homebindX);
         stmt->setFloat (4, m_homebindY);
         stmt->setFloat (5, m_homebindZ);
-        CharacterDatabase.Execute(stmt);
+        CharacterDatabase.Execute(stmt, GetGUIDLow());
     }
 
     sLog->outStaticDebug("Setting player home position - mapid: %u, areaid: %u, X: %f, Y: %f, Z: %f",
@@ -18961,7 +19037,8 @@ void Player::SaveToDB(bool create /*=false*/)
     if (m_session->isLogingOut() || !sWorld->getBoolConfig(CONFIG_STATS_SAVE_ONLY_ON_LOGOUT))
         _SaveStats(trans);
 
-    CharacterDatabase.CommitTransaction(trans);
+    // saves of one character are written in order, saves of different characters in parallel
+    CharacterDatabase.CommitTransaction(trans, GetGUIDLow());
 
     // save pet (hunter pet level and experience and all type pets health/mana).
     if (Pet* pet = GetPet())
@@ -19353,7 +19430,7 @@ void Player::_SaveQuestStatus(SQLTransaction& trans)
     m_RewardedQuestsSave.clear();
 
     if (!isTransaction)
-        CharacterDatabase.CommitTransaction(trans);
+        CharacterDatabase.CommitTransaction(trans, GetGUIDLow());
 }
 
 void Player::_SaveDailyQuestStatus(SQLTransaction& trans)
@@ -19662,7 +19739,7 @@ void Player::SavePositionInDB(uint32 mapid, float x, float y, float z, float o,
     stmt->setUInt16(5, uint16(zone));
     stmt->setUInt32(6, GUID_LOPART(guid));
 
-    CharacterDatabase.Execute(stmt);
+    CharacterDatabase.Execute(stmt, GUID_LOPART(guid));
 }
 
 void Player::SetUInt32ValueInArray(Tokens& tokens, uint16 index, uint32 value)
@@ -19698,7 +19775,7 @@ void Player::Customize(uint64 guid, uint8 gender, uint8 skin, uint8 face, uint8
     stmt->setUInt32(2, playerBytes2);
     stmt->setUInt32(3, GUID_LOPART(guid));
 
-    CharacterDatabase.Execute(stmt);
+    CharacterDatabase.Execute(stmt, GUID_LOPART(guid));
 }
 
 void Player::SendAttackSwingDeadTarget()
@@ -22887,7 +22964,7 @@ void Player::AutoUnequipOffhandIfNeed(bool force /*= false*/)
         std::string subject = GetSession()->GetTrinityString(LANG_NOT_EQUIPPED_ITEM);
         MailDraft(subject, "There were problems with equipping one or several items").AddItem(offItem).SendMailTo(trans, this, MailSender(this, MAIL_STATIONERY_GM), MAIL_CHECK_MASK_COPIED);
 
-        CharacterDatabase.CommitTransaction(trans);
+        CharacterDatabase.CommitTransaction(trans, GetGUIDLow());
     }
 }
 
@@ -24086,7 +24163,7 @@ void Player::_LoadSkills(PreparedQueryResult result)
                 stmt->setUInt32(0, GetGUIDLow());
                 stmt->setUInt16(1, skill);
 
-                CharacterDatabase.Execute(stmt);
+                CharacterDatabase.Execute(stmt, GetGUIDLow());
 
                 continue;
             }
@@ -24965,7 +25042,7 @@ void Player::RemoveAtLoginFlag(AtLoginFlags flags, bool persist /*= false*/)
         stmt->setUInt16(0, uint16(flags));
         stmt->setUInt32(1, GetGUIDLow());
 
-        CharacterDatabase.Execute(stmt);
+        CharacterDatabase.Execute(stmt, GetGUIDLow());
     }
 }
 
@@ -25133,7 +25210,7 @@ void Player::UpdateSpecCount(uint8 count)
         m_activeSpec = 0;
     }
 
-    CharacterDatabase.CommitTransaction(trans);
+    CharacterDatabase.CommitTransaction(trans, GetGUIDLow());
 
     SetSpecsCount(count);
 
@@ -25153,7 +25230,7 @@ void Player::ActivateSpec(uint8 spec)
 
     SQLTransaction trans = CharacterDatabase.BeginTransaction();
     _SaveActions(trans);
-    CharacterDatabase.CommitTransaction(trans);
+    CharacterDatabase.CommitTransaction(trans, GetGUIDLow());
 
     // TO-DO: We need more research to know what happens with warlock's reagent
     if (Pet* pet = GetPet())
@@ -25511,7 +25588,7 @@ void Player::RefundItem(Item* item)
 
     SaveInventoryAndGoldToDB(trans);
 
-    CharacterDatabase.CommitTransaction(trans);
+    CharacterDatabase.CommitTransaction(trans, GetGUIDLow());
 }
 
 void Player::SetRandomWinner(bool isWinner)
@@ -25523,7 +25600,7 @@ void Player::SetRandomWinner(bool isWinner)
 
         stmt->setUInt32(0, GetGUIDLow());
 
-        CharacterDatabase.Execute(stmt);
+        CharacterDatabase.Execute(stmt, GetGUIDLow());
     }
 }
 
@@ -806,9 +806,49 @@ enum PlayerLoginQueryIndex
     PLAYER_LOGIN_QUERY_LOADQUESTSTATUSREW       = 29,
     PLAYER_LOGIN_QUERY_LOADINSTANCELOCKTIMES    = 30,
     PLAYER_LOGIN_QUERY_LOADSEASONALQUESTSTATUS  = 31,
+    PLAYER_LOGIN_QUERY_LOADITEMREFUNDS          = 32,
+    PLAYER_LOGIN_QUERY_LOADITEMBOPTRADE         = 33,
     MAX_PLAYER_LOGIN_QUERY,
 };
 
+// inventory item of a character, built from its PLAYER_LOGIN_QUERY_LOADINVENTORY row before the player is loaded
+struct LoginInventoryItem
+{
+    LoginInventoryItem() : itemGuid(0), itemEntry(0), bagGuid(0), slot(0), item(NULL), loaded(false), hasRefundData(false),
+        refundRecipient(0), paidMoney(0), paidExtendedCost(0), hasTradeData(false) {}
+
+    uint32 itemGuid;
+    uint32 itemEntry;
+    uint32 bagGuid;
+    uint8 slot;
+    Item* item;                                             // NULL for unknown item templates
+    bool loaded;                                            // Item::LoadFromDB succeeded
+    bool hasRefundData;                                     // item_refund_instance row of a refundable item was found
+    uint32 refundRecipient;
+    uint32 paidMoney;
+    uint16 paidExtendedCost;
+    bool hasTradeData;                                      // item_soulbound_trade_data row of a bop tradeable item was found
+    AllowedLooterSet allowedLooters;
+};
+
+typedef std::vector<LoginInventoryItem> LoginInventoryItems;
+
+// Parts of a character deserialized from its login queries before the player is created, see Player::LoadLoginDataFromDB.
+// Only depends on the character rows and on templates, so it can be built on a login loader thread.
+struct PlayerLoginData
+{
+    PlayerLoginData() {}
+    ~PlayerLoginData();                                     // deletes the items Player::LoadFromDB did not take over
+
+    LoginInventoryItems inventory;
+    CompletedAchievementMap completedAchievements;
+    CriteriaProgressMap criteriaProgress;
+
+    private:
+        PlayerLoginData(PlayerLoginData const&);
+        PlayerLoginData& operator=(PlayerLoginData const&);
+};
+
 enum PlayerDelayedOperations
 {
     DELAYED_SAVE_PLAYER         = 0x01,
@@ -1501,7 +1541,9 @@ class Player : public Unit, public GridObject<Player>
         /***                   LOAD SYSTEM                     ***/
         /*********************************************************/
 
-        bool LoadFromDB(uint32 guid, SQLQueryHolder *holder);
+        bool LoadFromDB(uint32 guid, SQLQueryHolder *holder, PlayerLoginData& loginData);
+        // fills loginData from the login query results of the character, touches no player and may run on any thread
+        static void LoadLoginDataFromDB(uint64 guid, SQLQueryHolder* holder, PlayerLoginData& loginData);
         bool isBeingLoaded() const { return GetSession()->PlayerLoading();}
 
         void Initialize(uint32 guid);
@@ -2575,7 +2617,8 @@ class Player : public Unit, public GridObject<Player>
         void _LoadAuras(PreparedQueryResult result, uint32 timediff);
         void _LoadGlyphAuras();
         void _LoadBoundInstances(PreparedQueryResult result);
-        void _LoadInventory(PreparedQueryResult result, uint32 timeDiff);
+        static void _LoadInventoryItems(uint64 guid, PreparedQueryResult result, PreparedQueryResult refundResult, PreparedQueryResult tradeResult, LoginInventoryItems& items);
+        void _LoadInventory(LoginInventoryItems& items, uint32 timeDiff);
         void _LoadMailInit(PreparedQueryResult resultUnread, PreparedQueryResult resultDelivery);
         void _LoadMail();
         void _LoadMailedItems(Mail* mail);
@@ -2796,7 +2839,7 @@ class Player : public Unit, public GridObject<Player>
         InventoryResult CanStoreItem_InBag(uint8 bag, ItemPosCountVec& dest, ItemTemplate const* pProto, uint32& count, bool merge, bool non_specialized, Item* pSrcItem, uint8 skip_bag, uint8 skip_slot) const;
         InventoryResult CanStoreItem_InInventorySlots(uint8 slot_begin, uint8 slot_end, ItemPosCountVec& dest, ItemTemplate const* pProto, uint32& count, bool merge, Item* pSrcItem, uint8 skip_bag, uint8 skip_slot) const;
         Item* _StoreItem(uint16 pos, Item* pItem, uint32 count, bool clone, bool update);
-        Item* _LoadItem(SQLTransaction& trans, uint32 zoneId, uint32 timeDiff, Field* fields);
+        Item* _LoadItem(SQLTransaction& trans, uint32 zoneId, uint32 timeDiff, LoginInventoryItem& data);
 
         std::set<uint32> m_refundableItems;
         void SendRefundInfo(Item* item);
@@ -74,7 +74,7 @@ bool PlayerSocial::AddToSocialList(uint32 friendGuid, bool ignore)
         stmt->setUInt32(1, GetPlayerGUID());
         stmt->setUInt32(2, friendGuid);
 
-        CharacterDatabase.Execute(stmt);
+        CharacterDatabase.Execute(stmt, GetPlayerGUID());
 
         m_playerSocialMap[friendGuid].Flags |= flag;
     }
@@ -86,12 +86,16 @@ bool PlayerSocial::AddToSocialList(uint32 friendGuid, bool ignore)
         stmt->setUInt32(1, friendGuid);
         stmt->setUInt8(2, flag);
 
-        CharacterDatabase.Execute(stmt);
+        CharacterDatabase.Execute(stmt, GetPlayerGUID());
 
         FriendInfo fi;
         fi.Flags |= flag;
         m_playerSocialMap[friendGuid] = fi;
     }
+
+    if (ignore)
+        sSocialMgr->AddIgnorer(friendGuid, GetPlayerGUID());
+
     return true;
 }
 
@@ -103,7 +107,10 @@ void PlayerSocial::RemoveFromSocialList(uint32 friendGuid, bool ignore)
 
     uint8 flag = SOCIAL_FLAG_FRIEND;
     if (ignore)
+    {
         flag = SOCIAL_FLAG_IGNORED;
+        sSocialMgr->RemoveIgnorer(friendGuid, GetPlayerGUID());
+    }
 
     itr->second.Flags &= ~flag;
     if (itr->second.Flags == 0)
@@ -113,7 +120,7 @@ void PlayerSocial::RemoveFromSocialList(uint32 friendGuid, bool ignore)
         stmt->setUInt32(0, GetPlayerGUID());
         stmt->setUInt32(1, friendGuid);
 
-        CharacterDatabase.Execute(stmt);
+        CharacterDatabase.Execute(stmt, GetPlayerGUID());
 
         m_playerSocialMap.erase(itr);
     }
@@ -125,7 +132,7 @@ void PlayerSocial::RemoveFromSocialList(uint32 friendGuid, bool ignore)
         stmt->setUInt32(1, GetPlayerGUID());
         stmt->setUInt32(2, friendGuid);
 
-        CharacterDatabase.Execute(stmt);
+        CharacterDatabase.Execute(stmt, GetPlayerGUID());
     }
 }
 
@@ -143,7 +150,7 @@ void PlayerSocial::SetFriendNote(uint32 friendGuid, std::string note)
     stmt->setUInt32(1, GetPlayerGUID());
     stmt->setUInt32(2, friendGuid);
 
-    CharacterDatabase.Execute(stmt);
+    CharacterDatabase.Execute(stmt, GetPlayerGUID());
 
     m_playerSocialMap[friendGuid].Note = note;
 }
@@ -206,6 +213,31 @@ SocialMgr::~SocialMgr()
 {
 }
 
+void SocialMgr::RemovePlayerSocial(uint32 guid)
+{
+    SocialMap::iterator itr = m_socialMap.find(guid);
+    if (itr == m_socialMap.end())
+        return;
+
+    PlayerSocialMap const& socials = itr->second.m_playerSocialMap;
+    for (PlayerSocialMap::const_iterator sItr = socials.begin(); sItr != socials.end(); ++sItr)
+        if (sItr->second.Flags & SOCIAL_FLAG_IGNORED)
+            RemoveIgnorer(sItr->first, guid);
+
+    m_socialMap.erase(itr);
+}
+
+void SocialMgr::RemoveIgnorer(uint32 guid, uint32 ignorer)
+{
+    IgnorerMap::iterator itr = m_ignorers.find(guid);
+    if (itr == m_ignorers.end())
+        return;
+
+    itr->second.erase(ignorer);
+    if (itr->second.empty())
+        m_ignorers.erase(itr);
+}
+
 void SocialMgr::GetFriendInfo(Player* player, uint32 friendGUID, FriendInfo &friendInfo)
 {
     if (!player)
@@ -343,6 +375,9 @@ PlayerSocial* SocialMgr::LoadFromDB(PreparedQueryResult result, uint32 guid)
 
         social->m_playerSocialMap[friend_guid] = FriendInfo(flags, note);
 
+        if (flags & SOCIAL_FLAG_IGNORED)
+            AddIgnorer(friend_guid, guid);
+
         // client's friends list and ignore list limit
         if (social->m_playerSocialMap.size() >= (SOCIALMGR_FRIEND_LIMIT + SOCIALMGR_IGNORE_LIMIT))
             break;
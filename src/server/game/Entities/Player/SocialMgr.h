@@ -77,6 +77,7 @@ struct FriendInfo
 
 typedef std::map<uint32, FriendInfo> PlayerSocialMap;
 typedef std::map<uint32, PlayerSocial> SocialMap;
+typedef std::set<uint32> IgnorerList;
 
 /// Results of friend related commands
 enum FriendsResult
@@ -146,7 +147,16 @@ class SocialMgr
 
     public:
         // Misc
-        void RemovePlayerSocial(uint32 guid) { m_socialMap.erase(guid); }
+        void RemovePlayerSocial(uint32 guid);
+
+        // low guids of the online players ignoring a player, NULL if there are none
+        IgnorerList const* GetIgnorers(uint32 guid) const
+        {
+            IgnorerMap::const_iterator itr = m_ignorers.find(guid);
+            return itr != m_ignorers.end() ? &itr->second : NULL;
+        }
+        void AddIgnorer(uint32 guid, uint32 ignorer) { m_ignorers[guid].insert(ignorer); }
+        void RemoveIgnorer(uint32 guid, uint32 ignorer);
 
         void GetFriendInfo(Player* player, uint32 friendGUID, FriendInfo &friendInfo);
         // Packet management
@@ -156,7 +166,10 @@ class SocialMgr
         // Loading
         PlayerSocial *LoadFromDB(PreparedQueryResult result, uint32 guid);
     private:
+        typedef UNORDERED_MAP<uint32, IgnorerList> IgnorerMap;
+
         SocialMap m_socialMap;
+        IgnorerMap m_ignorers;                              // ignore lists of loaded players by ignored guid
 };
 
 #define sSocialMgr ACE_Singleton<SocialMgr, ACE_Null_Mutex>::instance()
@@ -47,6 +47,24 @@ ObjectAccessor::~ObjectAccessor()
 {
 }
 
+Creature* ObjectAccessor::GetObjectInMap(uint64 guid, Map* map, Creature* /*typeSpecifier*/)
+{
+    ASSERT(map);
+    return map->GetCreature(guid);
+}
+
+Unit* ObjectAccessor::GetObjectInMap(uint64 guid, Map* map, Unit* /*typeSpecifier*/)
+{
+    ASSERT(map);
+    if (IS_PLAYER_GUID(guid))
+        return GetObjectInMap(guid, map, (Player*)NULL);
+
+    if (IS_PET_GUID(guid))
+        return GetObjectInMap(guid, map, (Pet*)NULL);
+
+    return map->GetCreature(guid);
+}
+
 WorldObject* ObjectAccessor::GetWorldObject(WorldObject const& p, uint64 guid)
 {
     switch (GUID_HIPART(guid))
@@ -174,11 +192,10 @@ Unit* ObjectAccessor::FindUnit(uint64 guid)
 
 Player* ObjectAccessor::FindPlayerByName(const char* name)
 {
-    TRINITY_READ_GUARD(HashMapHolder<Player>::LockType, *HashMapHolder<Player>::GetLock());
+    HashMapHolder<Player>::ReadGuard guard;
     std::string nameStr = name;
     std::transform(nameStr.begin(), nameStr.end(), nameStr.begin(), ::tolower);
-    HashMapHolder<Player>::MapType const& m = GetPlayers();
-    for (HashMapHolder<Player>::MapType::const_iterator iter = m.begin(); iter != m.end(); ++iter)
+    for (HashMapHolder<Player>::const_iterator iter = HashMapHolder<Player>::begin(); iter != HashMapHolder<Player>::end(); ++iter)
     {
         if (!iter->second->IsInWorld())
             continue;
@@ -193,9 +210,8 @@ Player* ObjectAccessor::FindPlayerByName(const char* name)
 
 void ObjectAccessor::SaveAllPlayers()
 {
-    TRINITY_READ_GUARD(HashMapHolder<Player>::LockType, *HashMapHolder<Player>::GetLock());
-    HashMapHolder<Player>::MapType const& m = GetPlayers();
-    for (HashMapHolder<Player>::MapType::const_iterator itr = m.begin(); itr != m.end(); ++itr)
+    HashMapHolder<Player>::ReadGuard guard;
+    for (HashMapHolder<Player>::const_iterator itr = HashMapHolder<Player>::begin(); itr != HashMapHolder<Player>::end(); ++itr)
         itr->second->SaveToDB();
 }
 
@@ -310,7 +326,7 @@ Corpse* ObjectAccessor::ConvertCorpseForPlayer(uint64 player_guid, bool insignia
     // remove corpse from DB
     SQLTransaction trans = CharacterDatabase.BeginTransaction();
     corpse->DeleteFromDB(trans);
-    CharacterDatabase.CommitTransaction(trans);
+    CharacterDatabase.CommitTransaction(trans, GUID_LOPART(player_guid));
 
     Corpse* bones = NULL;
     // create the bones only if the map and the grid is loaded at the corpse's location
@@ -368,27 +384,6 @@ void ObjectAccessor::RemoveOldCorpses()
     }
 }
 
-void ObjectAccessor::Update(uint32 /*diff*/)
-{
-    UpdateDataMapType update_players;
-
-    while (!i_objects.empty())
-    {
-        Object* obj = *i_objects.begin();
-        ASSERT(obj && obj->IsInWorld());
-        i_objects.erase(i_objects.begin());
-        obj->BuildUpdate(update_players);
-    }
-
-    WorldPacket packet;                                     // here we allocate a std::vector with a size of 0x10000
-    for (UpdateDataMapType::iterator iter = update_players.begin(); iter != update_players.end(); ++iter)
-    {
-        iter->second.BuildPacket(&packet);
-        iter->first->GetSession()->SendPacket(&packet);
-        packet.clear();                                     // clean the string
-    }
-}
-
 void ObjectAccessor::UnloadAll()
 {
     for (Player2CorpsesMapType::const_iterator itr = i_player2corpse.begin(); itr != i_player2corpse.end(); ++itr)
@@ -400,8 +395,7 @@ void ObjectAccessor::UnloadAll()
 
 /// Define the static members of HashMapHolder
 
-template <class T> UNORDERED_MAP< uint64, T* > HashMapHolder<T>::m_objectMap;
-template <class T> typename HashMapHolder<T>::LockType HashMapHolder<T>::i_lock;
+template <class T> typename HashMapHolder<T>::Shard HashMapHolder<T>::m_shards[HashMapHolder<T>::SHARD_COUNT];
 
 /// Global definitions for the hashmap storage
 
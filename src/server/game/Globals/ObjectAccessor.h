@@ -43,44 +43,107 @@ class Map;
 class WorldRunnable;
 class Transport;
 
+// Guid lookup of the objects in world, split into shards by guid so that lookups from parallel
+// map updates mostly take different locks
 template <class T>
 class HashMapHolder
 {
     public:
+        enum
+        {
+            SHARD_COUNT = 16                                // power of two
+        };
 
         typedef UNORDERED_MAP<uint64, T*> MapType;
         typedef ACE_RW_Thread_Mutex LockType;
 
+        // walks the objects of all shards, only while holding a ReadGuard
+        class const_iterator
+        {
+            public:
+                const_iterator(uint32 shard, typename MapType::const_iterator itr) : _shard(shard), _itr(itr) { SkipEnds(); }
+
+                typename MapType::value_type const& operator*() const { return *_itr; }
+                typename MapType::value_type const* operator->() const { return &*_itr; }
+
+                const_iterator& operator++() { ++_itr; SkipEnds(); return *this; }
+
+                bool operator==(const_iterator const& right) const { return _shard == right._shard && (_shard == SHARD_COUNT || _itr == right._itr); }
+                bool operator!=(const_iterator const& right) const { return !(*this == right); }
+
+            private:
+                void SkipEnds()
+                {
+                    while (_shard < SHARD_COUNT && _itr == m_shards[_shard].Objects.end())
+                        if (++_shard < SHARD_COUNT)
+                            _itr = m_shards[_shard].Objects.begin();
+                }
+
+                uint32 _shard;
+                typename MapType::const_iterator _itr;
+        };
+
+        // read locks all shards, needed to walk the whole container
+        class ReadGuard
+        {
+            public:
+                ReadGuard()
+                {
+                    for (uint32 i = 0; i < SHARD_COUNT; ++i)
+                        m_shards[i].Lock.acquire_read();
+                }
+
+                ~ReadGuard()
+                {
+                    for (uint32 i = SHARD_COUNT; i > 0; --i)
+                        m_shards[i - 1].Lock.release();
+                }
+
+            private:
+                ReadGuard(ReadGuard const&);
+                ReadGuard& operator=(ReadGuard const&);
+        };
+
         static void Insert(T* o)
         {
-            TRINITY_WRITE_GUARD(LockType, i_lock);
-            m_objectMap[o->GetGUID()] = o;
+            Shard& shard = GetShard(o->GetGUID());
+            TRINITY_WRITE_GUARD(LockType, shard.Lock);
+            shard.Objects[o->GetGUID()] = o;
         }
 
         static void Remove(T* o)
         {
-            TRINITY_WRITE_GUARD(LockType, i_lock);
-            m_objectMap.erase(o->GetGUID());
+            Shard& shard = GetShard(o->GetGUID());
+            TRINITY_WRITE_GUARD(LockType, shard.Lock);
+            shard.Objects.erase(o->GetGUID());
         }
 
         static T* Find(uint64 guid)
         {
-            TRINITY_READ_GUARD(LockType, i_lock);
-            typename MapType::iterator itr = m_objectMap.find(guid);
-            return (itr != m_objectMap.end()) ? itr->second : NULL;
+            Shard& shard = GetShard(guid);
+            TRINITY_READ_GUARD(LockType, shard.Lock);
+            typename MapType::iterator itr = shard.Objects.find(guid);
+            return (itr != shard.Objects.end()) ? itr->second : NULL;
         }
 
-        static MapType& GetContainer() { return m_objectMap; }
-
-        static LockType* GetLock() { return &i_lock; }
+        static const_iterator begin() { return const_iterator(0, m_shards[0].Objects.begin()); }
+        static const_iterator end() { return const_iterator(SHARD_COUNT, m_shards[SHARD_COUNT - 1].Objects.end()); }
 
     private:
+        struct Shard
+        {
+            LockType Lock;
+            MapType Objects;
+            char Padding[64];                               // keeps the locks of neighbour shards off the same cache line
+        };
+
+        // low guids are handed out sequentially, their low bits spread objects evenly
+        static Shard& GetShard(uint64 guid) { return m_shards[GUID_LOPART(guid) & (SHARD_COUNT - 1)]; }
 
         //Non instanceable only static
         HashMapHolder() {}
 
-        static LockType i_lock;
-        static MapType  m_objectMap;
+        static Shard m_shards[SHARD_COUNT];
 };
 
 class ObjectAccessor
@@ -147,6 +210,10 @@ class ObjectAccessor
             return NULL;
         }
 
+        // creatures are looked up in the store of the map
+        static Creature* GetObjectInMap(uint64 guid, Map* map, Creature* /*typeSpecifier*/);
+        static Unit* GetObjectInMap(uint64 guid, Map* map, Unit* /*typeSpecifier*/);
+
         template<class T> static T* GetObjectInWorld(uint32 mapid, float x, float y, uint64 guid, T* /*fake*/)
         {
             T* obj = HashMapHolder<T>::Find(guid);
@@ -196,24 +263,6 @@ class ObjectAccessor
         static Unit* FindUnit(uint64);
         static Player* FindPlayerByName(const char* name);
 
-        // when using this, you must use the hashmapholder's lock
-        static HashMapHolder<Player>::MapType const& GetPlayers()
-        {
-            return HashMapHolder<Player>::GetContainer();
-        }
-
-        // when using this, you must use the hashmapholder's lock
-        static HashMapHolder<Creature>::MapType const& GetCreatures()
-        {
-            return HashMapHolder<Creature>::GetContainer();
-        }
-
-        // when using this, you must use the hashmapholder's lock
-        static HashMapHolder<GameObject>::MapType const& GetGameObjects()
-        {
-            return HashMapHolder<GameObject>::GetContainer();
-        }
-
         template<class T> static void AddObject(T* object)
         {
             HashMapHolder<T>::Insert(object);
@@ -226,19 +275,6 @@ class ObjectAccessor
 
         static void SaveAllPlayers();
 
-        //non-static functions
-        void AddUpdateObject(Object* obj)
-        {
-            TRINITY_GUARD(ACE_Thread_Mutex, i_objectLock);
-            i_objects.insert(obj);
-        }
-
-        void RemoveUpdateObject(Object* obj)
-        {
-            TRINITY_GUARD(ACE_Thread_Mutex, i_objectLock);
-            i_objects.erase(obj);
-        }
-
         //Thread safe
         Corpse* GetCorpseForPlayerGUID(uint64 guid);
         void RemoveCorpse(Corpse* corpse);
@@ -247,22 +283,14 @@ class ObjectAccessor
         Corpse* ConvertCorpseForPlayer(uint64 player_guid, bool insignia = false);
 
         //Thread unsafe
-        void Update(uint32 diff);
         void RemoveOldCorpses();
         void UnloadAll();
 
     private:
-        static void _buildChangeObjectForPlayer(WorldObject*, UpdateDataMapType&);
-        static void _buildPacket(Player*, Object*, UpdateDataMapType&);
-        void _update();
-
         typedef UNORDERED_MAP<uint64, Corpse*> Player2CorpsesMapType;
-        typedef UNORDERED_MAP<Player*, UpdateData>::value_type UpdateDataValueType;
 
-        std::set<Object*> i_objects;
         Player2CorpsesMapType i_player2corpse;
 
-        ACE_Thread_Mutex i_objectLock;
         ACE_RW_Thread_Mutex i_corpseLock;
 };
 
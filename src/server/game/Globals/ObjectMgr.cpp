@@ -45,6 +45,7 @@
 #include "ScriptMgr.h"
 #include "SpellScript.h"
 #include "PoolMgr.h"
+#include "TickProfiler.h"
 
 ScriptMapMap sQuestEndScripts;
 ScriptMapMap sQuestStartScripts;
@@ -482,6 +483,7 @@ void ObjectMgr::LoadCreatureTemplates()
         creatureTemplate.MechanicImmuneMask = fields[82].GetUInt32();
         creatureTemplate.flags_extra        = fields[83].GetUInt32();
         creatureTemplate.ScriptID           = GetScriptId(fields[84].GetCString());
+        creatureTemplate.ProfileName        = GetCreatureProfileName(creatureTemplate);
 
         ++count;
     }
@@ -567,6 +569,18 @@ void ObjectMgr::LoadCreatureTemplateAddons()
     sLog->outString();
 }
 
+char const* ObjectMgr::GetCreatureProfileName(CreatureTemplate const& cInfo)
+{
+    // scripted creatures only, default AIs would flood the profiler
+    if (cInfo.ScriptID)
+        return GetScriptName(cInfo.ScriptID);
+
+    if (!cInfo.AIName.empty())
+        return sTickProfiler->InternName(cInfo.AIName);
+
+    return NULL;
+}
+
 void ObjectMgr::CheckCreatureTemplate(CreatureTemplate const* cInfo)
 {
     if (!cInfo)
@@ -5315,12 +5329,13 @@ void ObjectMgr::ReturnOrDeleteOldMails(bool serverUp)
                 {
                     stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_ITEM_INSTANCE);
                     stmt->setUInt32(0, itr2->item_guid);
-                    CharacterDatabase.Execute(stmt);
+                    CharacterDatabase.Execute(stmt, m->receiver);
                 }
             }
             else
             {
-                // Mail will be returned
+                // Mail will be returned, in the order of the statements of both characters
+                SQLTransaction trans = CharacterDatabase.BeginTransaction();
                 stmt = CharacterDatabase.GetPreparedStatement(CHAR_UPD_MAIL_RETURNED);
                 stmt->setUInt32(0, m->receiver);
                 stmt->setUInt32(1, m->sender);
@@ -5328,20 +5343,21 @@ void ObjectMgr::ReturnOrDeleteOldMails(bool serverUp)
                 stmt->setUInt32(3, basetime);
                 stmt->setUInt8 (4, uint8(MAIL_CHECK_MASK_RETURNED));
                 stmt->setUInt32(5, m->messageID);
-                CharacterDatabase.Execute(stmt);
+                trans->Append(stmt);
                 for (MailItemInfoVec::iterator itr2 = m->items.begin(); itr2 != m->items.end(); ++itr2)
                 {
                     // Update receiver in mail items for its proper delivery, and in instance_item for avoid lost item at sender delete
                     stmt = CharacterDatabase.GetPreparedStatement(CHAR_UPD_MAIL_ITEM_RECEIVER);
                     stmt->setUInt32(0, m->sender);
                     stmt->setUInt32(1, itr2->item_guid);
-                    CharacterDatabase.Execute(stmt);
+                    trans->Append(stmt);
 
                     stmt = CharacterDatabase.GetPreparedStatement(CHAR_UPD_ITEM_OWNER);
                     stmt->setUInt32(0, m->sender);
                     stmt->setUInt32(1, itr2->item_guid);
-                    CharacterDatabase.Execute(stmt);
+                    trans->Append(stmt);
                 }
+                CharacterDatabase.CommitTransaction(trans, m->receiver, m->sender);
                 delete m;
                 ++returnedCount;
                 continue;
@@ -5350,7 +5366,7 @@ void ObjectMgr::ReturnOrDeleteOldMails(bool serverUp)
 
         stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_MAIL_BY_ID);
         stmt->setUInt32(0, m->messageID);
-        CharacterDatabase.Execute(stmt);
+        CharacterDatabase.Execute(stmt, m->receiver);
         delete m;
         ++deletedCount;
     }
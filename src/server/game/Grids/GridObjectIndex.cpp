@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2008-2012 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "GridObjectIndex.h"
+#include "Object.h"
+
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  define GRID_OBJECT_INDEX_SSE2
+#  include <emmintrin.h>
+#endif
+
+// added to the range of searches, the filter must not reject objects a distance check accepts because
+// the sums are rounded in a different order or the check compares transport offsets
+static float const RangeTolerance = 0.1f;
+
+GridObjectIndex::~GridObjectIndex()
+{
+    for (std::vector<WorldObject*>::const_iterator itr = _objects.begin(); itr != _objects.end(); ++itr)
+        (*itr)->m_gridIndex = NULL;
+}
+
+void GridObjectIndex::Insert(WorldObject* obj)
+{
+    ASSERT(!obj->m_gridIndex);
+
+    obj->m_gridIndex = this;
+    obj->m_gridIndexPos = GetSize();
+
+    _x.push_back(obj->GetPositionX());
+    _y.push_back(obj->GetPositionY());
+    _size.push_back(obj->GetObjectSize());
+    _phaseMask.push_back(obj->GetPhaseMask());
+    _objects.push_back(obj);
+}
+
+void GridObjectIndex::Remove(WorldObject* obj)
+{
+    ASSERT(obj->m_gridIndex == this);
+
+    // the last entry takes the free position
+    uint32 pos = obj->m_gridIndexPos;
+    uint32 last = GetSize() - 1;
+    if (pos != last)
+    {
+        _x[pos] = _x[last];
+        _y[pos] = _y[last];
+        _size[pos] = _size[last];
+        _phaseMask[pos] = _phaseMask[last];
+        _objects[pos] = _objects[last];
+        _objects[pos]->m_gridIndexPos = pos;
+    }
+
+    _x.pop_back();
+    _y.pop_back();
+    _size.pop_back();
+    _phaseMask.pop_back();
+    _objects.pop_back();
+
+    obj->m_gridIndex = NULL;
+}
+
+void GridObjectIndex::Update(WorldObject const* obj)
+{
+    uint32 pos = obj->m_gridIndexPos;
+    _x[pos] = obj->GetPositionX();
+    _y[pos] = obj->GetPositionY();
+    _size[pos] = obj->GetObjectSize();
+    _phaseMask[pos] = obj->GetPhaseMask();
+}
+
+uint32 GridObjectIndex::FilterBlock(uint32 first, float x, float y, float range, uint32 phaseMask, uint32* hits) const
+{
+    uint32 end = std::min<uint32>(first + BLOCK_SIZE, GetSize());
+    uint32 count = 0;
+    uint32 pos = first;
+
+    range += RangeTolerance;
+
+#ifdef GRID_OBJECT_INDEX_SSE2
+    __m128 centerX = _mm_set1_ps(x);
+    __m128 centerY = _mm_set1_ps(y);
+    __m128 radius = _mm_set1_ps(range);
+    __m128i phase = _mm_set1_epi32(int32(phaseMask));
+    __m128i zero = _mm_setzero_si128();
+
+    for (; pos + 4 <= end; pos += 4)
+    {
+        __m128 dx = _mm_sub_ps(_mm_loadu_ps(&_x[pos]), centerX);
+        __m128 dy = _mm_sub_ps(_mm_loadu_ps(&_y[pos]), centerY);
+        __m128 maxDist = _mm_add_ps(radius, _mm_loadu_ps(&_size[pos]));
+        __m128 inRange = _mm_cmple_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(maxDist, maxDist));
+
+        __m128i phases = _mm_and_si128(_mm_loadu_si128(reinterpret_cast<__m128i const*>(&_phaseMask[pos])), phase);
+        __m128 outOfPhase = _mm_castsi128_ps(_mm_cmpeq_epi32(phases, zero));
+
+        int mask = _mm_movemask_ps(_mm_andnot_ps(outOfPhase, inRange));
+        for (uint32 i = 0; mask; ++i, mask >>= 1)
+            if (mask & 1)
+                hits[count++] = pos + i;
+    }
+#endif
+
+    for (; pos < end; ++pos)
+    {
+        if (!(_phaseMask[pos] & phaseMask))
+            continue;
+
+        float dx = _x[pos] - x;
+        float dy = _y[pos] - y;
+        float maxDist = range + _size[pos];
+        if (dx * dx + dy * dy <= maxDist * maxDist)
+            hits[count++] = pos;
+    }
+
+    return count;
+}
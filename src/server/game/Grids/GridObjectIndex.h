@@ -0,0 +1,65 @@
+/*
+ * Copyright (C) 2008-2012 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_GRIDOBJECTINDEX_H
+#define TRINITY_GRIDOBJECTINDEX_H
+
+#include "Define.h"
+
+#include <vector>
+
+class WorldObject;
+
+// Positions, sizes and phases of the objects linked into one cell container, kept as arrays next to the
+// intrusive object list so that searches can reject far away objects without touching them.
+// Entries are added and removed by GridObject and refreshed by WorldObject on relocation, size and phase changes.
+class GridObjectIndex
+{
+    public:
+        enum
+        {
+            BLOCK_SIZE  = 64                                // entries filtered per FilterBlock call
+        };
+
+        GridObjectIndex() { }
+        ~GridObjectIndex();
+
+        void Insert(WorldObject* obj);
+        void Remove(WorldObject* obj);
+        void Update(WorldObject const* obj);
+
+        uint32 GetSize() const { return uint32(_objects.size()); }
+        WorldObject* GetObjectAt(uint32 pos) const { return _objects[pos]; }
+
+        // Stores into hits the positions of the entries in [first, first + BLOCK_SIZE) which are in one of the phases
+        // of phaseMask and whose 2d distance to (x, y) is at most range plus their own size, returns their count.
+        // Never rejects an object passing a WorldObject::IsWithinDist(InMap) check with the same center and range
+        // if range includes the size of the center object.
+        uint32 FilterBlock(uint32 first, float x, float y, float range, uint32 phaseMask, uint32* hits) const;
+
+    private:
+        GridObjectIndex(GridObjectIndex const&);
+        GridObjectIndex& operator=(GridObjectIndex const&);
+
+        std::vector<float> _x;
+        std::vector<float> _y;
+        std::vector<float> _size;
+        std::vector<uint32> _phaseMask;
+        std::vector<WorldObject*> _objects;
+};
+
+#endif
@@ -20,6 +20,7 @@
 #define _GRIDREFMANAGER
 
 #include "RefManager.h"
+#include "GridObjectIndex.h"
 
 template<class OBJECT>
 class GridReference;
@@ -37,6 +38,13 @@ class GridRefManager : public RefManager<GridRefManager<OBJECT>, OBJECT>
         iterator end() { return iterator(NULL); }
         iterator rbegin() { return iterator(getLast()); }
         iterator rend() { return iterator(NULL); }
+
+        // only maintained for world objects, see GridObject
+        GridObjectIndex& GetIndex() { return _index; }
+        GridObjectIndex const& GetIndex() const { return _index; }
+
+    private:
+        GridObjectIndex _index;
 };
 #endif
 
@@ -127,10 +127,11 @@ namespace Trinity
         float i_distSq;
         uint32 team;
         Player const* skipped_receiver;
+        SharedPacketScope i_share;                          // receivers reference one copy of the packet
         MessageDistDeliverer(WorldObject* src, WorldPacket* msg, float dist, bool own_team_only = false, Player const* skipped = NULL)
             : i_source(src), i_message(msg), i_phaseMask(src->GetPhaseMask()), i_distSq(dist * dist)
             , team((own_team_only && src->GetTypeId() == TYPEID_PLAYER) ? ((Player*)src)->GetTeam() : 0)
-            , skipped_receiver(skipped)
+            , skipped_receiver(skipped), i_share(msg)
         {
         }
         void Visit(PlayerMapType &m);
@@ -163,6 +164,88 @@ namespace Trinity
 
     // SEARCHERS & LIST SEARCHERS & WORKERS
 
+    // Checks accepting only objects within a range of a center object, as tested by WorldObject::IsWithinDist(InMap),
+    // derive from SearchAreaCheck<Check> and provide GetSearchCenter() and GetSearchRange(). The searchers then skip
+    // every other object of a cell by the position index of the cell, without touching it.
+    template<class Check>
+    struct SearchAreaCheck { };
+
+    template<class Check>
+    inline bool GetSearchArea(SearchAreaCheck<Check> const* check, WorldObject const*& center, float& range)
+    {
+        center = static_cast<Check const*>(check)->GetSearchCenter();
+        range = static_cast<Check const*>(check)->GetSearchRange();
+        return true;
+    }
+
+    inline bool GetSearchArea(void const* /*check*/, WorldObject const*& /*center*/, float& /*range*/) { return false; }
+
+    // Objects of a cell container in one of the phases of phaseMask. For checks with a search area only the
+    // ones the filter of the cell index lets through, in index order instead of list order.
+    template<class T, class Check>
+    class CellSearch
+    {
+        public:
+            CellSearch(GridRefManager<T>& m, uint32 phaseMask, Check const& check)
+                : i_itr(m.begin()), i_end(m.end()), i_index(m.GetIndex()), i_phaseMask(phaseMask), i_check(check),
+                i_useIndex(false), i_block(0), i_hitCount(0), i_hit(0)
+            {
+                WorldObject const* center;
+                float range;
+                // gameobjects compare distances using their model bounds instead of the object size
+                if (GetSearchArea(&i_check, center, range))
+                    i_useIndex = center->GetTypeId() != TYPEID_GAMEOBJECT;
+            }
+
+            T* Next()
+            {
+                if (!i_useIndex)
+                {
+                    for (; i_itr != i_end; ++i_itr)
+                    {
+                        T* obj = i_itr->getSource();
+                        if (obj->InSamePhase(i_phaseMask))
+                        {
+                            ++i_itr;
+                            return obj;
+                        }
+                    }
+
+                    return NULL;
+                }
+
+                while (i_hit == i_hitCount)
+                {
+                    if (i_block >= i_index.GetSize())
+                        return NULL;
+
+                    // nearest checks narrow their range while searching, read it again for each block
+                    WorldObject const* center;
+                    float range;
+                    GetSearchArea(&i_check, center, range);
+
+                    i_hitCount = i_index.FilterBlock(i_block, center->GetPositionX(), center->GetPositionY(),
+                        range + center->GetObjectSize(), i_phaseMask, i_hits);
+                    i_hit = 0;
+                    i_block += GridObjectIndex::BLOCK_SIZE;
+                }
+
+                return static_cast<T*>(i_index.GetObjectAt(i_hits[i_hit++]));
+            }
+
+        private:
+            typename GridRefManager<T>::iterator i_itr;
+            typename GridRefManager<T>::iterator i_end;
+            GridObjectIndex const& i_index;
+            uint32 i_phaseMask;
+            Check const& i_check;
+            bool i_useIndex;
+            uint32 i_block;
+            uint32 i_hitCount;
+            uint32 i_hit;
+            uint32 i_hits[GridObjectIndex::BLOCK_SIZE];
+    };
+
     // WorldObject searchers & workers
 
     template<class Check>
@@ -625,7 +708,7 @@ namespace Trinity
     };
 
     // Find the nearest Fishing hole and return true only if source object is in range of hole
-    class NearestGameObjectFishingHole
+    class NearestGameObjectFishingHole : public SearchAreaCheck<NearestGameObjectFishingHole>
     {
         public:
             NearestGameObjectFishingHole(WorldObject const& obj, float range) : i_obj(obj), i_range(range) {}
@@ -639,6 +722,8 @@ namespace Trinity
                 return false;
             }
             float GetLastRange() const { return i_range; }
+            WorldObject const* GetSearchCenter() const { return &i_obj; }
+            float GetSearchRange() const { return i_range; }
         private:
             WorldObject const& i_obj;
             float  i_range;
@@ -647,7 +732,7 @@ namespace Trinity
             NearestGameObjectFishingHole(NearestGameObjectFishingHole const&);
     };
 
-    class NearestGameObjectCheck
+    class NearestGameObjectCheck : public SearchAreaCheck<NearestGameObjectCheck>
     {
         public:
             NearestGameObjectCheck(WorldObject const& obj) : i_obj(obj), i_range(999) {}
@@ -661,6 +746,8 @@ namespace Trinity
                 return false;
             }
             float GetLastRange() const { return i_range; }
+            WorldObject const* GetSearchCenter() const { return &i_obj; }
+            float GetSearchRange() const { return i_range; }
         private:
             WorldObject const& i_obj;
             float i_range;
@@ -670,7 +757,7 @@ namespace Trinity
     };
 
     // Success at unit in range, range update for next check (this can be use with GameobjectLastSearcher to find nearest GO)
-    class NearestGameObjectEntryInObjectRangeCheck
+    class NearestGameObjectEntryInObjectRangeCheck : public SearchAreaCheck<NearestGameObjectEntryInObjectRangeCheck>
     {
         public:
             NearestGameObjectEntryInObjectRangeCheck(WorldObject const& obj, uint32 entry, float range) : i_obj(obj), i_entry(entry), i_range(range) {}
@@ -684,6 +771,8 @@ namespace Trinity
                 return false;
             }
             float GetLastRange() const { return i_range; }
+            WorldObject const* GetSearchCenter() const { return &i_obj; }
+            float GetSearchRange() const { return i_range; }
         private:
             WorldObject const& i_obj;
             uint32 i_entry;
@@ -708,7 +797,7 @@ namespace Trinity
 
     // Unit checks
 
-    class MostHPMissingInRange
+    class MostHPMissingInRange : public SearchAreaCheck<MostHPMissingInRange>
     {
         public:
             MostHPMissingInRange(Unit const* obj, float range, uint32 hp) : i_obj(obj), i_range(range), i_hp(hp) {}
@@ -721,13 +810,15 @@ namespace Trinity
                 }
                 return false;
             }
+            WorldObject const* GetSearchCenter() const { return i_obj; }
+            float GetSearchRange() const { return i_range; }
         private:
             Unit const* i_obj;
             float i_range;
             uint32 i_hp;
     };
 
-    class FriendlyCCedInRange
+    class FriendlyCCedInRange : public SearchAreaCheck<FriendlyCCedInRange>
     {
         public:
             FriendlyCCedInRange(Unit const* obj, float range) : i_obj(obj), i_range(range) {}
@@ -740,12 +831,14 @@ namespace Trinity
                 }
                 return false;
             }
+            WorldObject const* GetSearchCenter() const { return i_obj; }
+            float GetSearchRange() const { return i_range; }
         private:
             Unit const* i_obj;
             float i_range;
     };
 
-    class FriendlyMissingBuffInRange
+    class FriendlyMissingBuffInRange : public SearchAreaCheck<FriendlyMissingBuffInRange>
     {
         public:
             FriendlyMissingBuffInRange(Unit const* obj, float range, uint32 spellid) : i_obj(obj), i_range(range), i_spell(spellid) {}
@@ -758,13 +851,15 @@ namespace Trinity
                 }
                 return false;
             }
+            WorldObject const* GetSearchCenter() const { return i_obj; }
+            float GetSearchRange() const { return i_range; }
         private:
             Unit const* i_obj;
             float i_range;
             uint32 i_spell;
     };
 
-    class AnyUnfriendlyUnitInObjectRangeCheck
+    class AnyUnfriendlyUnitInObjectRangeCheck : public SearchAreaCheck<AnyUnfriendlyUnitInObjectRangeCheck>
     {
         public:
             AnyUnfriendlyUnitInObjectRangeCheck(WorldObject const* obj, Unit const* funit, float range) : i_obj(obj), i_funit(funit), i_range(range) {}
@@ -775,13 +870,15 @@ namespace Trinity
                 else
                     return false;
             }
+            WorldObject const* GetSearchCenter() const { return i_obj; }
+            float GetSearchRange() const { return i_range; }
         private:
             WorldObject const* i_obj;
             Unit const* i_funit;
             float i_range;
     };
 
-    class AnyUnfriendlyNoTotemUnitInObjectRangeCheck
+    class AnyUnfriendlyNoTotemUnitInObjectRangeCheck : public SearchAreaCheck<AnyUnfriendlyNoTotemUnitInObjectRangeCheck>
     {
         public:
             AnyUnfriendlyNoTotemUnitInObjectRangeCheck(WorldObject const* obj, Unit const* funit, float range) : i_obj(obj), i_funit(funit), i_range(range) {}
@@ -801,13 +898,15 @@ namespace Trinity
 
                 return i_obj->IsWithinDistInMap(u, i_range) && !i_funit->IsFriendlyTo(u);
             }
+            WorldObject const* GetSearchCenter() const { return i_obj; }
+            float GetSearchRange() const { return i_range; }
         private:
             WorldObject const* i_obj;
             Unit const* i_funit;
             float i_range;
     };
 
-    class AnyUnfriendlyAttackableVisibleUnitInObjectRangeCheck
+    class AnyUnfriendlyAttackableVisibleUnitInObjectRangeCheck : public SearchAreaCheck<AnyUnfriendlyAttackableVisibleUnitInObjectRangeCheck>
     {
         public:
             AnyUnfriendlyAttackableVisibleUnitInObjectRangeCheck(Unit const* funit, float range)
@@ -822,6 +921,8 @@ namespace Trinity
                     && u->GetCreatureType() != CREATURE_TYPE_CRITTER
                     && i_funit->canSeeOrDetect(u);
             }
+            WorldObject const* GetSearchCenter() const { return i_funit; }
+            float GetSearchRange() const { return i_range; }
         private:
             Unit const* i_funit;
             float i_range;
@@ -840,7 +941,7 @@ namespace Trinity
             uint32 i_lowguid;
     };
 
-    class AnyFriendlyUnitInObjectRangeCheck
+    class AnyFriendlyUnitInObjectRangeCheck : public SearchAreaCheck<AnyFriendlyUnitInObjectRangeCheck>
     {
         public:
             AnyFriendlyUnitInObjectRangeCheck(WorldObject const* obj, Unit const* funit, float range) : i_obj(obj), i_funit(funit), i_range(range) {}
@@ -851,13 +952,15 @@ namespace Trinity
                 else
                     return false;
             }
+            WorldObject const* GetSearchCenter() const { return i_obj; }
+            float GetSearchRange() const { return i_range; }
         private:
             WorldObject const* i_obj;
             Unit const* i_funit;
             float i_range;
     };
 
-    class AnyGroupedUnitInObjectRangeCheck
+    class AnyGroupedUnitInObjectRangeCheck : public SearchAreaCheck<AnyGroupedUnitInObjectRangeCheck>
     {
         public:
             AnyGroupedUnitInObjectRangeCheck(WorldObject const* obj, Unit const* funit, float range, bool raid) : _source(obj), _refUnit(funit), _range(range), _raid(raid) {}
@@ -874,6 +977,9 @@ namespace Trinity
                 return !_refUnit->IsHostileTo(u) && u->isAlive() && _source->IsWithinDistInMap(u, _range);
             }
 
+            WorldObject const* GetSearchCenter() const { return _source; }
+            float GetSearchRange() const { return _range; }
+
         private:
             WorldObject const* _source;
             Unit const* _refUnit;
@@ -881,7 +987,7 @@ namespace Trinity
             bool _raid;
     };
 
-    class AnyUnitInObjectRangeCheck
+    class AnyUnitInObjectRangeCheck : public SearchAreaCheck<AnyUnitInObjectRangeCheck>
     {
         public:
             AnyUnitInObjectRangeCheck(WorldObject const* obj, float range) : i_obj(obj), i_range(range) {}
@@ -892,13 +998,15 @@ namespace Trinity
 
                 return false;
             }
+            WorldObject const* GetSearchCenter() const { return i_obj; }
+            float GetSearchRange() const { return i_range; }
         private:
             WorldObject const* i_obj;
             float i_range;
     };
 
     // Success at unit in range, range update for next check (this can be use with UnitLastSearcher to find nearest unit)
-    class NearestAttackableUnitInObjectRangeCheck
+    class NearestAttackableUnitInObjectRangeCheck : public SearchAreaCheck<NearestAttackableUnitInObjectRangeCheck>
     {
         public:
             NearestAttackableUnitInObjectRangeCheck(WorldObject const* obj, Unit const* funit, float range) : i_obj(obj), i_funit(funit), i_range(range) {}
@@ -913,6 +1021,8 @@ namespace Trinity
 
                 return false;
             }
+            WorldObject const* GetSearchCenter() const { return i_obj; }
+            float GetSearchRange() const { return i_range; }
         private:
             WorldObject const* i_obj;
             Unit const* i_funit;
@@ -922,7 +1032,7 @@ namespace Trinity
             NearestAttackableUnitInObjectRangeCheck(NearestAttackableUnitInObjectRangeCheck const&);
     };
 
-    class AnyAoETargetUnitInObjectRangeCheck
+    class AnyAoETargetUnitInObjectRangeCheck : public SearchAreaCheck<AnyAoETargetUnitInObjectRangeCheck>
     {
         public:
             AnyAoETargetUnitInObjectRangeCheck(WorldObject const* obj, Unit const* funit, float range)
@@ -947,6 +1057,8 @@ namespace Trinity
 
                 return false;
             }
+            WorldObject const* GetSearchCenter() const { return i_obj; }
+            float GetSearchRange() const { return i_range; }
         private:
             bool i_targetForPlayer;
             WorldObject const* i_obj;
@@ -1001,7 +1113,7 @@ namespace Trinity
 
     // Creature checks
 
-    class NearestHostileUnitCheck
+    class NearestHostileUnitCheck : public SearchAreaCheck<NearestHostileUnitCheck>
     {
         public:
             explicit NearestHostileUnitCheck(Creature const* creature, float dist = 0) : me(creature)
@@ -1020,13 +1132,16 @@ namespace Trinity
                 return true;
             }
 
+            WorldObject const* GetSearchCenter() const { return me; }
+            float GetSearchRange() const { return m_range; }
+
     private:
             Creature const* me;
             float m_range;
             NearestHostileUnitCheck(NearestHostileUnitCheck const&);
     };
 
-    class NearestHostileUnitInAttackDistanceCheck
+    class NearestHostileUnitInAttackDistanceCheck : public SearchAreaCheck<NearestHostileUnitInAttackDistanceCheck>
     {
         public:
             explicit NearestHostileUnitInAttackDistanceCheck(Creature const* creature, float dist = 0) : me(creature)
@@ -1054,6 +1169,8 @@ namespace Trinity
                 return true;
             }
             float GetLastRange() const { return m_range; }
+            WorldObject const* GetSearchCenter() const { return me; }
+            float GetSearchRange() const { return m_range; }
         private:
             Creature const* me;
             float m_range;
@@ -1061,7 +1178,7 @@ namespace Trinity
             NearestHostileUnitInAttackDistanceCheck(NearestHostileUnitInAttackDistanceCheck const&);
     };
 
-    class AnyAssistCreatureInRangeCheck
+    class AnyAssistCreatureInRangeCheck : public SearchAreaCheck<AnyAssistCreatureInRangeCheck>
     {
         public:
             AnyAssistCreatureInRangeCheck(Unit* funit, Unit* enemy, float range)
@@ -1086,13 +1203,15 @@ namespace Trinity
 
                 return true;
             }
+            WorldObject const* GetSearchCenter() const { return i_funit; }
+            float GetSearchRange() const { return i_range; }
         private:
             Unit* const i_funit;
             Unit* const i_enemy;
             float i_range;
     };
 
-    class NearestAssistCreatureInCreatureRangeCheck
+    class NearestAssistCreatureInCreatureRangeCheck : public SearchAreaCheck<NearestAssistCreatureInCreatureRangeCheck>
     {
         public:
             NearestAssistCreatureInCreatureRangeCheck(Creature* obj, Unit* enemy, float range)
@@ -1115,6 +1234,8 @@ namespace Trinity
                 return true;
             }
             float GetLastRange() const { return i_range; }
+            WorldObject const* GetSearchCenter() const { return i_obj; }
+            float GetSearchRange() const { return i_range; }
         private:
             Creature* const i_obj;
             Unit* const i_enemy;
@@ -1125,7 +1246,7 @@ namespace Trinity
     };
 
     // Success at unit in range, range update for next check (this can be use with CreatureLastSearcher to find nearest creature)
-    class NearestCreatureEntryWithLiveStateInObjectRangeCheck
+    class NearestCreatureEntryWithLiveStateInObjectRangeCheck : public SearchAreaCheck<NearestCreatureEntryWithLiveStateInObjectRangeCheck>
     {
         public:
             NearestCreatureEntryWithLiveStateInObjectRangeCheck(WorldObject const& obj, uint32 entry, bool alive, float range)
@@ -1141,6 +1262,8 @@ namespace Trinity
                 return false;
             }
             float GetLastRange() const { return i_range; }
+            WorldObject const* GetSearchCenter() const { return &i_obj; }
+            float GetSearchRange() const { return i_range; }
         private:
             WorldObject const& i_obj;
             uint32 i_entry;
@@ -1151,7 +1274,7 @@ namespace Trinity
             NearestCreatureEntryWithLiveStateInObjectRangeCheck(NearestCreatureEntryWithLiveStateInObjectRangeCheck const&);
     };
 
-    class AnyPlayerInObjectRangeCheck
+    class AnyPlayerInObjectRangeCheck : public SearchAreaCheck<AnyPlayerInObjectRangeCheck>
     {
         public:
             AnyPlayerInObjectRangeCheck(WorldObject const* obj, float range, bool reqAlive = true) : _obj(obj), _range(range), _reqAlive(reqAlive) {}
@@ -1166,13 +1289,16 @@ namespace Trinity
                 return true;
             }
 
+            WorldObject const* GetSearchCenter() const { return _obj; }
+            float GetSearchRange() const { return _range; }
+
         private:
             WorldObject const* _obj;
             float _range;
             bool _reqAlive;
     };
 
-    class NearestPlayerInObjectRangeCheck
+    class NearestPlayerInObjectRangeCheck : public SearchAreaCheck<NearestPlayerInObjectRangeCheck>
     {
         public:
             NearestPlayerInObjectRangeCheck(WorldObject const* obj, float range) : i_obj(obj), i_range(range)
@@ -1189,6 +1315,8 @@ namespace Trinity
 
                 return false;
             }
+            WorldObject const* GetSearchCenter() const { return i_obj; }
+            float GetSearchRange() const { return i_range; }
         private:
             WorldObject const* i_obj;
             float i_range;
@@ -1211,7 +1339,7 @@ namespace Trinity
         Unit const* unit;
     };
 
-    class AllGameObjectsWithEntryInRange
+    class AllGameObjectsWithEntryInRange : public SearchAreaCheck<AllGameObjectsWithEntryInRange>
     {
     public:
         AllGameObjectsWithEntryInRange(const WorldObject* object, uint32 entry, float maxRange) : m_pObject(object), m_uiEntry(entry), m_fRange(maxRange) {}
@@ -1222,13 +1350,15 @@ namespace Trinity
 
             return false;
         }
+        WorldObject const* GetSearchCenter() const { return m_pObject; }
+        float GetSearchRange() const { return m_fRange; }
     private:
         const WorldObject* m_pObject;
         uint32 m_uiEntry;
         float m_fRange;
     };
 
-    class AllCreaturesOfEntryInRange
+    class AllCreaturesOfEntryInRange : public SearchAreaCheck<AllCreaturesOfEntryInRange>
     {
         public:
             AllCreaturesOfEntryInRange(const WorldObject* object, uint32 entry, float maxRange) : m_pObject(object), m_uiEntry(entry), m_fRange(maxRange) {}
@@ -1240,6 +1370,9 @@ namespace Trinity
                 return false;
             }
 
+            WorldObject const* GetSearchCenter() const { return m_pObject; }
+            float GetSearchRange() const { return m_fRange; }
+
         private:
             const WorldObject* m_pObject;
             uint32 m_uiEntry;
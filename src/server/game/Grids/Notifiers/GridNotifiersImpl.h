@@ -51,14 +51,12 @@ void Trinity::WorldObjectSearcher<Check>::Visit(GameObjectMapType &m)
     if (i_object)
         return;
 
-    for (GameObjectMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
+    CellSearch<GameObject, Check> search(m, i_phaseMask, i_check);
+    while (GameObject* obj = search.Next())
     {
-        if (!itr->getSource()->InSamePhase(i_phaseMask))
-            continue;
-
-        if (i_check(itr->getSource()))
+        if (i_check(obj))
         {
-            i_object = itr->getSource();
+            i_object = obj;
             return;
         }
     }
@@ -74,14 +72,12 @@ void Trinity::WorldObjectSearcher<Check>::Visit(PlayerMapType &m)
     if (i_object)
         return;
 
-    for (PlayerMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
+    CellSearch<Player, Check> search(m, i_phaseMask, i_check);
+    while (Player* obj = search.Next())
     {
-        if (!itr->getSource()->InSamePhase(i_phaseMask))
-            continue;
-
-        if (i_check(itr->getSource()))
+        if (i_check(obj))
         {
-            i_object = itr->getSource();
+            i_object = obj;
             return;
         }
     }
@@ -97,14 +93,12 @@ void Trinity::WorldObjectSearcher<Check>::Visit(CreatureMapType &m)
     if (i_object)
         return;
 
-    for (CreatureMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
+    CellSearch<Creature, Check> search(m, i_phaseMask, i_check);
+    while (Creature* obj = search.Next())
     {
-        if (!itr->getSource()->InSamePhase(i_phaseMask))
-            continue;
-
-        if (i_check(itr->getSource()))
+        if (i_check(obj))
         {
-            i_object = itr->getSource();
+            i_object = obj;
             return;
         }
     }
@@ -120,14 +114,12 @@ void Trinity::WorldObjectSearcher<Check>::Visit(CorpseMapType &m)
     if (i_object)
         return;
 
-    for (CorpseMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
+    CellSearch<Corpse, Check> search(m, i_phaseMask, i_check);
+    while (Corpse* obj = search.Next())
     {
-        if (!itr->getSource()->InSamePhase(i_phaseMask))
-            continue;
-
-        if (i_check(itr->getSource()))
+        if (i_check(obj))
         {
-            i_object = itr->getSource();
+            i_object = obj;
             return;
         }
     }
@@ -143,14 +135,12 @@ void Trinity::WorldObjectSearcher<Check>::Visit(DynamicObjectMapType &m)
     if (i_object)
         return;
 
-    for (DynamicObjectMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
+    CellSearch<DynamicObject, Check> search(m, i_phaseMask, i_check);
+    while (DynamicObject* obj = search.Next())
     {
-        if (!itr->getSource()->InSamePhase(i_phaseMask))
-            continue;
-
-        if (i_check(itr->getSource()))
+        if (i_check(obj))
         {
-            i_object = itr->getSource();
+            i_object = obj;
             return;
         }
     }
@@ -163,14 +153,10 @@ void Trinity::WorldObjectLastSearcher<Check>::Visit(GameObjectMapType &m)
     if (!(i_mapTypeMask & GRID_MAP_TYPE_MASK_GAMEOBJECT))
         return;
 
-    for (GameObjectMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
-    {
-        if (!itr->getSource()->InSamePhase(i_phaseMask))
-            continue;
-
-        if (i_check(itr->getSource()))
-            i_object = itr->getSource();
-    }
+    CellSearch<GameObject, Check> search(m, i_phaseMask, i_check);
+    while (GameObject* obj = search.Next())
+        if (i_check(obj))
+            i_object = obj;
 }
 
 template<class Check>
@@ -179,14 +165,10 @@ void Trinity::WorldObjectLastSearcher<Check>::Visit(PlayerMapType &m)
     if (!(i_mapTypeMask & GRID_MAP_TYPE_MASK_PLAYER))
         return;
 
-    for (PlayerMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
-    {
-        if (!itr->getSource()->InSamePhase(i_phaseMask))
-            continue;
-
-        if (i_check(itr->getSource()))
-            i_object = itr->getSource();
-    }
+    CellSearch<Player, Check> search(m, i_phaseMask, i_check);
+    while (Player* obj = search.Next())
+        if (i_check(obj))
+            i_object = obj;
 }
 
 template<class Check>
@@ -195,14 +177,10 @@ void Trinity::WorldObjectLastSearcher<Check>::Visit(CreatureMapType &m)
     if (!(i_mapTypeMask & GRID_MAP_TYPE_MASK_CREATURE))
         return;
 
-    for (CreatureMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
-    {
-        if (!itr->getSource()->InSamePhase(i_phaseMask))
-            continue;
-
-        if (i_check(itr->getSource()))
-            i_object = itr->getSource();
-    }
+    CellSearch<Creature, Check> search(m, i_phaseMask, i_check);
+    while (Creature* obj = search.Next())
+        if (i_check(obj))
+            i_object = obj;
 }
 
 template<class Check>
@@ -211,14 +189,10 @@ void Trinity::WorldObjectLastSearcher<Check>::Visit(CorpseMapType &m)
     if (!(i_mapTypeMask & GRID_MAP_TYPE_MASK_CORPSE))
         return;
 
-    for (CorpseMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
-    {
-        if (!itr->getSource()->InSamePhase(i_phaseMask))
-            continue;
-
-        if (i_check(itr->getSource()))
-            i_object = itr->getSource();
-    }
+    CellSearch<Corpse, Check> search(m, i_phaseMask, i_check);
+    while (Corpse* obj = search.Next())
+        if (i_check(obj))
+            i_object = obj;
 }
 
 template<class Check>
@@ -227,14 +201,10 @@ void Trinity::WorldObjectLastSearcher<Check>::Visit(DynamicObjectMapType &m)
     if (!(i_mapTypeMask & GRID_MAP_TYPE_MASK_DYNAMICOBJECT))
         return;
 
-    for (DynamicObjectMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
-    {
-        if (!itr->getSource()->InSamePhase(i_phaseMask))
-            continue;
-
-        if (i_check(itr->getSource()))
-            i_object = itr->getSource();
-    }
+    CellSearch<DynamicObject, Check> search(m, i_phaseMask, i_check);
+    while (DynamicObject* obj = search.Next())
+        if (i_check(obj))
+            i_object = obj;
 }
 
 template<class Check>
@@ -301,14 +271,12 @@ void Trinity::GameObjectSearcher<Check>::Visit(GameObjectMapType &m)
     if (i_object)
         return;
 
-    for (GameObjectMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
+    CellSearch<GameObject, Check> search(m, i_phaseMask, i_check);
+    while (GameObject* obj = search.Next())
     {
-        if (!itr->getSource()->InSamePhase(i_phaseMask))
-            continue;
-
-        if (i_check(itr->getSource()))
+        if (i_check(obj))
         {
-            i_object = itr->getSource();
+            i_object = obj;
             return;
         }
     }
@@ -317,23 +285,19 @@ void Trinity::GameObjectSearcher<Check>::Visit(GameObjectMapType &m)
 template<class Check>
 void Trinity::GameObjectLastSearcher<Check>::Visit(GameObjectMapType &m)
 {
-    for (GameObjectMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
-    {
-        if (!itr->getSource()->InSamePhase(i_phaseMask))
-            continue;
-
-        if (i_check(itr->getSource()))
-            i_object = itr->getSource();
-    }
+    CellSearch<GameObject, Check> search(m, i_phaseMask, i_check);
+    while (GameObject* obj = search.Next())
+        if (i_check(obj))
+            i_object = obj;
 }
 
 template<class Check>
 void Trinity::GameObjectListSearcher<Check>::Visit(GameObjectMapType &m)
 {
-    for (GameObjectMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
-        if (itr->getSource()->InSamePhase(i_phaseMask))
-            if (i_check(itr->getSource()))
-                i_objects.push_back(itr->getSource());
+    CellSearch<GameObject, Check> search(m, i_phaseMask, i_check);
+    while (GameObject* obj = search.Next())
+        if (i_check(obj))
+            i_objects.push_back(obj);
 }
 
 // Unit searchers
@@ -345,14 +309,12 @@ void Trinity::UnitSearcher<Check>::Visit(CreatureMapType &m)
     if (i_object)
         return;
 
-    for (CreatureMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
+    CellSearch<Creature, Check> search(m, i_phaseMask, i_check);
+    while (Creature* obj = search.Next())
     {
-        if (!itr->getSource()->InSamePhase(i_phaseMask))
-            continue;
-
-        if (i_check(itr->getSource()))
+        if (i_check(obj))
         {
-            i_object = itr->getSource();
+            i_object = obj;
             return;
         }
     }
@@ -365,14 +327,12 @@ void Trinity::UnitSearcher<Check>::Visit(PlayerMapType &m)
     if (i_object)
         return;
 
-    for (PlayerMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
+    CellSearch<Player, Check> search(m, i_phaseMask, i_check);
+    while (Player* obj = search.Next())
     {
-        if (!itr->getSource()->InSamePhase(i_phaseMask))
-            continue;
-
-        if (i_check(itr->getSource()))
+        if (i_check(obj))
         {
-            i_object = itr->getSource();
+            i_object = obj;
             return;
         }
     }
@@ -381,45 +341,37 @@ void Trinity::UnitSearcher<Check>::Visit(PlayerMapType &m)
 template<class Check>
 void Trinity::UnitLastSearcher<Check>::Visit(CreatureMapType &m)
 {
-    for (CreatureMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
-    {
-        if (!itr->getSource()->InSamePhase(i_phaseMask))
-            continue;
-
-        if (i_check(itr->getSource()))
-            i_object = itr->getSource();
-    }
+    CellSearch<Creature, Check> search(m, i_phaseMask, i_check);
+    while (Creature* obj = search.Next())
+        if (i_check(obj))
+            i_object = obj;
 }
 
 template<class Check>
 void Trinity::UnitLastSearcher<Check>::Visit(PlayerMapType &m)
 {
-    for (PlayerMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
-    {
-        if (!itr->getSource()->InSamePhase(i_phaseMask))
-            continue;
-
-        if (i_check(itr->getSource()))
-            i_object = itr->getSource();
-    }
+    CellSearch<Player, Check> search(m, i_phaseMask, i_check);
+    while (Player* obj = search.Next())
+        if (i_check(obj))
+            i_object = obj;
 }
 
 template<class Check>
 void Trinity::UnitListSearcher<Check>::Visit(PlayerMapType &m)
 {
-    for (PlayerMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
-        if (itr->getSource()->InSamePhase(i_phaseMask))
-            if (i_check(itr->getSource()))
-                i_objects.push_back(itr->getSource());
+    CellSearch<Player, Check> search(m, i_phaseMask, i_check);
+    while (Player* obj = search.Next())
+        if (i_check(obj))
+            i_objects.push_back(obj);
 }
 
 template<class Check>
 void Trinity::UnitListSearcher<Check>::Visit(CreatureMapType &m)
 {
-    for (CreatureMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
-        if (itr->getSource()->InSamePhase(i_phaseMask))
-            if (i_check(itr->getSource()))
-                i_objects.push_back(itr->getSource());
+    CellSearch<Creature, Check> search(m, i_phaseMask, i_check);
+    while (Creature* obj = search.Next())
+        if (i_check(obj))
+            i_objects.push_back(obj);
 }
 
 // Creature searchers
@@ -431,14 +383,12 @@ void Trinity::CreatureSearcher<Check>::Visit(CreatureMapType &m)
     if (i_object)
         return;
 
-    for (CreatureMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
+    CellSearch<Creature, Check> search(m, i_phaseMask, i_check);
+    while (Creature* obj = search.Next())
     {
-        if (!itr->getSource()->InSamePhase(i_phaseMask))
-            continue;
-
-        if (i_check(itr->getSource()))
+        if (i_check(obj))
         {
-            i_object = itr->getSource();
+            i_object = obj;
             return;
         }
     }
@@ -447,32 +397,28 @@ void Trinity::CreatureSearcher<Check>::Visit(CreatureMapType &m)
 template<class Check>
 void Trinity::CreatureLastSearcher<Check>::Visit(CreatureMapType &m)
 {
-    for (CreatureMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
-    {
-        if (!itr->getSource()->InSamePhase(i_phaseMask))
-            continue;
-
-        if (i_check(itr->getSource()))
-            i_object = itr->getSource();
-    }
+    CellSearch<Creature, Check> search(m, i_phaseMask, i_check);
+    while (Creature* obj = search.Next())
+        if (i_check(obj))
+            i_object = obj;
 }
 
 template<class Check>
 void Trinity::CreatureListSearcher<Check>::Visit(CreatureMapType &m)
 {
-    for (CreatureMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
-        if (itr->getSource()->InSamePhase(i_phaseMask))
-            if (i_check(itr->getSource()))
-                i_objects.push_back(itr->getSource());
+    CellSearch<Creature, Check> search(m, i_phaseMask, i_check);
+    while (Creature* obj = search.Next())
+        if (i_check(obj))
+            i_objects.push_back(obj);
 }
 
 template<class Check>
 void Trinity::PlayerListSearcher<Check>::Visit(PlayerMapType &m)
 {
-    for (PlayerMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
-        if (itr->getSource()->InSamePhase(i_phaseMask))
-            if (i_check(itr->getSource()))
-                i_objects.push_back(itr->getSource());
+    CellSearch<Player, Check> search(m, i_phaseMask, i_check);
+    while (Player* obj = search.Next())
+        if (i_check(obj))
+            i_objects.push_back(obj);
 }
 
 template<class Check>
@@ -482,14 +428,12 @@ void Trinity::PlayerSearcher<Check>::Visit(PlayerMapType &m)
     if (i_object)
         return;
 
-    for (PlayerMapType::iterator itr=m.begin(); itr != m.end(); ++itr)
+    CellSearch<Player, Check> search(m, i_phaseMask, i_check);
+    while (Player* obj = search.Next())
     {
-        if (!itr->getSource()->InSamePhase(i_phaseMask))
-            continue;
-
-        if (i_check(itr->getSource()))
+        if (i_check(obj))
         {
-            i_object = itr->getSource();
+            i_object = obj;
             return;
         }
     }
@@ -498,14 +442,10 @@ void Trinity::PlayerSearcher<Check>::Visit(PlayerMapType &m)
 template<class Check>
 void Trinity::PlayerLastSearcher<Check>::Visit(PlayerMapType& m)
 {
-    for (PlayerMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
-    {
-        if (!itr->getSource()->InSamePhase(i_phaseMask))
-            continue;
-
-        if (i_check(itr->getSource()))
-            i_object = itr->getSource();
-    }
+    CellSearch<Player, Check> search(m, i_phaseMask, i_check);
+    while (Player* obj = search.Next())
+        if (i_check(obj))
+            i_object = obj;
 }
 
 template<class Builder>
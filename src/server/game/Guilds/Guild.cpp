@@ -1637,7 +1637,7 @@ void Guild::HandleMemberDepositMoney(WorldSession* session, uint32 amount)
     // Log guild bank event
     _LogBankEvent(trans, GUILD_BANK_LOG_DEPOSIT_MONEY, uint8(0), player->GetGUIDLow(), amount);
 
-    CharacterDatabase.CommitTransaction(trans);
+    CharacterDatabase.CommitTransaction(trans, player->GetGUIDLow(), 0);
 
     SendBankTabsInfo(session);
     _SendBankContent(session, 0);
@@ -1678,7 +1678,7 @@ bool Guild::HandleMemberWithdrawMoney(WorldSession* session, uint32 amount, bool
     }
     // Log guild bank event
     _LogBankEvent(trans, repair ? GUILD_BANK_LOG_REPAIR_MONEY : GUILD_BANK_LOG_WITHDRAW_MONEY, uint8(0), player->GetGUIDLow(), amount);
-    CharacterDatabase.CommitTransaction(trans);
+    CharacterDatabase.CommitTransaction(trans, player->GetGUIDLow(), 0);
 
     SendMoneyInfo(session);
     if (!repair)
@@ -2622,7 +2622,7 @@ bool Guild::_DoItemsMove(MoveItemData* pSrc, MoveItemData* pDest, bool sendError
     if (swap)
         pSrc->StoreItem(trans, pDestItem);
 
-    CharacterDatabase.CommitTransaction(trans);
+    CharacterDatabase.CommitTransaction(trans, pSrc->GetPlayer()->GetGUIDLow(), 0);
     return true;
 }
 
@@ -521,6 +521,7 @@ private:
         void CopySlots(SlotIds& ids) const;
 
         Item* GetItem(bool isCloned = false) const { return isCloned ? m_pClonedItem : m_pItem; }
+        Player* GetPlayer() const { return m_pPlayer; }
         uint8 GetContainer() const { return m_container; }
         uint8 GetSlotId() const { return m_slotId; }
     protected:
@@ -272,7 +272,7 @@ void WorldSession::HandleAuctionSellItem(WorldPacket & recv_data)
             item->SaveToDB(trans);
             AH->SaveToDB(trans);
             _player->SaveInventoryAndGoldToDB(trans);
-            CharacterDatabase.CommitTransaction(trans);
+            CharacterDatabase.CommitTransaction(trans, _player->GetGUIDLow(), 0);
 
             SendAuctionCommandResult(AH->Id, AUCTION_SELL_ITEM, AUCTION_OK);
 
@@ -322,7 +322,7 @@ void WorldSession::HandleAuctionSellItem(WorldPacket & recv_data)
                     SQLTransaction trans = CharacterDatabase.BeginTransaction();
                     item2->DeleteFromInventoryDB(trans);
                     item2->DeleteFromDB(trans);
-                    CharacterDatabase.CommitTransaction(trans);
+                    CharacterDatabase.CommitTransaction(trans, _player->GetGUIDLow());
                 }
                 else // Item stack count is bigger than required count, update item stack count and save to database - cloned item will be used for auction
                 {
@@ -333,7 +333,7 @@ void WorldSession::HandleAuctionSellItem(WorldPacket & recv_data)
 
                     SQLTransaction trans = CharacterDatabase.BeginTransaction();
                     item2->SaveToDB(trans);
-                    CharacterDatabase.CommitTransaction(trans);
+                    CharacterDatabase.CommitTransaction(trans, _player->GetGUIDLow());
                 }
             }
 
@@ -341,7 +341,7 @@ void WorldSession::HandleAuctionSellItem(WorldPacket & recv_data)
             newItem->SaveToDB(trans);
             AH->SaveToDB(trans);
             _player->SaveInventoryAndGoldToDB(trans);
-            CharacterDatabase.CommitTransaction(trans);
+            CharacterDatabase.CommitTransaction(trans, _player->GetGUIDLow(), 0);
 
             SendAuctionCommandResult(AH->Id, AUCTION_SELL_ITEM, AUCTION_OK);
 
@@ -475,7 +475,7 @@ void WorldSession::HandleAuctionPlaceBid(WorldPacket & recv_data)
         auctionHouse->RemoveAuction(auction, item_template);
     }
     player->SaveInventoryAndGoldToDB(trans);
-    CharacterDatabase.CommitTransaction(trans);
+    CharacterDatabase.CommitTransaction(trans, player->GetGUIDLow(), 0);
 }
 
 //this void is called when auction_owner cancels his auction
@@ -551,7 +551,7 @@ void WorldSession::HandleAuctionRemoveItem(WorldPacket & recv_data)
 
     player->SaveInventoryAndGoldToDB(trans);
     auction->DeleteFromDB(trans);
-    CharacterDatabase.CommitTransaction(trans);
+    CharacterDatabase.CommitTransaction(trans, player->GetGUIDLow(), 0);
 
     uint32 item_template = auction->item_template;
     sAuctionMgr->RemoveAItem(auction->item_guidlow);
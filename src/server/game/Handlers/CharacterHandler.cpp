@@ -44,18 +44,22 @@
 #include "Battleground.h"
 #include "AccountMgr.h"
 #include "LFGMgr.h"
+#include "PlayerLoginLoader.h"
 
-class LoginQueryHolder : public SQLQueryHolder
+class LoginQueryHolder : public PlayerLoginLoader::LoginHolder
 {
     private:
         uint32 m_accountId;
         uint64 m_guid;
+        PlayerLoginData m_loginData;
     public:
         LoginQueryHolder(uint32 accountId, uint64 guid)
             : m_accountId(accountId), m_guid(guid) { }
         uint64 GetGuid() const { return m_guid; }
         uint32 GetAccountId() const { return m_accountId; }
+        PlayerLoginData& GetLoginData() { return m_loginData; }
         bool Initialize();
+        void LoadResults() { Player::LoadLoginDataFromDB(m_guid, this, m_loginData); }
 };
 
 bool LoginQueryHolder::Initialize()
@@ -198,6 +202,14 @@ bool LoginQueryHolder::Initialize()
     stmt->setUInt32(0, m_accountId);
     res &= SetPreparedQuery(PLAYER_LOGIN_QUERY_LOADINSTANCELOCKTIMES, stmt);
 
+    stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_CHARACTER_ITEM_REFUNDS);
+    stmt->setUInt32(0, lowGuid);
+    res &= SetPreparedQuery(PLAYER_LOGIN_QUERY_LOADITEMREFUNDS, stmt);
+
+    stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_CHARACTER_ITEM_BOP_TRADE);
+    stmt->setUInt32(0, lowGuid);
+    res &= SetPreparedQuery(PLAYER_LOGIN_QUERY_LOADITEMBOPTRADE, stmt);
+
     return res;
 }
 
@@ -246,7 +258,7 @@ void WorldSession::HandleCharEnumOpcode(WorldPacket & /*recv_data*/)
     stmt->setUInt8(0, PET_SAVE_AS_CURRENT);
     stmt->setUInt32(1, GetAccountId());
 
-    _charEnumCallback = CharacterDatabase.AsyncQuery(stmt);
+    _charEnumCallback = CharacterDatabase.AsyncQuery(stmt, m_charListGuidLow);
 }
 
 void WorldSession::HandleCharCreateOpcode(WorldPacket & recv_data)
@@ -390,7 +402,7 @@ void WorldSession::HandleCharCreateOpcode(WorldPacket & recv_data)
     _charCreateCallback.SetParam(new CharacterCreateInfo(name, race_, class_, gender, skin, face, hairStyle, hairColor, facialHair, outfitId, recv_data));
     PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_CHECK_NAME);
     stmt->setString(0, name);
-    _charCreateCallback.SetFutureResult(CharacterDatabase.AsyncQuery(stmt));
+    _charCreateCallback.SetFutureResult(CharacterDatabase.AsyncQuery(stmt, m_charListGuidLow));
 }
 
 void WorldSession::HandleCharCreateCallback(PreparedQueryResult result, CharacterCreateInfo* createInfo)
@@ -452,7 +464,7 @@ void WorldSession::HandleCharCreateCallback(PreparedQueryResult result, Characte
             stmt->setUInt32(0, GetAccountId());
 
             _charCreateCallback.FreeResult();
-            _charCreateCallback.SetFutureResult(CharacterDatabase.AsyncQuery(stmt));
+            _charCreateCallback.SetFutureResult(CharacterDatabase.AsyncQuery(stmt, m_charListGuidLow));
             _charCreateCallback.NextStage();
         }
         break;
@@ -484,7 +496,7 @@ void WorldSession::HandleCharCreateCallback(PreparedQueryResult result, Characte
                 PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_CHAR_CREATE_INFO);
                 stmt->setUInt32(0, GetAccountId());
                 stmt->setUInt32(1, (skipCinematics == 1 || createInfo->Class == CLASS_DEATH_KNIGHT) ? 10 : 1);
-                _charCreateCallback.SetFutureResult(CharacterDatabase.AsyncQuery(stmt));
+                _charCreateCallback.SetFutureResult(CharacterDatabase.AsyncQuery(stmt, m_charListGuidLow));
                 _charCreateCallback.NextStage();
                 return;
             }
@@ -636,6 +648,7 @@ void WorldSession::HandleCharCreateCallback(PreparedQueryResult result, Characte
 
             // Player created, save it now
             newChar.SaveToDB(true);
+            m_charListGuidLow = newChar.GetGUIDLow();
             createInfo->CharCount += 1;
 
             SQLTransaction trans = LoginDatabase.BeginTransaction();
@@ -732,6 +745,7 @@ void WorldSession::HandleCharDeleteOpcode(WorldPacket & recv_data)
     }
 
     Player::DeleteFromDB(guid, GetAccountId());
+    m_charListGuidLow = GUID_LOPART(guid);
 
     WorldPacket data(SMSG_CHAR_DELETE, 1);
     data << (uint8)CHAR_DELETE_SUCCESS;
@@ -768,7 +782,7 @@ void WorldSession::HandlePlayerLoginOpcode(WorldPacket & recv_data)
         return;
     }
 
-    _charLoginCallback = CharacterDatabase.DelayQueryHolder((SQLQueryHolder*)holder);
+    _charLoginCallback = CharacterDatabase.DelayQueryHolder((SQLQueryHolder*)holder, GUID_LOPART(playerGuid));
 }
 
 void WorldSession::HandlePlayerLogin(LoginQueryHolder* holder)
@@ -780,7 +794,7 @@ void WorldSession::HandlePlayerLogin(LoginQueryHolder* holder)
     ChatHandler chH = ChatHandler(pCurrChar);
 
     // "GetAccountId() == db stored account id" checked in LoadFromDB (prevent login not own character using cheating tools)
-    if (!pCurrChar->LoadFromDB(GUID_LOPART(playerGuid), holder))
+    if (!pCurrChar->LoadFromDB(GUID_LOPART(playerGuid), holder, holder->GetLoginData()))
     {
         SetPlayer(NULL);
         KickPlayer();                                       // disconnect client, player no set to session and it will not deleted or saved at kick
@@ -927,7 +941,7 @@ void WorldSession::HandlePlayerLogin(LoginQueryHolder* holder)
 
     stmt->setUInt32(0, pCurrChar->GetGUIDLow());
 
-    CharacterDatabase.Execute(stmt);
+    CharacterDatabase.Execute(stmt, pCurrChar->GetGUIDLow());
 
     stmt = LoginDatabase.GetPreparedStatement(LOGIN_UPD_ACCOUNT_ONLINE);
 
@@ -1147,7 +1161,7 @@ void WorldSession::HandleCharRenameOpcode(WorldPacket& recv_data)
     stmt->setUInt16(3, AT_LOGIN_RENAME);
     stmt->setString(4, newName);
 
-    _charRenameCallback.SetFutureResult(CharacterDatabase.AsyncQuery(stmt));
+    _charRenameCallback.SetFutureResult(CharacterDatabase.AsyncQuery(stmt, GUID_LOPART(guid)));
 }
 
 void WorldSession::HandleChangePlayerNameOpcodeCallBack(PreparedQueryResult result, std::string newName)
@@ -1174,14 +1188,15 @@ void WorldSession::HandleChangePlayerNameOpcodeCallBack(PreparedQueryResult resu
     stmt->setUInt16(1, AT_LOGIN_RENAME);
     stmt->setUInt32(2, guidLow);
 
-    CharacterDatabase.Execute(stmt);
+    CharacterDatabase.Execute(stmt, guidLow);
 
     // Removed declined name from db
     stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_DECLINED_NAME);
 
     stmt->setUInt32(0, guidLow);
 
-    CharacterDatabase.Execute(stmt);
+    CharacterDatabase.Execute(stmt, guidLow);
+    m_charListGuidLow = guidLow;
 
     sLog->outChar("Account: %d (IP: %s) Character:[%s] (guid:%u) Changed name to: %s", GetAccountId(), GetRemoteAddress().c_str(), oldName.c_str(), guidLow, newName.c_str());
 
@@ -1283,7 +1298,8 @@ void WorldSession::HandleSetPlayerDeclinedNames(WorldPacket& recv_data)
 
     trans->Append(stmt);
 
-    CharacterDatabase.CommitTransaction(trans);
+    CharacterDatabase.CommitTransaction(trans, GUID_LOPART(guid));
+    m_charListGuidLow = GUID_LOPART(guid);
 
     WorldPacket data(SMSG_SET_PLAYER_DECLINED_NAMES_RESULT, 4+8);
     data << uint32(0);                                      // OK
@@ -1461,13 +1477,14 @@ void WorldSession::HandleCharCustomize(WorldPacket& recv_data)
     stmt->setUInt16(1, uint16(AT_LOGIN_CUSTOMIZE));
     stmt->setUInt32(2, GUID_LOPART(guid));
 
-    CharacterDatabase.Execute(stmt);
+    CharacterDatabase.Execute(stmt, GUID_LOPART(guid));
 
     stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_DECLINED_NAME);
 
     stmt->setUInt32(0, GUID_LOPART(guid));
 
-    CharacterDatabase.Execute(stmt);
+    CharacterDatabase.Execute(stmt, GUID_LOPART(guid));
+    m_charListGuidLow = GUID_LOPART(guid);
 
     sWorld->UpdateCharacterNameData(GUID_LOPART(guid), newName, gender);
 
@@ -1992,7 +2009,8 @@ void WorldSession::HandleCharFactionOrRaceChange(WorldPacket& recv_data)
         }
     }
 
-    CharacterDatabase.CommitTransaction(trans);
+    CharacterDatabase.CommitTransaction(trans, lowGuid);
+    m_charListGuidLow = lowGuid;
 
     std::string IP_str = GetRemoteAddress();
     sLog->outDebug(LOG_FILTER_UNITS, "Account: %d (IP: %s), Character guid: %u Change Race/Faction to: %s", GetAccountId(), IP_str.c_str(), lowGuid, newname.c_str());
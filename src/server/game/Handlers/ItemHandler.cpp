@@ -1153,7 +1153,7 @@ void WorldSession::HandleWrapItemOpcode(WorldPacket& recv_data)
         item->RemoveFromUpdateQueueOf(_player);
         item->SaveToDB(trans);                                   // item gave inventory record unchanged and can be save standalone
     }
-    CharacterDatabase.CommitTransaction(trans);
+    CharacterDatabase.CommitTransaction(trans, _player->GetGUIDLow());
 
     uint32 count = 1;
     _player->DestroyItemCount(gift, count, true);
@@ -298,7 +298,7 @@ void WorldSession::HandleSendMail(WorldPacket & recv_data)
         .SendMailTo(trans, MailReceiver(receive, GUID_LOPART(rc)), MailSender(player), body.empty() ? MAIL_CHECK_MASK_COPIED : MAIL_CHECK_MASK_HAS_BODY, deliver_delay);
 
     player->SaveInventoryAndGoldToDB(trans);
-    CharacterDatabase.CommitTransaction(trans);
+    CharacterDatabase.CommitTransaction(trans, player->GetGUIDLow(), GUID_LOPART(rc));
 }
 
 //called when mail is read
@@ -410,7 +410,7 @@ void WorldSession::HandleMailReturnToSender(WorldPacket & recv_data)
         draft.AddMoney(m->money).SendReturnToSender(GetAccountId(), m->receiver, m->sender, trans);
     }
 
-    CharacterDatabase.CommitTransaction(trans);
+    CharacterDatabase.CommitTransaction(trans, player->GetGUIDLow(), m->sender);
 
     delete m;                                               //we can deallocate old mail
     player->SendMailResult(mailId, MAIL_RETURNED_TO_SENDER, MAIL_OK);
@@ -504,7 +504,7 @@ void WorldSession::HandleMailTakeItem(WorldPacket & recv_data)
 
         player->SaveInventoryAndGoldToDB(trans);
         player->_SaveMail(trans);
-        CharacterDatabase.CommitTransaction(trans);
+        CharacterDatabase.CommitTransaction(trans, player->GetGUIDLow(), m->sender);
 
         player->SendMailResult(mailId, MAIL_ITEM_TAKEN, MAIL_OK, 0, itemId, count);
     }
@@ -542,7 +542,7 @@ void WorldSession::HandleMailTakeMoney(WorldPacket & recv_data)
     SQLTransaction trans = CharacterDatabase.BeginTransaction();
     player->SaveGoldToDB(trans);
     player->_SaveMail(trans);
-    CharacterDatabase.CommitTransaction(trans);
+    CharacterDatabase.CommitTransaction(trans, player->GetGUIDLow());
 }
 
 //called when player lists his received mails
@@ -246,9 +246,8 @@ void WorldSession::HandleWhoOpcode(WorldPacket & recv_data)
     data << uint32(matchcount);                           // placeholder, count of players matching criteria
     data << uint32(displaycount);                         // placeholder, count of players displayed
 
-    TRINITY_READ_GUARD(HashMapHolder<Player>::LockType, *HashMapHolder<Player>::GetLock());
-    HashMapHolder<Player>::MapType const& m = sObjectAccessor->GetPlayers();
-    for (HashMapHolder<Player>::MapType::const_iterator itr = m.begin(); itr != m.end(); ++itr)
+    HashMapHolder<Player>::ReadGuard guard;
+    for (HashMapHolder<Player>::const_iterator itr = HashMapHolder<Player>::begin(); itr != HashMapHolder<Player>::end(); ++itr)
     {
         if (AccountMgr::IsPlayerAccount(security))
         {
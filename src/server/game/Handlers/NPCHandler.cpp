@@ -477,7 +477,7 @@ void WorldSession::SendBindPoint(Creature* npc)
     stmt->setFloat (3, _player->GetPositionY());
     stmt->setFloat (4, _player->GetPositionZ());
     stmt->setUInt32(5, _player->GetGUIDLow());
-    CharacterDatabase.Execute(stmt);
+    CharacterDatabase.Execute(stmt, _player->GetGUIDLow());
 
     _player->m_homebindMapId = _player->GetMapId();
     _player->m_homebindAreaId = _player->GetAreaId();
@@ -526,7 +526,7 @@ void WorldSession::SendStablePet(uint64 guid)
     stmt->setUInt8(2, PET_SAVE_LAST_STABLE_SLOT);
 
     _sendStabledPetCallback.SetParam(guid);
-    _sendStabledPetCallback.SetFutureResult(CharacterDatabase.AsyncQuery(stmt));
+    _sendStabledPetCallback.SetFutureResult(CharacterDatabase.AsyncQuery(stmt, _player->GetGUIDLow()));
 }
 
 void WorldSession::SendStablePetCallback(PreparedQueryResult result, uint64 guid)
@@ -627,7 +627,7 @@ void WorldSession::HandleStablePet(WorldPacket & recv_data)
     stmt->setUInt8(1, PET_SAVE_FIRST_STABLE_SLOT);
     stmt->setUInt8(2, PET_SAVE_LAST_STABLE_SLOT);
 
-    _stablePetCallback = CharacterDatabase.AsyncQuery(stmt);
+    _stablePetCallback = CharacterDatabase.AsyncQuery(stmt, _player->GetGUIDLow());
 }
 
 void WorldSession::HandleStablePetCallback(PreparedQueryResult result)
@@ -690,7 +690,7 @@ void WorldSession::HandleUnstablePet(WorldPacket & recv_data)
     stmt->setUInt8(3, PET_SAVE_LAST_STABLE_SLOT);
 
     _unstablePetCallback.SetParam(petnumber);
-    _unstablePetCallback.SetFutureResult(CharacterDatabase.AsyncQuery(stmt));
+    _unstablePetCallback.SetFutureResult(CharacterDatabase.AsyncQuery(stmt, _player->GetGUIDLow()));
 }
 
 void WorldSession::HandleUnstablePetCallback(PreparedQueryResult result, uint32 petId)
@@ -817,7 +817,7 @@ void WorldSession::HandleStableSwapPet(WorldPacket & recv_data)
     stmt->setUInt32(1, petId);
 
     _stableSwapCallback.SetParam(petId);
-    _stableSwapCallback.SetFutureResult(CharacterDatabase.AsyncQuery(stmt));
+    _stableSwapCallback.SetFutureResult(CharacterDatabase.AsyncQuery(stmt, _player->GetGUIDLow()));
 }
 
 void WorldSession::HandleStableSwapPetCallback(PreparedQueryResult result, uint32 petId)
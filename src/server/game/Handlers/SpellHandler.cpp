@@ -263,7 +263,7 @@ void WorldSession::HandleOpenItemOpcode(WorldPacket& recvPacket)
 
         stmt->setUInt32(0, item->GetGUIDLow());
 
-        CharacterDatabase.Execute(stmt);
+        CharacterDatabase.Execute(stmt, pUser->GetGUIDLow());
     }
     else
         pUser->SendLoot(item->GetGUID(), LOOT_CORPSE);
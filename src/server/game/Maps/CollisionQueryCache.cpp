@@ -0,0 +1,246 @@
+/*
+ * Copyright (C) 2008-2012 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "CollisionQueryCache.h"
+#include "Common.h"
+#include "GridDefines.h"
+
+#include <cmath>
+
+bool CollisionQueryCache::QueryKey::operator==(QueryKey const& right) const
+{
+    for (uint8 i = 0; i < 6; ++i)
+        if (Coords[i] != right.Coords[i])
+            return false;
+
+    return PhaseMask == right.PhaseMask && Flags == right.Flags;
+}
+
+uint64 CollisionQueryCache::QueryKey::GetHash() const
+{
+    // FNV-1a over the words of the key
+    uint64 hash = UI64LIT(14695981039346656037);
+    for (uint8 i = 0; i < 6; ++i)
+        hash = (hash ^ uint32(Coords[i])) * UI64LIT(1099511628211);
+
+    hash = (hash ^ PhaseMask) * UI64LIT(1099511628211);
+    hash = (hash ^ Flags) * UI64LIT(1099511628211);
+    return hash;
+}
+
+CollisionQueryCache::CachedResult const* CollisionQueryCache::ResultList::Find(QueryKey const& key)
+{
+    EntryIndex::iterator itr = _index.find(key.GetHash());
+    if (itr == _index.end() || !(itr->second->first == key))
+        return NULL;
+
+    // move to the front, the iterators stay valid
+    _entries.splice(_entries.begin(), _entries, itr->second);
+    return &itr->second->second;
+}
+
+void CollisionQueryCache::ResultList::Store(QueryKey const& key, CachedResult const& result, uint32 capacity)
+{
+    uint64 hash = key.GetHash();
+
+    EntryIndex::iterator itr = _index.find(hash);
+    if (itr != _index.end())
+    {
+        itr->second->first = key;
+        itr->second->second = result;
+        _entries.splice(_entries.begin(), _entries, itr->second);
+        return;
+    }
+
+    if (_size >= capacity)
+    {
+        _index.erase(_entries.back().first.GetHash());
+        _entries.pop_back();
+        --_size;
+    }
+
+    _entries.push_front(std::make_pair(key, result));
+    _index[hash] = _entries.begin();
+    ++_size;
+}
+
+void CollisionQueryCache::ResultList::Remove(QueryKey const& key)
+{
+    EntryIndex::iterator itr = _index.find(key.GetHash());
+    if (itr == _index.end())
+        return;
+
+    _entries.erase(itr->second);
+    _index.erase(itr);
+    --_size;
+}
+
+CollisionQueryCache::CollisionQueryCache(uint32 capacity) : _capacity(capacity), _generation(0), _hits(0), _misses(0)
+{
+}
+
+int32 CollisionQueryCache::Round(float value)
+{
+    return int32(floor(value * QUERY_STEPS_PER_YARD));
+}
+
+int32 CollisionQueryCache::GetCell(float value)
+{
+    return int32(floor(value / SIZE_OF_GRID_CELL));
+}
+
+uint64 CollisionQueryCache::MakeCellKey(int32 cellX, int32 cellY)
+{
+    return uint64(uint32(cellX)) << 32 | uint32(cellY);
+}
+
+CollisionQueryCache::QueryKey CollisionQueryCache::MakeLineOfSightKey(float x1, float y1, float z1, float x2, float y2, float z2, uint32 phasemask)
+{
+    QueryKey key;
+    key.Coords[0] = Round(x1);
+    key.Coords[1] = Round(y1);
+    key.Coords[2] = Round(z1);
+    key.Coords[3] = Round(x2);
+    key.Coords[4] = Round(y2);
+    key.Coords[5] = Round(z2);
+    key.PhaseMask = phasemask;
+    key.Flags = 0;
+    key.Cells[0] = GetCell(std::min(x1, x2));
+    key.Cells[1] = GetCell(std::min(y1, y2));
+    key.Cells[2] = GetCell(std::max(x1, x2));
+    key.Cells[3] = GetCell(std::max(y1, y2));
+    return key;
+}
+
+CollisionQueryCache::QueryKey CollisionQueryCache::MakeHeightKey(uint32 phasemask, float x, float y, float z, bool vmap, float maxSearchDist)
+{
+    QueryKey key;
+    key.Coords[0] = Round(x);
+    key.Coords[1] = Round(y);
+    key.Coords[2] = Round(z);
+    key.Coords[3] = 0;
+    key.Coords[4] = 0;
+    key.Coords[5] = 0;
+    key.PhaseMask = phasemask;
+    key.Flags = (uint32(Round(maxSearchDist)) << 1) | (vmap ? 1 : 0);
+    // heights are searched straight down, only the cell of the position matters
+    key.Cells[0] = key.Cells[2] = GetCell(x);
+    key.Cells[1] = key.Cells[3] = GetCell(y);
+    return key;
+}
+
+bool CollisionQueryCache::IsValid(QueryKey const& key, CachedResult const& result) const
+{
+    // nothing was invalidated since the result was computed
+    if (result.Generation == _generation)
+        return true;
+
+    for (int32 x = key.Cells[0]; x <= key.Cells[2]; ++x)
+    {
+        for (int32 y = key.Cells[1]; y <= key.Cells[3]; ++y)
+        {
+            CellGenerationMap::const_iterator itr = _invalidatedCells.find(MakeCellKey(x, y));
+            if (itr != _invalidatedCells.end() && itr->second > result.Generation)
+                return false;
+        }
+    }
+
+    return true;
+}
+
+CollisionQueryCache::CachedResult const* CollisionQueryCache::Find(ResultList& results, QueryKey const& key)
+{
+    CachedResult const* result = results.Find(key);
+    if (result && !IsValid(key, *result))
+    {
+        results.Remove(key);
+        result = NULL;
+    }
+
+    if (result)
+        ++_hits;
+    else
+        ++_misses;
+
+    return result;
+}
+
+bool CollisionQueryCache::FindLineOfSight(float x1, float y1, float z1, float x2, float y2, float z2, uint32 phasemask, bool& result, uint32& generation)
+{
+    if (!IsEnabled())
+        return false;
+
+    generation = _generation;
+    CachedResult const* cached = Find(_lineOfSight, MakeLineOfSightKey(x1, y1, z1, x2, y2, z2, phasemask));
+    if (!cached)
+        return false;
+
+    result = cached->Value != 0.0f;
+    return true;
+}
+
+void CollisionQueryCache::StoreLineOfSight(float x1, float y1, float z1, float x2, float y2, float z2, uint32 phasemask, bool result, uint32 generation)
+{
+    if (!IsEnabled())
+        return;
+
+    QueryKey key = MakeLineOfSightKey(x1, y1, z1, x2, y2, z2, phasemask);
+    if (key.Cells[2] - key.Cells[0] >= MAX_QUERY_CELLS || key.Cells[3] - key.Cells[1] >= MAX_QUERY_CELLS)
+        return;
+
+    CachedResult cached;
+    cached.Value = result ? 1.0f : 0.0f;
+    cached.Generation = generation;
+    _lineOfSight.Store(key, cached, _capacity);
+}
+
+bool CollisionQueryCache::FindHeight(uint32 phasemask, float x, float y, float z, bool vmap, float maxSearchDist, float& height, uint32& generation)
+{
+    if (!IsEnabled())
+        return false;
+
+    generation = _generation;
+    CachedResult const* cached = Find(_heights, MakeHeightKey(phasemask, x, y, z, vmap, maxSearchDist));
+    if (!cached)
+        return false;
+
+    height = cached->Value;
+    return true;
+}
+
+void CollisionQueryCache::StoreHeight(uint32 phasemask, float x, float y, float z, bool vmap, float maxSearchDist, float height, uint32 generation)
+{
+    if (!IsEnabled())
+        return;
+
+    CachedResult cached;
+    cached.Value = height;
+    cached.Generation = generation;
+    _heights.Store(MakeHeightKey(phasemask, x, y, z, vmap, maxSearchDist), cached, _capacity);
+}
+
+void CollisionQueryCache::Invalidate(float minX, float minY, float maxX, float maxY)
+{
+    if (!IsEnabled())
+        return;
+
+    // results are dropped lazily on their next lookup, a yard more covers rounding at the cell borders
+    ++_generation;
+    for (int32 x = GetCell(minX - 1.0f); x <= GetCell(maxX + 1.0f); ++x)
+        for (int32 y = GetCell(minY - 1.0f); y <= GetCell(maxY + 1.0f); ++y)
+            _invalidatedCells[MakeCellKey(x, y)] = _generation;
+}
@@ -0,0 +1,120 @@
+/*
+ * Copyright (C) 2008-2012 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_COLLISIONQUERYCACHE_H
+#define TRINITY_COLLISIONQUERYCACHE_H
+
+#include "Define.h"
+#include "UnorderedMap.h"
+
+#include <list>
+
+// Remembers the last line of sight and height answers of a map, so that units asking again for nearly the same
+// positions do not traverse the collision trees every time. Positions are rounded to 1 / QUERY_STEPS_PER_YARD
+// yards, a query is answered with the result of the first query in the same rounded position.
+// Results include game object models, the map invalidates the area of a game object model whenever it is
+// inserted, removed or its collision changes, and the area of a grid whenever its terrain is loaded or unloaded.
+// Only the results of queries touching a grid cell of that area are dropped. Must only be used by the thread
+// updating the map, like the map itself.
+class CollisionQueryCache
+{
+    public:
+        enum
+        {
+            QUERY_STEPS_PER_YARD    = 4,                    // positions are rounded to 1 / QUERY_STEPS_PER_YARD yards
+            MAX_QUERY_CELLS         = 4                     // line of sight spanning more grid cells per axis is not cached
+        };
+
+        // capacity is the number of line of sight and the number of height results kept, 0 disables the cache
+        explicit CollisionQueryCache(uint32 capacity);
+
+        // The Find functions return true and set the result if it is cached, otherwise they store the current
+        // generation of the cache which must be passed to the Store function together with the computed result.
+        // A result is dropped on its next lookup if its area was invalidated after that generation.
+        bool FindLineOfSight(float x1, float y1, float z1, float x2, float y2, float z2, uint32 phasemask, bool& result, uint32& generation);
+        void StoreLineOfSight(float x1, float y1, float z1, float x2, float y2, float z2, uint32 phasemask, bool result, uint32 generation);
+
+        bool FindHeight(uint32 phasemask, float x, float y, float z, bool vmap, float maxSearchDist, float& height, uint32& generation);
+        void StoreHeight(uint32 phasemask, float x, float y, float z, bool vmap, float maxSearchDist, float height, uint32 generation);
+
+        // drops the results of all queries touching the grid cells of the area, in world coordinates
+        void Invalidate(float minX, float minY, float maxX, float maxY);
+
+        bool IsEnabled() const { return _capacity != 0; }
+        uint64 GetHits() const { return _hits; }
+        uint64 GetMisses() const { return _misses; }
+        void ResetStats() { _hits = 0; _misses = 0; }
+
+    private:
+        struct QueryKey
+        {
+            int32 Coords[6];
+            uint32 PhaseMask;
+            uint32 Flags;
+            int32 Cells[4];                                 // grid cells touched by the query (min x, min y, max x, max y), not part of the key
+
+            bool operator==(QueryKey const& right) const;
+            uint64 GetHash() const;
+        };
+
+        struct CachedResult
+        {
+            float Value;
+            uint32 Generation;                              // generation of the cache when the query missed
+        };
+
+        // least recently used results are dropped first, the index is keyed by the hash of the key;
+        // a query whose hash matches a different key is a miss and replaces the older result
+        class ResultList
+        {
+            public:
+                ResultList() : _size(0) { }
+
+                CachedResult const* Find(QueryKey const& key);
+                void Store(QueryKey const& key, CachedResult const& result, uint32 capacity);
+                void Remove(QueryKey const& key);
+
+            private:
+                typedef std::list<std::pair<QueryKey, CachedResult> > EntryList;
+                typedef UNORDERED_MAP<uint64, EntryList::iterator> EntryIndex;
+
+                EntryList _entries;                         // most recently used first
+                EntryIndex _index;
+                uint32 _size;                               // std::list::size is linear on older compilers
+        };
+
+        typedef UNORDERED_MAP<uint64, uint32> CellGenerationMap;
+
+        static int32 Round(float value);
+        static int32 GetCell(float value);
+        static uint64 MakeCellKey(int32 cellX, int32 cellY);
+        static QueryKey MakeLineOfSightKey(float x1, float y1, float z1, float x2, float y2, float z2, uint32 phasemask);
+        static QueryKey MakeHeightKey(uint32 phasemask, float x, float y, float z, bool vmap, float maxSearchDist);
+
+        bool IsValid(QueryKey const& key, CachedResult const& result) const;
+        CachedResult const* Find(ResultList& results, QueryKey const& key);
+
+        ResultList _lineOfSight;
+        ResultList _heights;
+        CellGenerationMap _invalidatedCells;                // generation of the last invalidation of a grid cell
+        uint32 _capacity;
+        uint32 _generation;                                 // increased by every invalidation
+        uint64 _hits;
+        uint64 _misses;
+};
+
+#endif
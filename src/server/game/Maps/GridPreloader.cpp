@@ -0,0 +1,250 @@
+/*
+ * Copyright (C) 2008-2012 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "GridPreloader.h"
+#include "Map.h"
+#include "World.h"
+#include "VMapFactory.h"
+#include "VMapDefinitions.h"
+#include "MapTree.h"
+#include "ModelInstance.h"
+
+#include <ace/Guard_T.h>
+
+#include <set>
+
+GridPreloader::GridPreloader() : m_mutex(), m_condition(m_mutex), m_activated(false), m_stopping(false)
+{
+}
+
+GridPreloader::~GridPreloader()
+{
+    deactivate();
+}
+
+int GridPreloader::activate(size_t num_threads)
+{
+    if (activated() || num_threads < 1)
+        return -1;
+
+    m_stopping = false;
+
+    if (ACE_Task_Base::activate(THR_NEW_LWP | THR_JOINABLE | THR_INHERIT_SCHED, int(num_threads)) == -1)
+        return -1;
+
+    m_activated = true;
+    return 0;
+}
+
+int GridPreloader::deactivate()
+{
+    if (!activated())
+        return -1;
+
+    {
+        TRINITY_GUARD(ACE_Thread_Mutex, m_mutex);
+        m_stopping = true;
+        m_condition.broadcast();
+    }
+
+    ACE_Task_Base::wait();
+
+    m_activated = false;
+    m_queue.clear();
+
+    for (PreloadMap::iterator itr = m_entries.begin(); itr != m_entries.end(); ++itr)
+        delete itr->second.Grid;
+
+    m_entries.clear();
+    return 0;
+}
+
+bool GridPreloader::activated()
+{
+    return m_activated;
+}
+
+void GridPreloader::Request(uint32 mapId, uint32 gx, uint32 gy)
+{
+    if (!activated())
+        return;
+
+    uint32 key = MakeKey(mapId, gx, gy);
+
+    TRINITY_GUARD(ACE_Thread_Mutex, m_mutex);
+
+    if (m_entries.find(key) != m_entries.end())
+        return;
+
+    RemoveExpired();
+
+    if (m_entries.size() >= MAX_PRELOADED_GRIDS)
+        return;
+
+    m_entries[key] = PreloadEntry();
+    m_queue.push_back(key);
+    m_condition.signal();
+}
+
+GridMap* GridPreloader::Take(uint32 mapId, uint32 gx, uint32 gy)
+{
+    if (!activated())
+        return NULL;
+
+    TRINITY_GUARD(ACE_Thread_Mutex, m_mutex);
+
+    PreloadMap::iterator itr = m_entries.find(MakeKey(mapId, gx, gy));
+    if (itr == m_entries.end())
+        return NULL;
+
+    // a queued request is skipped by the workers and the result of a running load is freed once it finishes
+    GridMap* grid = itr->second.State == PRELOAD_READY ? itr->second.Grid : NULL;
+    m_entries.erase(itr);
+    return grid;
+}
+
+void GridPreloader::RemoveExpired()
+{
+    time_t now = time(NULL);
+
+    for (PreloadMap::iterator itr = m_entries.begin(); itr != m_entries.end();)
+    {
+        if (itr->second.State == PRELOAD_READY && itr->second.ReadyTime + READY_GRID_EXPIRY <= now)
+        {
+            delete itr->second.Grid;
+            m_entries.erase(itr++);
+        }
+        else
+            ++itr;
+    }
+}
+
+int GridPreloader::svc()
+{
+    for (;;)
+    {
+        uint32 key;
+
+        {
+            TRINITY_GUARD(ACE_Thread_Mutex, m_mutex);
+
+            while (m_queue.empty() && !m_stopping)
+                m_condition.wait();
+
+            if (m_stopping)
+                return 0;
+
+            key = m_queue.front();
+            m_queue.pop_front();
+
+            // taken by its map before a worker got to it
+            PreloadMap::iterator itr = m_entries.find(key);
+            if (itr == m_entries.end())
+                continue;
+
+            itr->second.State = PRELOAD_LOADING;
+        }
+
+        uint32 mapId = key >> 12;
+        uint32 gx = (key >> 6) & 0x3F;
+        uint32 gy = key & 0x3F;
+
+        GridMap* grid = LoadGridMap(mapId, gx, gy);
+        WarmVMapTile(mapId, gx, gy);
+
+        TRINITY_GUARD(ACE_Thread_Mutex, m_mutex);
+
+        PreloadMap::iterator itr = m_entries.find(key);
+        if (itr != m_entries.end() && itr->second.State == PRELOAD_LOADING)
+        {
+            itr->second.State = PRELOAD_READY;
+            itr->second.Grid = grid;
+            itr->second.ReadyTime = time(NULL);
+        }
+        else
+            delete grid;
+    }
+}
+
+GridMap* GridPreloader::LoadGridMap(uint32 mapId, uint32 gx, uint32 gy)
+{
+    char fileName[32];
+    snprintf(fileName, sizeof(fileName), "%03u%02u%02u.map", mapId, gx, gy);
+
+    std::string path = sWorld->GetDataPath() + "maps/" + fileName;
+
+    // the grid map reads the mapped file in place, the map thread must not wait for its pages
+    WarmFile(path);
+
+    GridMap* grid = new GridMap();
+    if (!grid->loadData(const_cast<char*>(path.c_str())))
+    {
+        // left to Map::LoadMap, which reports the error
+        delete grid;
+        return NULL;
+    }
+
+    return grid;
+}
+
+void GridPreloader::WarmVMapTile(uint32 mapId, uint32 gx, uint32 gy)
+{
+    if (!VMAP::VMapFactory::createOrGetVMapManager()->isMapLoadingEnabled())
+        return;
+
+    // the tile is added to the map tree by the map thread (Map::LoadVMap), reading the tile and model files
+    // here only makes sure that it does not have to wait for the disk
+    std::string basePath = sWorld->GetDataPath() + "vmaps/";
+    std::string tileFile = basePath + VMAP::StaticMapTree::getTileFileName(mapId, gx, gy);
+
+    FILE* tf = fopen(tileFile.c_str(), "rb");
+    if (!tf)
+        return;
+
+    char chunk[8];
+    uint32 numSpawns = 0;
+    if (fread(chunk, sizeof(chunk), 1, tf) == 1 && !memcmp(chunk, VMAP::VMAP_MAGIC, sizeof(chunk)) &&
+        fread(&numSpawns, sizeof(uint32), 1, tf) == 1)
+    {
+        std::set<std::string> models;
+        for (uint32 i = 0; i < numSpawns; ++i)
+        {
+            VMAP::ModelSpawn spawn;
+            uint32 referencedVal;
+            if (!VMAP::ModelSpawn::readFromFile(tf, spawn) || fread(&referencedVal, sizeof(uint32), 1, tf) != 1)
+                break;
+
+            if (models.insert(spawn.name).second)
+                WarmFile(basePath + spawn.name + ".vmo");
+        }
+    }
+
+    fclose(tf);
+}
+
+void GridPreloader::WarmFile(std::string const& fileName)
+{
+    FILE* file = fopen(fileName.c_str(), "rb");
+    if (!file)
+        return;
+
+    char buffer[16 * 1024];
+    while (fread(buffer, 1, sizeof(buffer), file) == sizeof(buffer))
+        ;
+
+    fclose(file);
+}
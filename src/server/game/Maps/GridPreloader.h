@@ -0,0 +1,97 @@
+/*
+ * Copyright (C) 2008-2012 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_GRIDPRELOADER_H
+#define TRINITY_GRIDPRELOADER_H
+
+#include "Common.h"
+
+#include <ace/Task.h>
+#include <ace/Thread_Mutex.h>
+#include <ace/Condition_Thread_Mutex.h>
+
+#include <deque>
+#include <map>
+#include <string>
+
+class GridMap;
+
+// Loads the terrain of grids players are about to enter on background threads.
+// Maps request grids ahead of moving players, the workers pull the .map file, the vmap tile and its model
+// files into the file system cache and map the .map file into a GridMap. Map::LoadMap takes a ready GridMap
+// instead of loading the file when the grid is created; objects are still loaded by the map itself.
+class GridPreloader : protected ACE_Task_Base
+{
+    public:
+        enum
+        {
+            MAX_PRELOADED_GRIDS = 64,                       // queued, loading and ready grids together, further requests are dropped
+            READY_GRID_EXPIRY   = 5 * MINUTE                // seconds a ready grid waits for its map before it is freed
+        };
+
+        GridPreloader();
+        virtual ~GridPreloader();
+
+        int activate(size_t num_threads);
+        int deactivate();
+        bool activated();
+
+        // queues grid (gx, gy) of the map, gx and gy are the coordinates of the .map file; safe from any map thread
+        void Request(uint32 mapId, uint32 gx, uint32 gy);
+
+        // hands the preloaded terrain of the grid over to the caller, NULL if the grid was not requested or is not
+        // loaded yet - the pending request is dropped then, the caller loads the grid itself
+        GridMap* Take(uint32 mapId, uint32 gx, uint32 gy);
+
+        virtual int svc();
+
+    private:
+        enum PreloadState
+        {
+            PRELOAD_QUEUED,
+            PRELOAD_LOADING,
+            PRELOAD_READY
+        };
+
+        struct PreloadEntry
+        {
+            PreloadEntry() : State(PRELOAD_QUEUED), Grid(NULL), ReadyTime(0) { }
+
+            PreloadState State;
+            GridMap* Grid;
+            time_t ReadyTime;
+        };
+
+        typedef std::map<uint32, PreloadEntry> PreloadMap;
+
+        static uint32 MakeKey(uint32 mapId, uint32 gx, uint32 gy) { return (mapId << 12) | (gx << 6) | gy; }
+
+        static GridMap* LoadGridMap(uint32 mapId, uint32 gx, uint32 gy);
+        static void WarmVMapTile(uint32 mapId, uint32 gx, uint32 gy);
+        static void WarmFile(std::string const& fileName);
+
+        void RemoveExpired();                               // m_mutex must be held
+
+        ACE_Thread_Mutex m_mutex;
+        ACE_Condition_Thread_Mutex m_condition;             // signaled when requests are queued or the workers stop
+        std::deque<uint32> m_queue;
+        PreloadMap m_entries;
+        bool m_activated;
+        bool m_stopping;
+};
+
+#endif
@@ -33,6 +33,9 @@
 #include "LFGMgr.h"
 #include "DynamicTree.h"
 #include "Vehicle.h"
+#include "TickProfiler.h"
+
+#include <ace/Mem_Map.h>
 
 union u_map_magic
 {
@@ -69,6 +72,10 @@ Map::~Map()
 
     if (!m_scriptSchedule.empty())
         sScriptMgr->DecreaseScheduledScriptCount(m_scriptSchedule.size());
+
+    if (uint64 queries = _collisionCache.GetHits() + _collisionCache.GetMisses())
+        sLog->outDetail("Map %u (instance %u) answered " UI64FMTD " of " UI64FMTD " line of sight and height queries from its collision cache.",
+            GetId(), GetInstanceId(), _collisionCache.GetHits(), queries);
 }
 
 bool Map::ExistMap(uint32 mapid, int gx, int gy)
@@ -133,6 +140,8 @@ void Map::LoadVMap(int gx, int gy)
             sLog->outStaticDebug("Ignored VMAP name:%s, id:%d, x:%d, y:%d (vmap rep.: x:%d, y:%d)", GetMapName(), GetId(), gx, gy, gx, gy);
             break;
     }
+
+    InvalidateCollisionCache(gx, gy);
 }
 
 void Map::LoadMap(int gx, int gy, bool reload)
@@ -148,6 +157,7 @@ void Map::LoadMap(int gx, int gy, bool reload)
 
         ((MapInstanced*)(m_parentMap))->AddGridMapReference(GridCoord(gx, gy));
         GridMaps[gx][gy] = m_parentMap->GridMaps[gx][gy];
+        InvalidateCollisionCache(gx, gy);
         return;
     }
 
@@ -164,21 +174,39 @@ void Map::LoadMap(int gx, int gy, bool reload)
         GridMaps[gx][gy]=NULL;
     }
 
-    // map file name
-    char *tmp=NULL;
-    int len = sWorld->GetDataPath().length()+strlen("maps/%03u%02u%02u.map")+1;
-    tmp = new char[len];
-    snprintf(tmp, len, (char *)(sWorld->GetDataPath()+"maps/%03u%02u%02u.map").c_str(), GetId(), gx, gy);
-    sLog->outDetail("Loading map %s", tmp);
-    // loading data
-    GridMaps[gx][gy] = new GridMap();
-    if (!GridMaps[gx][gy]->loadData(tmp))
+    // terrain read ahead of a moving player, a reload always reads the file again
+    if (GridMap* preloaded = reload ? NULL : sMapMgr->GetGridPreloader()->Take(GetId(), gx, gy))
     {
-        sLog->outError("Error loading map file: \n %s\n", tmp);
+        sLog->outDetail("Using preloaded map %03u%02u%02u.map", GetId(), gx, gy);
+        GridMaps[gx][gy] = preloaded;
+    }
+    else
+    {
+        // map file name
+        char *tmp=NULL;
+        int len = sWorld->GetDataPath().length()+strlen("maps/%03u%02u%02u.map")+1;
+        tmp = new char[len];
+        snprintf(tmp, len, (char *)(sWorld->GetDataPath()+"maps/%03u%02u%02u.map").c_str(), GetId(), gx, gy);
+        sLog->outDetail("Loading map %s", tmp);
+        // loading data
+        GridMaps[gx][gy] = new GridMap();
+        if (!GridMaps[gx][gy]->loadData(tmp))
+        {
+            sLog->outError("Error loading map file: \n %s\n", tmp);
+        }
+        delete [] tmp;
     }
-    delete [] tmp;
 
     sScriptMgr->OnLoadGridMap(this, GridMaps[gx][gy], gx, gy);
+    InvalidateCollisionCache(gx, gy);
+}
+
+void Map::InvalidateCollisionCache(int gx, int gy) const
+{
+    // grid gx covers x from (CENTER_GRID_ID - gx - 1) to (CENTER_GRID_ID - gx) grid sizes, see GetGrid
+    float maxX = (CENTER_GRID_ID - gx) * SIZE_OF_GRIDS;
+    float maxY = (CENTER_GRID_ID - gy) * SIZE_OF_GRIDS;
+    _collisionCache.Invalidate(maxX - SIZE_OF_GRIDS, maxY - SIZE_OF_GRIDS, maxX, maxY);
 }
 
 void Map::LoadMapAndVMap(int gx, int gy)
@@ -208,6 +236,7 @@ Map::Map(uint32 id, time_t expiry, uint32 InstanceId, uint8 SpawnMode, Map* _par
 _creatureToMoveLock(false), _gameObjectsToMoveLock(false),
 i_mapEntry(sMapStore.LookupEntry(id)), i_spawnMode(SpawnMode), i_InstanceId(InstanceId),
 m_unloadTimer(0), m_VisibleDistance(DEFAULT_VISIBILITY_DISTANCE),
+_collisionCache(sWorld->getIntConfig(CONFIG_COLLISION_QUERY_CACHE_SIZE)),
 m_VisibilityNotifyPeriod(DEFAULT_VISIBILITY_NOTIFY_PERIOD),
 m_activeNonPlayersIter(m_activeNonPlayers.end()), _transportsUpdateIter(_transports.end()),
 i_gridExpiry(expiry),
@@ -357,7 +386,6 @@ template<>
 void Map::DeleteFromWorld(Player* player)
 {
     sObjectAccessor->RemoveObject(player);
-    sObjectAccessor->RemoveUpdateObject(player); //TODO: I do not know why we need this, it should be removed in ~Object anyway
     delete player;
 }
 
@@ -582,17 +610,24 @@ void Map::VisitNearbyCellsOf(WorldObject* obj, TypeContainerVisitor<Trinity::Obj
 
 void Map::Update(const uint32 t_diff)
 {
-    _dynamicTree.update(t_diff);
+    {
+        ProfileScope profile(PROFILE_MAP_PHASE, "DynamicTree", GetId());
+        _dynamicTree.update(t_diff);
+    }
+
     /// update worldsessions for existing players
-    for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
     {
-        Player* player = m_mapRefIter->getSource();
-        if (player && player->IsInWorld())
+        ProfileScope profile(PROFILE_MAP_PHASE, "Sessions", GetId());
+        for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
         {
-            //player->Update(t_diff);
-            WorldSession* session = player->GetSession();
-            MapSessionFilter updater(session);
-            session->Update(t_diff, updater);
+            Player* player = m_mapRefIter->getSource();
+            if (player && player->IsInWorld())
+            {
+                //player->Update(t_diff);
+                WorldSession* session = player->GetSession();
+                MapSessionFilter updater(session);
+                session->Update(t_diff, updater);
+            }
         }
     }
     /// update active cells around players and active objects
@@ -604,31 +639,34 @@ void Map::Update(const uint32 t_diff)
     // for pets
     TypeContainerVisitor<Trinity::ObjectUpdater, WorldTypeMapContainer > world_object_update(updater);
 
-    // the player iterator is stored in the map object
-    // to make sure calls to Map::Remove don't invalidate it
-    for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
     {
-        Player* player = m_mapRefIter->getSource();
+        ProfileScope profile(PROFILE_MAP_PHASE, "Objects", GetId());
+        // the player iterator is stored in the map object
+        // to make sure calls to Map::Remove don't invalidate it
+        for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
+        {
+            Player* player = m_mapRefIter->getSource();
 
-        if (!player || !player->IsInWorld())
-            continue;
+            if (!player || !player->IsInWorld())
+                continue;
 
-        // update players at tick
-        player->Update(t_diff);
+            // update players at tick
+            player->Update(t_diff);
 
-        VisitNearbyCellsOf(player, grid_object_update, world_object_update);
-    }
+            VisitNearbyCellsOf(player, grid_object_update, world_object_update);
+        }
 
-    // non-player active objects, increasing iterator in the loop in case of object removal
-    for (m_activeNonPlayersIter = m_activeNonPlayers.begin(); m_activeNonPlayersIter != m_activeNonPlayers.end();)
-    {
-        WorldObject* obj = *m_activeNonPlayersIter;
-        ++m_activeNonPlayersIter;
+        // non-player active objects, increasing iterator in the loop in case of object removal
+        for (m_activeNonPlayersIter = m_activeNonPlayers.begin(); m_activeNonPlayersIter != m_activeNonPlayers.end();)
+        {
+            WorldObject* obj = *m_activeNonPlayersIter;
+            ++m_activeNonPlayersIter;
 
-        if (!obj || !obj->IsInWorld())
-            continue;
+            if (!obj || !obj->IsInWorld())
+                continue;
 
-        VisitNearbyCellsOf(obj, grid_object_update, world_object_update);
+            VisitNearbyCellsOf(obj, grid_object_update, world_object_update);
+        }
     }
 
     for (_transportsUpdateIter = _transports.begin(); _transportsUpdateIter != _transports.end();)
@@ -645,18 +683,70 @@ void Map::Update(const uint32 t_diff)
     ///- Process necessary scripts
     if (!m_scriptSchedule.empty())
     {
+        ProfileScope profile(PROFILE_MAP_PHASE, "ScriptsProcess", GetId());
         i_scriptLock = true;
         ScriptsProcess();
         i_scriptLock = false;
     }
 
-    MoveAllCreaturesInMoveList();
-    MoveAllGameObjectsInMoveList();
+    {
+        ProfileScope profile(PROFILE_MAP_PHASE, "MoveLists", GetId());
+        MoveAllCreaturesInMoveList();
+        MoveAllGameObjectsInMoveList();
+    }
 
     if (!m_mapRefManager.isEmpty() || !m_activeNonPlayers.empty())
+    {
+        ProfileScope profile(PROFILE_MAP_PHASE, "RelocationNotifies", GetId());
         ProcessRelocationNotifies(t_diff);
+    }
 
     sScriptMgr->OnMapUpdate(this, t_diff);
+
+    {
+        ProfileScope profile(PROFILE_MAP_PHASE, "ObjectUpdates", GetId());
+        SendObjectUpdates();
+    }
+}
+
+void Map::AddUpdateObject(Object* obj)
+{
+    TRINITY_GUARD(ACE_Thread_Mutex, _updateObjectsLock);
+    _updateObjects.insert(obj);
+}
+
+void Map::RemoveUpdateObject(Object* obj)
+{
+    TRINITY_GUARD(ACE_Thread_Mutex, _updateObjectsLock);
+    _updateObjects.erase(obj);
+}
+
+void Map::SendObjectUpdates()
+{
+    std::set<Object*> objects;
+    {
+        TRINITY_GUARD(ACE_Thread_Mutex, _updateObjectsLock);
+        objects.swap(_updateObjects);
+    }
+
+    if (objects.empty())
+        return;
+
+    // objects stay marked as queued until BuildUpdate, values changed meanwhile are sent with them
+    UpdateDataMapType update_players;
+    for (std::set<Object*>::const_iterator itr = objects.begin(); itr != objects.end(); ++itr)
+    {
+        ASSERT((*itr)->IsInWorld());
+        (*itr)->BuildUpdate(update_players);
+    }
+
+    WorldPacket packet;                                     // here we allocate a std::vector with a size of 0x10000
+    for (UpdateDataMapType::iterator iter = update_players.begin(); iter != update_players.end(); ++iter)
+    {
+        iter->second.BuildPacket(&packet);
+        iter->first->GetSession()->SendPacket(&packet);
+        packet.clear();                                     // clean the string
+    }
 }
 
 struct ResetNotifier
@@ -845,9 +935,46 @@ void Map::PlayerRelocation(Player* player, float x, float y, float z, float orie
         AddToGrid(player, new_cell);
     }
 
+    // taxi flights preload along their path, see FlightPathMovementGenerator
+    if (player->isMoving() && !player->HasUnitState(UNIT_STATE_IN_FLIGHT))
+        PreloadGridsAhead(player);
+
     player->UpdateObjectVisibility(false);
 }
 
+void Map::PreloadGridsAhead(Player* player)
+{
+    float angle = player->GetOrientation();
+    float speed;
+
+    if (player->HasUnitMovementFlag(MOVEMENTFLAG_FORWARD))
+        speed = player->GetSpeed(player->IsFlying() ? MOVE_FLIGHT : MOVE_RUN);
+    else if (player->HasUnitMovementFlag(MOVEMENTFLAG_BACKWARD))
+    {
+        angle += M_PI;
+        speed = player->GetSpeed(player->IsFlying() ? MOVE_FLIGHT_BACK : MOVE_RUN_BACK);
+    }
+    else
+        return;
+
+    float distance = speed * GRID_PRELOAD_LOOKAHEAD;
+    PreloadGrid(player->GetPositionX() + distance * std::cos(angle), player->GetPositionY() + distance * std::sin(angle));
+}
+
+void Map::PreloadGrid(float x, float y)
+{
+    if (!Trinity::IsValidMapCoord(x, y))
+        return;
+
+    int gx = int(32 - x / SIZE_OF_GRIDS);
+    int gy = int(32 - y / SIZE_OF_GRIDS);
+
+    if (GridMaps[gx][gy])
+        return;
+
+    sMapMgr->GetGridPreloader()->Request(GetId(), gx, gy);
+}
+
 void Map::CreatureRelocation(Creature* creature, float x, float y, float z, float ang, bool respawnRelocationOnFail)
 {
     ASSERT(CheckGridIntegrity(creature, false));
@@ -1304,6 +1431,7 @@ bool Map::UnloadGrid(NGridType& ngrid, bool unloadAll)
             ((MapInstanced*)m_parentMap)->RemoveGridMapReference(GridCoord(gx, gy));
 
         GridMaps[gx][gy] = NULL;
+        InvalidateCollisionCache(gx, gy);
     }
     sLog->outStaticDebug("Unloading grid[%u, %u] for map %u finished", x, y, GetId());
     return true;
@@ -1363,6 +1491,7 @@ GridMap::GridMap()
     _liquidEntry = NULL;
     _liquidFlags = NULL;
     _liquidMap  = NULL;
+    _mapping = NULL;
 }
 
 GridMap::~GridMap()
@@ -1375,57 +1504,66 @@ bool GridMap::loadData(char *filename)
     // Unload old data if exist
     unloadData();
 
-    map_fileheader header;
+    // The file is mapped read-only and shared, the accessors read the arrays in place. Grids are not copied
+    // to the heap and all processes using the same data directory share the pages in the system cache.
+    ACE_Mem_Map* mapping = new ACE_Mem_Map();
     // Not return error if file not found
-    FILE* in = fopen(filename, "rb");
-    if (!in)
+    if (mapping->map(filename, static_cast<size_t>(-1), O_RDONLY, ACE_DEFAULT_FILE_PERMS, PROT_READ, ACE_MAP_SHARED) == -1)
+    {
+        delete mapping;
         return true;
+    }
 
-    if (fread(&header, sizeof(header), 1, in) != 1)
+    // loaded grids only keep the mapping, not one descriptor each
+    mapping->close_handle();
+    _mapping = mapping;
+
+    map_fileheader const* header = getMapped<map_fileheader>(0, 1);
+    if (!header)
     {
-        fclose(in);
+        unloadData();
         return false;
     }
 
-    if (header.mapMagic == MapMagic.asUInt && header.versionMagic == MapVersionMagic.asUInt)
+    if (header->mapMagic == MapMagic.asUInt && header->versionMagic == MapVersionMagic.asUInt)
     {
         // loadup area data
-        if (header.areaMapOffset && !loadAreaData(in, header.areaMapOffset, header.areaMapSize))
+        if (header->areaMapOffset && !loadAreaData(header->areaMapOffset))
         {
             sLog->outError("Error loading map area data\n");
-            fclose(in);
+            unloadData();
             return false;
         }
         // loadup height data
-        if (header.heightMapOffset && !loadHeihgtData(in, header.heightMapOffset, header.heightMapSize))
+        if (header->heightMapOffset && !loadHeihgtData(header->heightMapOffset))
         {
             sLog->outError("Error loading map height data\n");
-            fclose(in);
+            unloadData();
             return false;
         }
         // loadup liquid data
-        if (header.liquidMapOffset && !loadLiquidData(in, header.liquidMapOffset, header.liquidMapSize))
+        if (header->liquidMapOffset && !loadLiquidData(header->liquidMapOffset))
         {
             sLog->outError("Error loading map liquids data\n");
-            fclose(in);
+            unloadData();
             return false;
         }
-        fclose(in);
+
+#ifdef MADV_WILLNEED
+        // start reading the pages in the background instead of faulting them in one by one on first use
+        _mapping->advise(MADV_WILLNEED);
+#endif
         return true;
     }
     sLog->outError("Map file '%s' is from an incompatible clientversion. Please recreate using the mapextractor.", filename);
-    fclose(in);
+    unloadData();
     return false;
 }
 
 void GridMap::unloadData()
 {
-    delete[] _areaMap;
-    delete[] m_V9;
-    delete[] m_V8;
-    delete[] _liquidEntry;
-    delete[] _liquidFlags;
-    delete[] _liquidMap;
+    delete _mapping;
+    _mapping = NULL;
     _areaMap = NULL;
     m_V9 = NULL;
     m_V8 = NULL;
@@ -1435,61 +1573,66 @@ void GridMap::unloadData()
     _gridGetHeight = &GridMap::getHeightFromFlat;
 }
 
-bool GridMap::loadAreaData(FILE* in, uint32 offset, uint32 /*size*/)
+template<class T>
+T const* GridMap::getMapped(uint32 offset, uint32 count) const
 {
-    map_areaHeader header;
-    fseek(in, offset, SEEK_SET);
+    // truncated files must not be read past their end
+    if (size_t(offset) + sizeof(T) * count > _mapping->size())
+        return NULL;
+
+    return reinterpret_cast<T const*>(static_cast<char const*>(_mapping->addr()) + offset);
+}
 
-    if (fread(&header, sizeof(header), 1, in) != 1 || header.fourcc != MapAreaMagic.asUInt)
+bool GridMap::loadAreaData(uint32 offset)
+{
+    map_areaHeader const* header = getMapped<map_areaHeader>(offset, 1);
+    if (!header || header->fourcc != MapAreaMagic.asUInt)
         return false;
 
-    _gridArea = header.gridArea;
-    if (!(header.flags & MAP_AREA_NO_AREA))
+    _gridArea = header->gridArea;
+    if (!(header->flags & MAP_AREA_NO_AREA))
     {
-        _areaMap = new uint16 [16*16];
-        if (fread(_areaMap, sizeof(uint16), 16*16, in) != 16*16)
+        _areaMap = getMapped<uint16>(offset + sizeof(map_areaHeader), 16*16);
+        if (!_areaMap)
             return false;
     }
     return true;
 }
 
-bool GridMap::loadHeihgtData(FILE* in, uint32 offset, uint32 /*size*/)
+bool GridMap::loadHeihgtData(uint32 offset)
 {
-    map_heightHeader header;
-    fseek(in, offset, SEEK_SET);
-
-    if (fread(&header, sizeof(header), 1, in) != 1 || header.fourcc != MapHeightMagic.asUInt)
+    map_heightHeader const* header = getMapped<map_heightHeader>(offset, 1);
+    if (!header || header->fourcc != MapHeightMagic.asUInt)
         return false;
 
-    _gridHeight = header.gridHeight;
-    if (!(header.flags & MAP_HEIGHT_NO_HEIGHT))
+    offset += sizeof(map_heightHeader);
+
+    _gridHeight = header->gridHeight;
+    if (!(header->flags & MAP_HEIGHT_NO_HEIGHT))
     {
-        if ((header.flags & MAP_HEIGHT_AS_INT16))
+        if ((header->flags & MAP_HEIGHT_AS_INT16))
         {
-            m_uint16_V9 = new uint16 [129*129];
-            m_uint16_V8 = new uint16 [128*128];
-            if (fread(m_uint16_V9, sizeof(uint16), 129*129, in) != 129*129 ||
-                fread(m_uint16_V8, sizeof(uint16), 128*128, in) != 128*128)
+            m_uint16_V9 = getMapped<uint16>(offset, 129*129);
+            m_uint16_V8 = getMapped<uint16>(offset + sizeof(uint16) * 129*129, 128*128);
+            if (!m_uint16_V9 || !m_uint16_V8)
                 return false;
-            _gridIntHeightMultiplier = (header.gridMaxHeight - header.gridHeight) / 65535;
+            _gridIntHeightMultiplier = (header->gridMaxHeight - header->gridHeight) / 65535;
             _gridGetHeight = &GridMap::getHeightFromUint16;
         }
-        else if ((header.flags & MAP_HEIGHT_AS_INT8))
+        else if ((header->flags & MAP_HEIGHT_AS_INT8))
         {
-            m_uint8_V9 = new uint8 [129*129];
-            m_uint8_V8 = new uint8 [128*128];
-            if (fread(m_uint8_V9, sizeof(uint8), 129*129, in) != 129*129 ||
-                fread(m_uint8_V8, sizeof(uint8), 128*128, in) != 128*128)
+            m_uint8_V9 = getMapped<uint8>(offset, 129*129);
+            m_uint8_V8 = getMapped<uint8>(offset + sizeof(uint8) * 129*129, 128*128);
+            if (!m_uint8_V9 || !m_uint8_V8)
                 return false;
-            _gridIntHeightMultiplier = (header.gridMaxHeight - header.gridHeight) / 255;
+            _gridIntHeightMultiplier = (header->gridMaxHeight - header->gridHeight) / 255;
             _gridGetHeight = &GridMap::getHeightFromUint8;
         }
         else
         {
-            m_V9 = new float [129*129];
-            m_V8 = new float [128*128];
-            if (fread(m_V9, sizeof(float), 129*129, in) != 129*129 ||
-                fread(m_V8, sizeof(float), 128*128, in) != 128*128)
+            m_V9 = getMapped<float>(offset, 129*129);
+            m_V8 = getMapped<float>(offset + sizeof(float) * 129*129, 128*128);
+            if (!m_V9 || !m_V8)
                 return false;
             _gridGetHeight = &GridMap::getHeightFromFloat;
         }
@@ -1499,35 +1642,37 @@ bool GridMap::loadHeihgtData(FILE* in, uint32 offset, uint32 /*size*/)
     return true;
 }
 
-bool GridMap::loadLiquidData(FILE* in, uint32 offset, uint32 /*size*/)
+bool GridMap::loadLiquidData(uint32 offset)
 {
-    map_liquidHeader header;
-    fseek(in, offset, SEEK_SET);
-
-    if (fread(&header, sizeof(header), 1, in) != 1 || header.fourcc != MapLiquidMagic.asUInt)
+    map_liquidHeader const* header = getMapped<map_liquidHeader>(offset, 1);
+    if (!header || header->fourcc != MapLiquidMagic.asUInt)
         return false;
 
-    _liquidType   = header.liquidType;
-    _liquidOffX  = header.offsetX;
-    _liquidOffY  = header.offsetY;
-    _liquidWidth = header.width;
-    _liquidHeight = header.height;
-    _liquidLevel  = header.liquidLevel;
+    offset += sizeof(map_liquidHeader);
+
+    _liquidType   = header->liquidType;
+    _liquidOffX  = header->offsetX;
+    _liquidOffY  = header->offsetY;
+    _liquidWidth = header->width;
+    _liquidHeight = header->height;
+    _liquidLevel  = header->liquidLevel;
 
-    if (!(header.flags & MAP_LIQUID_NO_TYPE))
+    if (!(header->flags & MAP_LIQUID_NO_TYPE))
     {
-        _liquidEntry = new uint16[16*16];
-        if (fread(_liquidEntry, sizeof(uint16), 16*16, in) != 16*16)
+        _liquidEntry = getMapped<uint16>(offset, 16*16);
+        if (!_liquidEntry)
             return false;
+        offset += sizeof(uint16) * 16*16;
 
-        _liquidFlags = new uint8[16*16];
-        if (fread(_liquidFlags, sizeof(uint8), 16*16, in) != 16*16)
+        _liquidFlags = getMapped<uint8>(offset, 16*16);
+        if (!_liquidFlags)
             return false;
+        offset += sizeof(uint8) * 16*16;
     }
-    if (!(header.flags & MAP_LIQUID_NO_HEIGHT))
+    if (!(header->flags & MAP_LIQUID_NO_HEIGHT))
     {
-        _liquidMap = new float[_liquidWidth*_liquidHeight];
-        if (fread(_liquidMap, sizeof(float), _liquidWidth*_liquidHeight, in) != _liquidWidth*_liquidHeight)
+        _liquidMap = getMapped<float>(offset, _liquidWidth*_liquidHeight);
+        if (!_liquidMap)
             return false;
     }
     return true;
@@ -1648,7 +1793,7 @@ float GridMap::getHeightFromUint8(float x, float y) const
     y_int&=(MAP_RESOLUTION - 1);
 
     int32 a, b, c;
-    uint8 *V9_h1_ptr = &m_uint8_V9[x_int*128 + x_int + y_int];
+    uint8 const* V9_h1_ptr = &m_uint8_V9[x_int*128 + x_int + y_int];
     if (x+y < 1)
     {
         if (x > y)
@@ -1715,7 +1860,7 @@ float GridMap::getHeightFromUint16(float x, float y) const
     y_int&=(MAP_RESOLUTION - 1);
 
     int32 a, b, c;
-    uint16 *V9_h1_ptr = &m_uint16_V9[x_int*128 + x_int + y_int];
+    uint16 const* V9_h1_ptr = &m_uint16_V9[x_int*128 + x_int + y_int];
     if (x+y < 1)
     {
         if (x > y)
@@ -1944,6 +2089,11 @@ float Map::GetHeight(float x, float y, float z, bool checkVMap /*= true*/, float
             vmapHeight = vmgr->getHeight(GetId(), x, y, z + 2.0f, maxSearchDist);   // look from a bit higher pos to find the floor
     }
 
+    return SelectHeight(z, mapHeight, vmapHeight);
+}
+
+float Map::SelectHeight(float z, float mapHeight, float vmapHeight)
+{
     // mapHeight set for any above raw ground Z or <= INVALID_HEIGHT
     // vmapheight set for any under Z value or <= INVALID_HEIGHT
     if (vmapHeight > INVALID_HEIGHT)
@@ -2198,8 +2348,17 @@ void Map::GetZoneAndAreaIdByAreaFlag(uint32& zoneid, uint32& areaid, uint16 area
 
 bool Map::isInLineOfSight(float x1, float y1, float z1, float x2, float y2, float z2, uint32 phasemask) const
 {
-    return VMAP::VMapFactory::createOrGetVMapManager()->isInLineOfSight(GetId(), x1, y1, z1, x2, y2, z2)
-        && _dynamicTree.isInLineOfSight(x1, y1, z1, x2, y2, z2, phasemask);
+    bool result;
+    uint32 generation;
+    if (_collisionCache.FindLineOfSight(x1, y1, z1, x2, y2, z2, phasemask, result, generation))
+        return result;
+
+    result = VMAP::VMapFactory::createOrGetVMapManager()->isInLineOfSight(GetId(), x1, y1, z1, x2, y2, z2);
+    if (result)
+        result = _dynamicTree.isInLineOfSight(x1, y1, z1, x2, y2, z2, phasemask);
+
+    _collisionCache.StoreLineOfSight(x1, y1, z1, x2, y2, z2, phasemask, result, generation);
+    return result;
 }
 
 bool Map::getObjectHitPos(uint32 phasemask, float x1, float y1, float z1, float x2, float y2, float z2, float& rx, float& ry, float& rz, float modifyDist)
@@ -2218,7 +2377,130 @@ bool Map::getObjectHitPos(uint32 phasemask, float x1, float y1, float z1, float
 
 float Map::GetHeight(uint32 phasemask, float x, float y, float z, bool vmap/*=true*/, float maxSearchDist/*=DEFAULT_HEIGHT_SEARCH*/) const
 {
-    return std::max<float>(GetHeight(x, y, z, vmap, maxSearchDist), _dynamicTree.getHeight(x, y, z, maxSearchDist, phasemask));
+    float height;
+    uint32 generation;
+    if (_collisionCache.FindHeight(phasemask, x, y, z, vmap, maxSearchDist, height, generation))
+        return height;
+
+    height = std::max<float>(GetHeight(x, y, z, vmap, maxSearchDist), _dynamicTree.getHeight(x, y, z, maxSearchDist, phasemask));
+
+    _collisionCache.StoreHeight(phasemask, x, y, z, vmap, maxSearchDist, height, generation);
+    return height;
+}
+
+void Map::isInLineOfSight(Vector3 const* from, Vector3 const* to, uint32 const* phasemasks, uint32 count, bool* results) const
+{
+    // only the segments without a cached result are traced
+    std::vector<uint32> missed;
+    std::vector<Vector3> missedFrom;
+    std::vector<Vector3> missedTo;
+    uint32 generation = 0;
+    for (uint32 i = 0; i < count; ++i)
+    {
+        if (_collisionCache.FindLineOfSight(from[i].x, from[i].y, from[i].z, to[i].x, to[i].y, to[i].z, phasemasks[i], results[i], generation))
+            continue;
+
+        missed.push_back(i);
+        missedFrom.push_back(from[i]);
+        missedTo.push_back(to[i]);
+    }
+
+    if (missed.empty())
+        return;
+
+    uint32 missedCount = uint32(missed.size());
+    bool* missedResults = new bool[missedCount];
+    VMAP::VMapFactory::createOrGetVMapManager()->isInLineOfSight(GetId(), &missedFrom[0], &missedTo[0], missedCount, missedResults);
+
+    // game objects are only tested for the segments the static geometry does not block
+    for (uint32 j = 0; j < missedCount; ++j)
+    {
+        uint32 i = missed[j];
+        results[i] = missedResults[j] && _dynamicTree.isInLineOfSight(from[i].x, from[i].y, from[i].z, to[i].x, to[i].y, to[i].z, phasemasks[i]);
+    }
+
+    delete[] missedResults;
+
+    // all results were computed after the last lookup, its generation covers them
+    for (uint32 j = 0; j < missedCount; ++j)
+    {
+        uint32 i = missed[j];
+        _collisionCache.StoreLineOfSight(from[i].x, from[i].y, from[i].z, to[i].x, to[i].y, to[i].z, phasemasks[i], results[i], generation);
+    }
+}
+
+void Map::GetHeights(Vector3 const* points, uint32 const* phasemasks, uint32 count, float* heights, bool vmap/*=true*/, float maxSearchDist/*=DEFAULT_HEIGHT_SEARCH*/) const
+{
+    // only the points without a cached result are looked up
+    std::vector<uint32> missed;
+    uint32 generation = 0;
+    for (uint32 i = 0; i < count; ++i)
+        if (!_collisionCache.FindHeight(phasemasks[i], points[i].x, points[i].y, points[i].z, vmap, maxSearchDist, heights[i], generation))
+            missed.push_back(i);
+
+    if (missed.empty())
+        return;
+
+    uint32 missedCount = uint32(missed.size());
+    std::vector<float> vmapHeights(missedCount, VMAP_INVALID_HEIGHT_VALUE);
+    VMAP::IVMapManager* vmgr = VMAP::VMapFactory::createOrGetVMapManager();
+    if (vmap && vmgr->isHeightCalcEnabled())
+    {
+        // look from a bit higher pos to find the floor
+        std::vector<Vector3> raised(missedCount);
+        for (uint32 j = 0; j < missedCount; ++j)
+        {
+            raised[j] = points[missed[j]];
+            raised[j].z += 2.0f;
+        }
+
+        vmgr->getHeights(GetId(), &raised[0], missedCount, maxSearchDist, &vmapHeights[0]);
+    }
+
+    // the grid map is only looked up again when the points change grids
+    GridMap* gmap = NULL;
+    int lastGx = -1;
+    int lastGy = -1;
+    for (uint32 j = 0; j < missedCount; ++j)
+    {
+        uint32 i = missed[j];
+        float x = points[i].x;
+        float y = points[i].y;
+        float z = points[i].z;
+
+        int gx = int(32 - x / SIZE_OF_GRIDS);
+        int gy = int(32 - y / SIZE_OF_GRIDS);
+        if (gx != lastGx || gy != lastGy)
+        {
+            gmap = const_cast<Map*>(this)->GetGrid(x, y);
+            lastGx = gx;
+            lastGy = gy;
+        }
+
+        float mapHeight = VMAP_INVALID_HEIGHT_VALUE;
+        if (gmap)
+        {
+            float gridHeight = gmap->getHeight(x, y);
+            // look from a bit higher pos to find the floor, ignore under surface case
+            if (z + 2.0f > gridHeight)
+                mapHeight = gridHeight;
+        }
+
+        heights[i] = SelectHeight(z, mapHeight, vmapHeights[j]);
+    }
+
+    for (uint32 j = 0; j < missedCount; ++j)
+    {
+        uint32 i = missed[j];
+        heights[i] = std::max<float>(heights[i], _dynamicTree.getHeight(points[i].x, points[i].y, points[i].z, maxSearchDist, phasemasks[i]));
+    }
+
+    // all results were computed after the last lookup, its generation covers them
+    for (uint32 j = 0; j < missedCount; ++j)
+    {
+        uint32 i = missed[j];
+        _collisionCache.StoreHeight(phasemasks[i], points[i].x, points[i].y, points[i].z, vmap, maxSearchDist, heights[i], generation);
+    }
 }
 
 bool Map::IsInWater(float x, float y, float pZ, LiquidData* data) const
@@ -2462,6 +2744,8 @@ uint32 Map::GetPlayersCountExceptGMs() const
 
 void Map::SendToPlayers(WorldPacket const* data) const
 {
+    SharedPacketScope share(data);
+
     for (MapRefManager::const_iterator itr = m_mapRefManager.begin(); itr != m_mapRefManager.end(); ++itr)
         itr->getSource()->GetSession()->SendPacket(data);
 }
@@ -2796,7 +3080,10 @@ void InstanceMap::Update(const uint32 t_diff)
     Map::Update(t_diff);
 
     if (i_data)
+    {
+        ProfileScope profile(PROFILE_SCRIPT, sObjectMgr->GetScriptName(i_script_id), GetId());
         i_data->Update(t_diff);
+    }
 }
 
 void InstanceMap::RemovePlayerFromMap(Player* player, bool remove)
@@ -3060,7 +3347,18 @@ void BattlegroundMap::RemoveAllPlayers()
 
 Creature* Map::GetCreature(uint64 guid)
 {
-    return ObjectAccessor::GetObjectInMap(guid, this, (Creature*)NULL);
+    UNORDERED_MAP<uint64, Creature*>::const_iterator itr = _creatureStore.find(guid);
+    return itr != _creatureStore.end() ? itr->second : NULL;
+}
+
+void Map::AddToCreatureStore(Creature* creature)
+{
+    _creatureStore[creature->GetGUID()] = creature;
+}
+
+void Map::RemoveFromCreatureStore(Creature* creature)
+{
+    _creatureStore.erase(creature->GetGUID());
 }
 
 GameObject* Map::GetGameObject(uint64 guid)
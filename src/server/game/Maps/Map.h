@@ -31,7 +31,9 @@
 #include "GridRefManager.h"
 #include "MapRefManager.h"
 #include "DynamicTree.h"
+#include "CollisionQueryCache.h"
 #include "GameObjectModel.h"
+#include "MapUpdater.h"
 
 #include <bitset>
 #include <list>
@@ -51,6 +53,7 @@ struct ScriptAction;
 struct Position;
 class Battleground;
 class MapInstanced;
+class ACE_Mem_Map;
 class InstanceMap;
 class Transport;
 namespace Trinity { struct ObjectUpdater; }
@@ -146,28 +149,30 @@ struct LiquidData
 class GridMap
 {
     uint32  _flags;
+    // the arrays point into the mapped file
+    ACE_Mem_Map* _mapping;
     union{
-        float* m_V9;
-        uint16* m_uint16_V9;
-        uint8* m_uint8_V9;
+        float const* m_V9;
+        uint16 const* m_uint16_V9;
+        uint8 const* m_uint8_V9;
     };
     union{
-        float* m_V8;
-        uint16* m_uint16_V8;
-        uint8* m_uint8_V8;
+        float const* m_V8;
+        uint16 const* m_uint16_V8;
+        uint8 const* m_uint8_V8;
     };
     // Height level data
     float _gridHeight;
     float _gridIntHeightMultiplier;
 
     // Area data
-    uint16* _areaMap;
+    uint16 const* _areaMap;
 
     // Liquid data
     float _liquidLevel;
-    uint16* _liquidEntry;
-    uint8* _liquidFlags;
-    float* _liquidMap;
+    uint16 const* _liquidEntry;
+    uint8 const* _liquidFlags;
+    float const* _liquidMap;
     uint16 _gridArea;
     uint16 _liquidType;
     uint8 _liquidOffX;
@@ -176,9 +181,12 @@ class GridMap
     uint8 _liquidHeight;
 
 
-    bool loadAreaData(FILE* in, uint32 offset, uint32 size);
-    bool loadHeihgtData(FILE* in, uint32 offset, uint32 size);
-    bool loadLiquidData(FILE* in, uint32 offset, uint32 size);
+    // count elements of T at offset of the mapped file, NULL if the file is too short
+    template<class T> T const* getMapped(uint32 offset, uint32 count) const;
+
+    bool loadAreaData(uint32 offset);
+    bool loadHeihgtData(uint32 offset);
+    bool loadLiquidData(uint32 offset);
 
     // Get height functions and pointers
     typedef float (GridMap::*GetHeightPtr) (float x, float y) const;
@@ -231,6 +239,7 @@ enum LevelRequirementVsMode
 #define MAX_FALL_DISTANCE     250000.0f                     // "unlimited fall" to find VMap ground if it is available, just larger than MAX_HEIGHT - INVALID_HEIGHT
 #define DEFAULT_HEIGHT_SEARCH     50.0f                     // default search distance to find height at nearby locations
 #define MIN_UNLOAD_DELAY      1                             // immediate unload
+#define GRID_PRELOAD_LOOKAHEAD 30.0f                        // seconds of movement ahead of players whose terrain is preloaded
 
 typedef std::map<uint32/*leaderDBGUID*/, CreatureGroup*>        CreatureGroupHolderType;
 
@@ -264,6 +273,10 @@ class Map : public GridRefManager<NGridType>
         void VisitNearbyCellsOf(WorldObject* obj, TypeContainerVisitor<Trinity::ObjectUpdater, GridTypeMapContainer> &gridVisitor, TypeContainerVisitor<Trinity::ObjectUpdater, WorldTypeMapContainer> &worldVisitor);
         virtual void Update(const uint32);
 
+        // objects with changed values, their updates are built and sent to the players in range at the end of Update()
+        void AddUpdateObject(Object* obj);
+        void RemoveUpdateObject(Object* obj);
+
         float GetVisibilityRange() const { return m_VisibleDistance; }
         //function for setting up visibility distance for maps on per-type/per-Id basis
         virtual void InitVisibilityDistance();
@@ -288,6 +301,8 @@ class Map : public GridRefManager<NGridType>
         bool GetUnloadLock(const GridCoord &p) const { return getNGrid(p.x_coord, p.y_coord)->getUnloadLock(); }
         void SetUnloadLock(const GridCoord &p, bool on) { getNGrid(p.x_coord, p.y_coord)->setUnloadExplicitLock(on); }
         void LoadGrid(float x, float y);
+        // loads the terrain of the grid at (x, y) in the background if it is not loaded yet
+        void PreloadGrid(float x, float y);
         bool UnloadGrid(NGridType& ngrid, bool pForce);
         virtual void UnloadAll();
 
@@ -428,6 +443,11 @@ class Map : public GridRefManager<NGridType>
         TempSummon* SummonCreature(uint32 entry, Position const& pos, SummonPropertiesEntry const* properties = NULL, uint32 duration = 0, Unit* summoner = NULL, uint32 spellId = 0, uint32 vehId = 0);
         Creature* GetCreature(uint64 guid);
         GameObject* GetGameObject(uint64 guid);
+
+        // creatures in world on this map by guid, looked up without the global ObjectAccessor locks;
+        // only to be used by the thread updating the map or while no map is updated
+        void AddToCreatureStore(Creature* creature);
+        void RemoveFromCreatureStore(Creature* creature);
         Transport* GetTransport(uint64 guid);
         DynamicObject* GetDynamicObject(uint64 guid);
 
@@ -439,10 +459,38 @@ class Map : public GridRefManager<NGridType>
         float GetWaterOrGroundLevel(float x, float y, float z, float* ground = NULL, bool swim = false) const;
         float GetHeight(uint32 phasemask, float x, float y, float z, bool vmap = true, float maxSearchDist = DEFAULT_HEIGHT_SEARCH) const;
         bool isInLineOfSight(float x1, float y1, float z1, float x2, float y2, float z2, uint32 phasemask) const;
+        // batch versions for count segments or points, the static geometry is tested in shared traversals of the map tree
+        void isInLineOfSight(G3D::Vector3 const* from, G3D::Vector3 const* to, uint32 const* phasemasks, uint32 count, bool* results) const;
+        void GetHeights(G3D::Vector3 const* points, uint32 const* phasemasks, uint32 count, float* heights, bool vmap = true, float maxSearchDist = DEFAULT_HEIGHT_SEARCH) const;
         void Balance() { _dynamicTree.balance(); }
-        void Remove(const GameObjectModel& mdl) { _dynamicTree.remove(mdl); }
-        void Insert(const GameObjectModel& mdl) { _dynamicTree.insert(mdl); }
+        void Remove(const GameObjectModel& mdl)
+        {
+            _dynamicTree.remove(mdl);
+            InvalidateCollisionCache(mdl);
+        }
+
+        void Insert(const GameObjectModel& mdl)
+        {
+            _dynamicTree.insert(mdl);
+            InvalidateCollisionCache(mdl);
+        }
+
         bool Contains(const GameObjectModel& mdl) const { return _dynamicTree.contains(mdl);}
+
+        // must be called whenever the collision of a game object model in the dynamic tree changes, Insert and Remove
+        // do it on their own; drops the cached results around the bounds of the model
+        void InvalidateCollisionCache(GameObjectModel const& mdl) const
+        {
+            G3D::AABox const& bounds = mdl.getBounds();
+            _collisionCache.Invalidate(bounds.low().x, bounds.low().y, bounds.high().x, bounds.high().y);
+        }
+
+        // drops the cached results of a grid, called when its terrain is loaded or unloaded
+        void InvalidateCollisionCache(int gx, int gy) const;
+
+        CollisionQueryCache& GetCollisionCache() { return _collisionCache; }
+        CollisionQueryCache const& GetCollisionCache() const { return _collisionCache; }
+
         bool getObjectHitPos(uint32 phasemask, float x1, float y1, float z1, float x2, float y2, float z2, float& rx, float &ry, float& rz, float modifyDist);
 
         /*
@@ -479,11 +527,17 @@ class Map : public GridRefManager<NGridType>
         void SendInitTransports(Player* player);
         void SendRemoveTransports(Player* player);
 
+        MapUpdateStats& GetUpdateStats() { return _updateStats; }
+        MapUpdateStats const& GetUpdateStats() const { return _updateStats; }
+
     private:
         void LoadMapAndVMap(int gx, int gy);
         void LoadVMap(int gx, int gy);
         void LoadMap(int gx, int gy, bool reload = false);
         GridMap* GetGrid(float x, float y);
+        void PreloadGridsAhead(Player* player);
+        // picks the .map or the vmap height for GetHeight, either may be <= INVALID_HEIGHT
+        static float SelectHeight(float z, float mapHeight, float vmapHeight);
 
         void SetTimer(uint32 t) { i_gridExpiry = t < MIN_GRID_DELAY ? MIN_GRID_DELAY : t; }
 
@@ -525,6 +579,8 @@ class Map : public GridRefManager<NGridType>
 
         void UpdateActiveCells(const float &x, const float &y, const uint32 t_diff);
 
+        void SendObjectUpdates();
+
     protected:
         void SetUnloadReferenceLock(const GridCoord &p, bool on) { getNGrid(p.x_coord, p.y_coord)->setUnloadReferenceLock(on); }
 
@@ -536,6 +592,7 @@ class Map : public GridRefManager<NGridType>
         uint32 m_unloadTimer;
         float m_VisibleDistance;
         DynamicMapTree _dynamicTree;
+        mutable CollisionQueryCache _collisionCache;        // line of sight and height results, see InvalidateCollisionCache
 
         MapRefManager m_mapRefManager;
         MapRefManager::iterator m_mapRefIter;
@@ -615,6 +672,13 @@ class Map : public GridRefManager<NGridType>
 
         UNORDERED_MAP<uint32 /*dbGUID*/, time_t> _creatureRespawnTimes;
         UNORDERED_MAP<uint32 /*dbGUID*/, time_t> _goRespawnTimes;
+
+        UNORDERED_MAP<uint64, Creature*> _creatureStore;
+
+        std::set<Object*> _updateObjects;
+        ACE_Thread_Mutex _updateObjectsLock;                    // values may be changed from other maps' threads
+
+        MapUpdateStats _updateStats;
 };
 
 enum InstanceResetMethod
@@ -67,7 +67,7 @@ void MapInstanced::Update(const uint32 t)
             if (sMapMgr->GetMapUpdater()->activated())
                 sMapMgr->GetMapUpdater()->schedule_update(*i->second, t);
             else
-                i->second->Update(t);
+                MapUpdater::update_map(*i->second, t);
             ++i;
         }
     }
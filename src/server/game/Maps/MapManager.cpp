@@ -61,6 +61,10 @@ void MapManager::Initialize()
     // Start mtmaps if needed.
     if (num_threads > 0 && m_updater.activate(num_threads) == -1)
         abort();
+
+    int preload_threads(sWorld->getIntConfig(CONFIG_GRID_PRELOAD_THREADS));
+    if (preload_threads > 0 && m_preloader.activate(preload_threads) == -1)
+        abort();
 }
 
 void MapManager::InitializeVisibilityDistanceInfo()
@@ -278,7 +282,7 @@ void MapManager::Update(uint32 diff)
         if (m_updater.activated())
             m_updater.schedule_update(*iter->second, uint32(i_timer.GetCurrent()));
         else
-            iter->second->Update(uint32(i_timer.GetCurrent()));
+            MapUpdater::update_map(*iter->second, uint32(i_timer.GetCurrent()));
     }
     if (m_updater.activated())
         m_updater.wait();
@@ -286,11 +290,26 @@ void MapManager::Update(uint32 diff)
     for (iter = i_maps.begin(); iter != i_maps.end(); ++iter)
         iter->second->DelayedUpdate(uint32(i_timer.GetCurrent()));
 
-    sObjectAccessor->Update(uint32(i_timer.GetCurrent()));
-
     i_timer.SetCurrent(0);
 }
 
+void MapManager::GetAllMaps(std::vector<Map*>& maps)
+{
+    TRINITY_GUARD(ACE_Thread_Mutex, Lock);
+
+    for (MapMapType::iterator iter = i_maps.begin(); iter != i_maps.end(); ++iter)
+    {
+        maps.push_back(iter->second);
+
+        if (MapInstanced* instanced = iter->second->ToMapInstanced())
+        {
+            MapInstanced::InstancedMaps& instances = instanced->GetInstancedMaps();
+            for (MapInstanced::InstancedMaps::iterator i = instances.begin(); i != instances.end(); ++i)
+                maps.push_back(i->second);
+        }
+    }
+}
+
 void MapManager::DoDelayedMovesAndRemoves()
 {
 }
@@ -329,6 +348,9 @@ void MapManager::UnloadAll()
     if (m_updater.activated())
         m_updater.deactivate();
 
+    if (m_preloader.activated())
+        m_preloader.deactivate();
+
     Map::DeleteStateMachine();
 }
 
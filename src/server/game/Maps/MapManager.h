@@ -26,6 +26,7 @@
 #include "Map.h"
 #include "GridStates.h"
 #include "MapUpdater.h"
+#include "GridPreloader.h"
 
 class Transport;
 struct TransportCreatureProto;
@@ -138,6 +139,10 @@ class MapManager
         void SetNextInstanceId(uint32 nextInstanceId) { _nextInstanceId = nextInstanceId; };
 
         MapUpdater * GetMapUpdater() { return &m_updater; }
+        GridPreloader* GetGridPreloader() { return &m_preloader; }
+
+        // all base maps and their instances, used for update statistics
+        void GetAllMaps(std::vector<Map*>& maps);
 
     private:
         typedef UNORDERED_MAP<uint32, Map*> MapMapType;
@@ -168,6 +173,7 @@ class MapManager
         InstanceIds _instanceIds;
         uint32 _nextInstanceId;
         MapUpdater m_updater;
+        GridPreloader m_preloader;
 };
 #define sMapMgr ACE_Singleton<MapManager, ACE_Thread_Mutex>::instance()
 #endif
@@ -1,64 +1,43 @@
 #include "MapUpdater.h"
-#include "DelayExecutor.h"
 #include "Map.h"
+#include "Timer.h"
 #include "DatabaseEnv.h"
+#include "TickProfiler.h"
 
 #include <ace/Guard_T.h>
-#include <ace/Method_Request.h>
 
-class WDBThreadStartReq1 : public ACE_Method_Request
-{
-    public:
-
-        WDBThreadStartReq1()
-        {
-        }
-
-        virtual int call()
-        {
-            return 0;
-        }
-};
+#include <algorithm>
 
-class WDBThreadEndReq1 : public ACE_Method_Request
-{
-    public:
-
-        WDBThreadEndReq1()
-        {
-        }
-
-        virtual int call()
-        {
-            return 0;
-        }
-};
+uint32 const MapUpdateStats::BucketLimits[MapUpdateStats::HISTOGRAM_BUCKETS - 1] = { 1, 2, 5, 10, 25, 50, 100, 250 };
 
-class MapUpdateRequest : public ACE_Method_Request
+void MapUpdateStats::Record(uint32 cost)
 {
-    private:
+    LastCost = cost;
+    if (cost > MaxCost)
+        MaxCost = cost;
 
-        Map& m_map;
-        MapUpdater& m_updater;
-        ACE_UINT32 m_diff;
+    TotalCost += cost;
+    ++Updates;
 
-    public:
+    uint8 bucket = 0;
+    while (bucket < HISTOGRAM_BUCKETS - 1 && cost >= BucketLimits[bucket])
+        ++bucket;
 
-        MapUpdateRequest(Map& m, MapUpdater& u, ACE_UINT32 d)
-            : m_map(m), m_updater(u), m_diff(d)
-        {
-        }
+    ++Histogram[bucket];
+}
 
-        virtual int call()
-        {
-            m_map.Update (m_diff);
-            m_updater.update_finished();
-            return 0;
-        }
-};
+void MapUpdateStats::Reset()
+{
+    LastCost = 0;
+    MaxCost = 0;
+    TotalCost = 0;
+    Updates = 0;
+    memset(Histogram, 0, sizeof(Histogram));
+}
 
 MapUpdater::MapUpdater():
-m_executor(), m_mutex(), m_condition(m_mutex), pending_requests(0)
+m_mutex(), m_condition(m_mutex), m_workCondition(m_mutex), pending_requests(0), queued_requests(0),
+started_workers(0), m_activated(false), m_stopping(false)
 {
 }
 
@@ -69,18 +48,55 @@ MapUpdater::~MapUpdater()
 
 int MapUpdater::activate(size_t num_threads)
 {
-    return m_executor.activate((int)num_threads, new WDBThreadStartReq1, new WDBThreadEndReq1);
+    if (activated() || num_threads < 1)
+        return -1;
+
+    for (size_t i = 0; i < num_threads; ++i)
+        m_queues.push_back(new WorkerQueue());
+
+    m_stopping = false;
+    started_workers = 0;
+
+    if (ACE_Task_Base::activate(THR_NEW_LWP | THR_JOINABLE | THR_INHERIT_SCHED, int(num_threads)) == -1)
+    {
+        for (size_t i = 0; i < m_queues.size(); ++i)
+            delete m_queues[i];
+
+        m_queues.clear();
+        return -1;
+    }
+
+    m_activated = true;
+    return 0;
 }
 
 int MapUpdater::deactivate()
 {
+    if (!activated())
+        return -1;
+
     wait();
 
-    return m_executor.deactivate();
+    {
+        TRINITY_GUARD(ACE_Thread_Mutex, m_mutex);
+        m_stopping = true;
+        m_workCondition.broadcast();
+    }
+
+    ACE_Task_Base::wait();
+
+    for (size_t i = 0; i < m_queues.size(); ++i)
+        delete m_queues[i];
+
+    m_queues.clear();
+    m_activated = false;
+    return 0;
 }
 
 int MapUpdater::wait()
 {
+    dispatch_staged();
+
     TRINITY_GUARD(ACE_Thread_Mutex, m_mutex);
 
     while (pending_requests > 0)
@@ -91,24 +107,118 @@ int MapUpdater::wait()
 
 int MapUpdater::schedule_update(Map& map, ACE_UINT32 diff)
 {
+    MapUpdateRequest request(&map, diff, map.GetUpdateStats().LastCost);
+
+    // maps scheduled from inside of a map update (instances of MapInstanced) go directly to the
+    // queue of the current worker, everything else waits for the batch to be distributed in wait()
+    WorkerContext* context = m_context.ts_object();
+    if (context && context->m_updater == this)
+    {
+        {
+            TRINITY_GUARD(ACE_Thread_Mutex, m_mutex);
+            ++pending_requests;
+        }
+
+        enqueue(context->m_index, request);
+        return 0;
+    }
+
     TRINITY_GUARD(ACE_Thread_Mutex, m_mutex);
 
     ++pending_requests;
+    m_staged.push_back(request);
+    return 0;
+}
+
+bool MapUpdater::activated()
+{
+    return m_activated;
+}
+
+void MapUpdater::update_map(Map& map, ACE_UINT32 diff)
+{
+    ProfileScope profile(PROFILE_MAP, map.GetMapName(), map.GetId());
+
+    uint32 startTime = getMSTime();
+    map.Update(diff);
+    map.GetUpdateStats().Record(GetMSTimeDiffToNow(startTime));
+}
+
+void MapUpdater::enqueue(size_t index, MapUpdateRequest const& request)
+{
+    WorkerQueue* queue = m_queues[index];
 
-    if (m_executor.execute(new MapUpdateRequest(map, *this, diff)) == -1)
     {
-        ACE_DEBUG((LM_ERROR, ACE_TEXT("(%t) \n"), ACE_TEXT("Failed to schedule Map Update")));
+        TRINITY_GUARD(ACE_Thread_Mutex, queue->m_lock);
+        queue->m_requests.insert(std::upper_bound(queue->m_requests.begin(), queue->m_requests.end(), request), request);
+        queue->m_cost += request.m_cost + 1;
+    }
 
-        --pending_requests;
-        return -1;
+    TRINITY_GUARD(ACE_Thread_Mutex, m_mutex);
+    ++queued_requests;
+    m_workCondition.signal();
+}
+
+bool MapUpdater::dequeue(size_t index, MapUpdateRequest& request)
+{
+    // own queue first, most expensive update at the front
+    {
+        WorkerQueue* queue = m_queues[index];
+        TRINITY_GUARD(ACE_Thread_Mutex, queue->m_lock);
+        if (!queue->m_requests.empty())
+        {
+            request = queue->m_requests.front();
+            queue->m_requests.pop_front();
+            queue->m_cost -= request.m_cost + 1;
+            return true;
+        }
     }
 
-    return 0;
+    // steal the cheapest update of another worker, its owner keeps the expensive ones
+    for (size_t i = 1; i < m_queues.size(); ++i)
+    {
+        WorkerQueue* queue = m_queues[(index + i) % m_queues.size()];
+        TRINITY_GUARD(ACE_Thread_Mutex, queue->m_lock);
+        if (!queue->m_requests.empty())
+        {
+            request = queue->m_requests.back();
+            queue->m_requests.pop_back();
+            queue->m_cost -= request.m_cost + 1;
+            return true;
+        }
+    }
+
+    return false;
 }
 
-bool MapUpdater::activated()
+void MapUpdater::dispatch_staged()
 {
-    return m_executor.activated();
+    std::vector<MapUpdateRequest> staged;
+
+    {
+        TRINITY_GUARD(ACE_Thread_Mutex, m_mutex);
+        staged.swap(m_staged);
+    }
+
+    if (staged.empty())
+        return;
+
+    // longest processing time first: each request goes to the queue with the least expected work
+    std::stable_sort(staged.begin(), staged.end());
+
+    std::vector<uint64> load(m_queues.size(), 0);
+    for (size_t i = 0; i < m_queues.size(); ++i)
+    {
+        TRINITY_GUARD(ACE_Thread_Mutex, m_queues[i]->m_lock);
+        load[i] = m_queues[i]->m_cost;
+    }
+
+    for (std::vector<MapUpdateRequest>::const_iterator itr = staged.begin(); itr != staged.end(); ++itr)
+    {
+        size_t index = std::min_element(load.begin(), load.end()) - load.begin();
+        load[index] += itr->m_cost + 1;
+        enqueue(index, *itr);
+    }
 }
 
 void MapUpdater::update_finished()
@@ -123,5 +233,44 @@ void MapUpdater::update_finished()
 
     --pending_requests;
 
-    m_condition.broadcast();
+    if (pending_requests == 0)
+        m_condition.broadcast();
+}
+
+int MapUpdater::svc()
+{
+    size_t index;
+
+    {
+        TRINITY_GUARD(ACE_Thread_Mutex, m_mutex);
+        index = started_workers++;
+    }
+
+    m_context->m_updater = this;
+    m_context->m_index = index;
+
+    for (;;)
+    {
+        {
+            TRINITY_GUARD(ACE_Thread_Mutex, m_mutex);
+
+            while (queued_requests == 0 && !m_stopping)
+                m_workCondition.wait();
+
+            if (queued_requests == 0)
+                break;
+
+            // claim one request, it is guaranteed to be present in one of the queues
+            --queued_requests;
+        }
+
+        MapUpdateRequest request(NULL, 0, 0);
+        while (!dequeue(index, request))
+            ACE_Thread::yield();
+
+        update_map(*request.m_map, request.m_diff);
+        update_finished();
+    }
+
+    return 0;
 }
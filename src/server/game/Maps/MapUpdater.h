@@ -1,22 +1,54 @@
 #ifndef _MAP_UPDATER_H_INCLUDED
 #define _MAP_UPDATER_H_INCLUDED
 
+#include <ace/Task.h>
+#include <ace/TSS_T.h>
 #include <ace/Thread_Mutex.h>
 #include <ace/Condition_Thread_Mutex.h>
 
-#include "DelayExecutor.h"
+#include "Define.h"
+
+#include <deque>
+#include <vector>
 
 class Map;
 
-class MapUpdater
+// Per map update timing, kept by every Map and filled by MapUpdater after each update
+struct MapUpdateStats
+{
+    enum
+    {
+        HISTOGRAM_BUCKETS = 9
+    };
+
+    // upper bounds (exclusive, in ms) of all buckets except the last one
+    static uint32 const BucketLimits[HISTOGRAM_BUCKETS - 1];
+
+    MapUpdateStats() { Reset(); }
+
+    void Record(uint32 cost);
+    void Reset();
+
+    uint32 GetAverageCost() const { return Updates ? uint32(TotalCost / Updates) : 0; }
+
+    uint32 LastCost;                                        // duration of the last update, used for scheduling order
+    uint32 MaxCost;
+    uint64 TotalCost;
+    uint32 Updates;
+    uint32 Histogram[HISTOGRAM_BUCKETS];
+};
+
+// Schedules map updates over a pool of worker threads.
+// Every worker owns a queue ordered by the last update cost of the queued maps (most expensive first),
+// a batch of updates is distributed between the queues so that the expected total cost is balanced and
+// workers that run out of work steal the cheapest pending updates from the other queues.
+class MapUpdater : protected ACE_Task_Base
 {
     public:
 
         MapUpdater();
         virtual ~MapUpdater();
 
-        friend class MapUpdateRequest;
-
         int schedule_update(Map& map, ACE_UINT32 diff);
 
         int wait();
@@ -27,14 +59,61 @@ class MapUpdater
 
         bool activated();
 
+        // updates the map on the calling thread and records its timing
+        static void update_map(Map& map, ACE_UINT32 diff);
+
+        virtual int svc();
+
     private:
 
-        DelayExecutor m_executor;
-        ACE_Thread_Mutex m_mutex;
-        ACE_Condition_Thread_Mutex m_condition;
-        size_t pending_requests;
+        struct MapUpdateRequest
+        {
+            MapUpdateRequest(Map* map, ACE_UINT32 diff, uint32 cost) : m_map(map), m_diff(diff), m_cost(cost) { }
+
+            // more expensive requests go first
+            bool operator<(MapUpdateRequest const& right) const { return m_cost > right.m_cost; }
+
+            Map* m_map;
+            ACE_UINT32 m_diff;
+            uint32 m_cost;
+        };
+
+        typedef std::deque<MapUpdateRequest> RequestQueue;
+
+        struct WorkerQueue
+        {
+            WorkerQueue() : m_cost(0) { }
+
+            ACE_Thread_Mutex m_lock;
+            RequestQueue m_requests;
+            uint64 m_cost;                                  // sum of expected cost of queued requests
+        };
 
+        struct WorkerContext
+        {
+            WorkerContext() : m_updater(NULL), m_index(0) { }
+
+            MapUpdater* m_updater;
+            size_t m_index;
+        };
+
+        void enqueue(size_t index, MapUpdateRequest const& request);
+        bool dequeue(size_t index, MapUpdateRequest& request);
+        void dispatch_staged();
         void update_finished();
+
+        ACE_Thread_Mutex m_mutex;
+        ACE_Condition_Thread_Mutex m_condition;             // signaled when all pending requests finished
+        ACE_Condition_Thread_Mutex m_workCondition;         // signaled when new requests are queued
+        size_t pending_requests;                            // scheduled and not finished requests
+        size_t queued_requests;                             // requests sitting in worker queues, not claimed yet
+        size_t started_workers;
+        bool m_activated;
+        bool m_stopping;
+
+        std::vector<MapUpdateRequest> m_staged;             // requests scheduled outside of worker threads
+        std::vector<WorkerQueue*> m_queues;
+        ACE_TSS<WorkerContext> m_context;
 };
 
 #endif //_MAP_UPDATER_H_INCLUDED
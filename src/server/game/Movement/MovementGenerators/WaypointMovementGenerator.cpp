@@ -255,6 +255,7 @@ void FlightPathMovementGenerator::Finalize(Player& player)
 }
 
 #define PLAYER_FLIGHT_SPEED 32.0f
+#define FLIGHT_PRELOAD_DISTANCE (PLAYER_FLIGHT_SPEED * GRID_PRELOAD_LOOKAHEAD)
 
 void FlightPathMovementGenerator::Reset(Player & player)
 {
@@ -273,6 +274,8 @@ void FlightPathMovementGenerator::Reset(Player & player)
     init.SetFly();
     init.SetVelocity(PLAYER_FLIGHT_SPEED);
     init.Launch();
+
+    PreloadGridsAhead(player);
 }
 
 bool FlightPathMovementGenerator::Update(Player &player, const uint32& /*diff*/)
@@ -292,6 +295,8 @@ bool FlightPathMovementGenerator::Update(Player &player, const uint32& /*diff*/)
             departureEvent = !departureEvent;
         }
         while (true);
+
+        PreloadGridsAhead(player);
     }
 
     return i_currentNode < (i_path->size()-1);
@@ -355,6 +360,19 @@ void FlightPathMovementGenerator::PreloadEndGrid()
         sLog->outDetail("Unable to determine map to preload flightmaster grid");
 }
 
+void FlightPathMovementGenerator::PreloadGridsAhead(Player& player)
+{
+    // terrain of the grids the next part of the flight crosses is loaded in the background
+    uint32 end = GetPathAtMapEnd();
+    float distance = 0.0f;
+    for (uint32 i = GetCurrentNode() + 1; i < end && distance < FLIGHT_PRELOAD_DISTANCE; ++i)
+    {
+        TaxiPathNodeEntry const& prev = (*i_path)[i - 1];
+        TaxiPathNodeEntry const& node = (*i_path)[i];
+        distance += std::sqrt((node.x - prev.x) * (node.x - prev.x) + (node.y - prev.y) * (node.y - prev.y));
+        player.GetMap()->PreloadGrid(node.x, node.y);
+    }
+}
 
 //
 // Unique1's ASTAR Pathfinding Code... For future use & reference...
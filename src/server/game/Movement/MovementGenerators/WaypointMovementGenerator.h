@@ -135,6 +135,7 @@ class FlightPathMovementGenerator : public MovementGeneratorMedium< Player, Flig
 
         void InitEndGridInfo();
         void PreloadEndGrid();
+        void PreloadGridsAhead(Player& player);
 
     private:
         float _endGridX;                //! X coord of last node location
@@ -27,6 +27,7 @@
 #include "ScriptSystem.h"
 #include "Transport.h"
 #include "Vehicle.h"
+#include "TickProfiler.h"
 
 // This is the global static registry of scripts.
 template<class TScript>
@@ -479,11 +480,16 @@ void ScriptMgr::OnPacketReceive(WorldSocket* socket, WorldPacket packet)
     FOREACH_SCRIPT(ServerScript)->OnPacketReceive(socket, packet);
 }
 
-void ScriptMgr::OnPacketSend(WorldSocket* socket, WorldPacket packet)
+void ScriptMgr::OnPacketSend(WorldSocket* socket, WorldPacket const& packet)
 {
     ASSERT(socket);
 
-    FOREACH_SCRIPT(ServerScript)->OnPacketSend(socket, packet);
+    // Only copy the packet if a script can see it, the copy keeps hooks from modifying what is sent.
+    if (SCR_REG_LST(ServerScript).empty())
+        return;
+
+    WorldPacket copy(packet);
+    FOREACH_SCRIPT(ServerScript)->OnPacketSend(socket, copy);
 }
 
 void ScriptMgr::OnUnknownPacketReceive(WorldSocket* socket, WorldPacket packet)
@@ -520,7 +526,11 @@ void ScriptMgr::OnShutdownCancel()
 
 void ScriptMgr::OnWorldUpdate(uint32 diff)
 {
-    FOREACH_SCRIPT(WorldScript)->OnUpdate(diff);
+    FOR_SCRIPTS(WorldScript, itr, end)
+    {
+        ProfileScope profile(PROFILE_SCRIPT, itr->second->GetName().c_str());
+        itr->second->OnUpdate(diff);
+    }
 }
 
 void ScriptMgr::OnHonorCalculation(float& honor, uint8 level, float multiplier)
@@ -689,14 +699,17 @@ void ScriptMgr::OnMapUpdate(Map* map, uint32 diff)
     ASSERT(map);
 
     SCR_MAP_BGN(WorldMapScript, map, itr, end, entry, IsWorldMap);
+        ProfileScope profile(PROFILE_SCRIPT, itr->second->GetName().c_str(), map->GetId());
         itr->second->OnUpdate(map, diff);
     SCR_MAP_END;
 
     SCR_MAP_BGN(InstanceMapScript, map, itr, end, entry, IsDungeon);
+        ProfileScope profile(PROFILE_SCRIPT, itr->second->GetName().c_str(), map->GetId());
         itr->second->OnUpdate((InstanceMap*)map, diff);
     SCR_MAP_END;
 
     SCR_MAP_BGN(BattlegroundMapScript, map, itr, end, entry, IsBattleground);
+        ProfileScope profile(PROFILE_SCRIPT, itr->second->GetName().c_str(), map->GetId());
         itr->second->OnUpdate((BattlegroundMap*)map, diff);
     SCR_MAP_END;
 }
@@ -856,6 +869,7 @@ void ScriptMgr::OnCreatureUpdate(Creature* creature, uint32 diff)
     ASSERT(creature);
 
     GET_SCRIPT(CreatureScript, creature->GetScriptId(), tmpscript);
+    ProfileScope profile(PROFILE_SCRIPT, tmpscript->GetName().c_str(), creature->GetEntry());
     tmpscript->OnUpdate(creature, diff);
 }
 
@@ -958,6 +972,7 @@ void ScriptMgr::OnGameObjectUpdate(GameObject* go, uint32 diff)
     ASSERT(go);
 
     GET_SCRIPT(GameObjectScript, go->GetScriptId(), tmpscript);
+    ProfileScope profile(PROFILE_SCRIPT, tmpscript->GetName().c_str(), go->GetEntry());
     tmpscript->OnUpdate(go, diff);
 }
 
@@ -0,0 +1,155 @@
+/*
+ * Copyright (C) 2008-2012 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PlayerLoginLoader.h"
+
+#include <ace/Guard_T.h>
+
+#include <algorithm>
+
+PlayerLoginLoader::PlayerLoginLoader() : m_mutex(), m_condition(m_mutex), m_activated(false), m_stopping(false)
+{
+}
+
+PlayerLoginLoader::~PlayerLoginLoader()
+{
+    deactivate();
+}
+
+int PlayerLoginLoader::activate(size_t num_threads)
+{
+    if (activated() || num_threads < 1)
+        return -1;
+
+    m_stopping = false;
+
+    if (ACE_Task_Base::activate(THR_NEW_LWP | THR_JOINABLE | THR_INHERIT_SCHED, int(num_threads)) == -1)
+        return -1;
+
+    m_activated = true;
+    return 0;
+}
+
+int PlayerLoginLoader::deactivate()
+{
+    if (!activated())
+        return -1;
+
+    {
+        TRINITY_GUARD(ACE_Thread_Mutex, m_mutex);
+        m_stopping = true;
+        m_condition.broadcast();
+    }
+
+    ACE_Task_Base::wait();
+
+    m_activated = false;
+
+    // their sessions never get the futures set
+    for (std::deque<LoadRequest>::const_iterator itr = m_queue.begin(); itr != m_queue.end(); ++itr)
+        delete itr->first;
+
+    m_queue.clear();
+    return 0;
+}
+
+bool PlayerLoginLoader::activated()
+{
+    return m_activated;
+}
+
+QueryResultHolderFuture PlayerLoginLoader::Load(LoginHolder* holder)
+{
+    QueryResultHolderFuture result;
+
+    if (!activated())
+    {
+        holder->LoadResults();
+        result.set(holder);
+        return result;
+    }
+
+    TRINITY_GUARD(ACE_Thread_Mutex, m_mutex);
+    m_queue.push_back(LoadRequest(holder, result));
+    m_condition.signal();
+    return result;
+}
+
+void PlayerLoginLoader::Cancel(QueryResultHolderFuture const& result)
+{
+    TRINITY_GUARD(ACE_Thread_Mutex, m_mutex);
+
+    for (std::deque<LoadRequest>::iterator itr = m_queue.begin(); itr != m_queue.end(); ++itr)
+    {
+        if (itr->second == result)
+        {
+            delete itr->first;
+            m_queue.erase(itr);
+            return;
+        }
+    }
+
+    if (std::find(m_loading.begin(), m_loading.end(), result) != m_loading.end())
+    {
+        m_cancelled.push_back(result);
+        return;
+    }
+
+    // futures are set under the lock, a loaded holder is not handed to the session anymore
+    if (result.ready())
+    {
+        SQLQueryHolder* holder = NULL;
+        result.get(holder);
+        delete holder;
+    }
+}
+
+int PlayerLoginLoader::svc()
+{
+    for (;;)
+    {
+        LoadRequest request;
+
+        {
+            TRINITY_GUARD(ACE_Thread_Mutex, m_mutex);
+
+            while (m_queue.empty() && !m_stopping)
+                m_condition.wait();
+
+            if (m_stopping)
+                return 0;
+
+            request = m_queue.front();
+            m_queue.pop_front();
+            m_loading.push_back(request.second);
+        }
+
+        request.first->LoadResults();
+
+        TRINITY_GUARD(ACE_Thread_Mutex, m_mutex);
+        m_loading.erase(std::find(m_loading.begin(), m_loading.end(), request.second));
+
+        std::vector<QueryResultHolderFuture>::iterator cancelled = std::find(m_cancelled.begin(), m_cancelled.end(), request.second);
+        if (cancelled != m_cancelled.end())
+        {
+            m_cancelled.erase(cancelled);
+            delete request.first;
+        }
+        else
+            request.second.set(request.first);
+    }
+}
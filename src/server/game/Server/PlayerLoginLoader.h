@@ -0,0 +1,71 @@
+/*
+ * Copyright (C) 2008-2012 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_PLAYERLOGINLOADER_H
+#define TRINITY_PLAYERLOGINLOADER_H
+
+#include "Common.h"
+#include "DatabaseEnv.h"
+
+#include <ace/Task.h>
+#include <ace/Thread_Mutex.h>
+#include <ace/Condition_Thread_Mutex.h>
+
+#include <deque>
+#include <vector>
+
+// Second stage of a character login, between the login queries and WorldSession::HandlePlayerLogin.
+// Once the queries of a login returned, the session hands its holder to Load. A loader thread deserializes the
+// parts of the character that do not depend on the world (items, achievement progress) and sets the returned
+// future; the session then creates the player and adds it to its map on the world thread.
+class PlayerLoginLoader : protected ACE_Task_Base
+{
+    public:
+        // query holder of a login, LoadResults is called on a loader thread after its queries returned
+        class LoginHolder : public SQLQueryHolder
+        {
+            public:
+                virtual void LoadResults() = 0;
+        };
+
+        PlayerLoginLoader();
+        virtual ~PlayerLoginLoader();
+
+        int activate(size_t num_threads);
+        int deactivate();                                   // holders not loaded yet are deleted
+        bool activated();
+
+        // the future is set to the holder once its results are loaded, right away if no loader thread runs
+        QueryResultHolderFuture Load(LoginHolder* holder);
+        // for sessions that go away during the login, the holder of the future is deleted whether it is loaded yet or not
+        void Cancel(QueryResultHolderFuture const& result);
+
+        virtual int svc();
+
+    private:
+        typedef std::pair<LoginHolder*, QueryResultHolderFuture> LoadRequest;
+
+        ACE_Thread_Mutex m_mutex;
+        ACE_Condition_Thread_Mutex m_condition;             // signaled when holders are queued or the workers stop
+        std::deque<LoadRequest> m_queue;
+        std::vector<QueryResultHolderFuture> m_loading;     // futures of the holders the workers load right now
+        std::vector<QueryResultHolderFuture> m_cancelled;   // loading ones whose holders are deleted instead of set
+        bool m_activated;
+        bool m_stopping;
+};
+
+#endif
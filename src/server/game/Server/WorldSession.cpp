@@ -44,6 +44,7 @@
 #include "Transport.h"
 #include "WardenWin.h"
 #include "WardenMac.h"
+#include "TickProfiler.h"
 
 bool MapSessionFilter::Process(WorldPacket* packet)
 {
@@ -89,14 +90,14 @@ bool WorldSessionFilter::Process(WorldPacket* packet)
 
 /// WorldSession constructor
 WorldSession::WorldSession(uint32 id, WorldSocket* sock, AccountTypes sec, uint8 expansion, time_t mute_time, LocaleConstant locale, uint32 recruiter, bool isARecruiter):
-m_muteTime(mute_time), m_timeOutTime(0), _player(NULL), m_Socket(sock),
+m_muteTime(mute_time), m_timeOutTime(0), m_GUIDLow(0), m_charListGuidLow(0), _player(NULL), m_Socket(sock),
 _security(sec), _accountId(id), m_expansion(expansion), _logoutTime(0),
 m_inQueue(false), m_playerLoading(false), m_playerLogout(false),
 m_playerRecentlyLogout(false), m_playerSave(false),
 m_sessionDbcLocale(sWorld->GetAvailableDbcLocale(locale)),
 m_sessionDbLocaleIndex(locale),
 m_latency(0), m_TutorialsChanged(false), recruiterId(recruiter),
-isRecruiter(isARecruiter), timeLastWhoCommand(0)
+isRecruiter(isARecruiter), timeLastWhoCommand(0), _recvSpilled(0)
 {
     _warden = NULL;
 
@@ -134,6 +135,19 @@ WorldSession::~WorldSession()
     while (_recvQueue.next(packet))
         delete packet;
 
+    for (std::deque<WorldPacket*>::const_iterator itr = _recvSpill.begin(); itr != _recvSpill.end(); ++itr)
+        delete *itr;
+
+    ///- drop a character login still in progress, its holder owns the items loaded for the character
+    if (_charLoginCallback.ready())
+    {
+        SQLQueryHolder* holder = NULL;
+        _charLoginCallback.get(holder);
+        delete holder;
+    }
+
+    sWorld->GetPlayerLoginLoader()->Cancel(_charLoginLoadCallback);
+
     LoginDatabase.PExecute("UPDATE account SET online = 0 WHERE id = %u;", GetAccountId());     // One-time query
 }
 
@@ -199,10 +213,51 @@ void WorldSession::SendPacket(WorldPacket const* packet)
         m_Socket->CloseSocket();
 }
 
-/// Add an incoming packet to the queue
-void WorldSession::QueuePacket(WorldPacket* new_packet)
+/// Add an incoming packet to the queue, the packet is deleted if the client floods the session
+bool WorldSession::QueuePacket(WorldPacket* new_packet)
+{
+    if (!ACE_Based::LockFree::Load(_recvSpilled) && _recvQueue.add(new_packet))
+        return true;
+
+    TRINITY_GUARD(ACE_Thread_Mutex, _recvSpillLock);
+
+    if (_recvSpill.size() >= MAX_SPILLED_PACKETS)
+    {
+        sLog->outError("WorldSession::QueuePacket: account %u sent more than %u packets without them being handled, dropping opcode %s (0x%.4X)",
+            GetAccountId(), uint32(MAX_QUEUED_PACKETS + MAX_SPILLED_PACKETS), LookupOpcodeName(new_packet->GetOpcode()), new_packet->GetOpcode());
+        delete new_packet;
+        return false;
+    }
+
+    _recvSpill.push_back(new_packet);
+    ACE_Based::LockFree::Store(_recvSpilled, 1);
+    return true;
+}
+
+/// Re-add a packet that can not be handled yet, never drops it
+void WorldSession::SpillPacket(WorldPacket* packet)
 {
-    _recvQueue.add(new_packet);
+    if (!ACE_Based::LockFree::Load(_recvSpilled) && _recvQueue.add(packet))
+        return;
+
+    TRINITY_GUARD(ACE_Thread_Mutex, _recvSpillLock);
+    _recvSpill.push_back(packet);
+    ACE_Based::LockFree::Store(_recvSpilled, 1);
+}
+
+/// Move spilled packets back to the receive queue, they are newer than all packets in it
+void WorldSession::RefillRecvQueue()
+{
+    if (!ACE_Based::LockFree::Load(_recvSpilled))
+        return;
+
+    TRINITY_GUARD(ACE_Thread_Mutex, _recvSpillLock);
+
+    while (!_recvSpill.empty() && _recvQueue.add(_recvSpill.front()))
+        _recvSpill.pop_front();
+
+    if (_recvSpill.empty())
+        ACE_Based::LockFree::Store(_recvSpilled, 0);
 }
 
 /// Logging helper for unexpected opcodes
@@ -234,6 +289,7 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
 
     ///- Retrieve packets from the receive queue and call the appropriate handlers
     /// not process packets if socket already closed
+    RefillRecvQueue();
     WorldPacket* packet = NULL;
     //! Delete packet after processing by default
     bool deletePacket = true;
@@ -245,7 +301,7 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
     //! loop caused by re-enqueueing the same packets over and over again, we stop updating this session
     //! and continue updating others. The re-enqueued packets will be handled in the next Update call for this session.
     while (m_Socket && !m_Socket->IsClosed() &&
-            !_recvQueue.empty() && _recvQueue.peek(true) != firstDelayedPacket &&
+            !_recvQueue.empty() && _recvQueue.peek() != firstDelayedPacket &&
             _recvQueue.next(packet, updater))
     {
         if (packet->GetOpcode() >= NUM_MSG_TYPES)
@@ -258,6 +314,7 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
             OpcodeHandler &opHandle = opcodeTable[packet->GetOpcode()];
             try
             {
+                ProfileScope profile(PROFILE_OPCODE, opHandle.name, packet->GetOpcode());
                 switch (opHandle.status)
                 {
                     case STATUS_LOGGEDIN:
@@ -268,15 +325,15 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
                             //! the client to be in world yet. We will re-add the packets to the bottom of the queue and process them later.
                             if (!m_playerRecentlyLogout)
                             {
-                                //! Prevent infinite loop
-                                if (!firstDelayedPacket)
-                                    firstDelayedPacket = packet;
-                                //! Because checking a bool is faster than reallocating memory
-                                deletePacket = false;
-                                QueuePacket(packet);
                                 //! Log
                                 sLog->outDebug(LOG_FILTER_NETWORKIO, "Re-enqueueing packet with opcode %s (0x%.4X) with with status STATUS_LOGGEDIN. "
                                     "Player is currently not in world yet.", opHandle.name, packet->GetOpcode());
+                                //! Because checking a bool is faster than reallocating memory
+                                deletePacket = false;
+                                //! Prevent infinite loop
+                                if (!firstDelayedPacket)
+                                    firstDelayedPacket = packet;
+                                SpillPacket(packet);
                             }
 
                         }
@@ -359,6 +416,9 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
 
         if (deletePacket)
             delete packet;
+
+        if (_recvQueue.empty())
+            RefillRecvQueue();
     }
 
     if (m_Socket && !m_Socket->IsClosed() && _warden)
@@ -552,7 +612,7 @@ void WorldSession::LogoutPlayer(bool Save)
         //! Since each account can only have one online character at any given time, ensure all characters for active account are marked as offline
         PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_UPD_ACCOUNT_ONLINE);
         stmt->setUInt32(0, GetAccountId());
-        CharacterDatabase.Execute(stmt);
+        CharacterDatabase.Execute(stmt, m_GUIDLow);
     }
 
     m_playerLogout = false;
@@ -1060,7 +1120,7 @@ void WorldSession::SetPlayer(Player* player)
 
     // set m_GUID that can be used while player loggined and later until m_playerRecentlyLogout not reset
     if (_player)
-        m_GUIDLow = _player->GetGUIDLow();
+        m_GUIDLow = m_charListGuidLow = _player->GetGUIDLow();
 }
 
 void WorldSession::InitializeQueryCallbackParameters()
@@ -1094,10 +1154,19 @@ void WorldSession::ProcessQueryCallbacks()
     {
         SQLQueryHolder* param;
         _charLoginCallback.get(param);
-        HandlePlayerLogin((LoginQueryHolder*)param);
+        _charLoginLoadCallback = sWorld->GetPlayerLoginLoader()->Load(static_cast<PlayerLoginLoader::LoginHolder*>(param));
         _charLoginCallback.cancel();
     }
 
+    // logins past the limit of this update wait with their loaded holder for the next one
+    if (_charLoginLoadCallback.ready() && sWorld->CanFinishPlayerLogin())
+    {
+        SQLQueryHolder* param;
+        _charLoginLoadCallback.get(param);
+        HandlePlayerLogin((LoginQueryHolder*)param);
+        _charLoginLoadCallback.cancel();
+    }
+
     //! HandleAddFriendOpcode
     if (_addFriendCallback.IsReady())
     {
@@ -76,6 +76,11 @@ enum AccountDataType
 #define GLOBAL_CACHE_MASK           0x15
 #define PER_CHARACTER_CACHE_MASK    0xEA
 
+// received packets waiting for their handlers, more are spilled to a locked list
+#define MAX_QUEUED_PACKETS          256
+// spilled packets of a session, a client sending more is disconnected
+#define MAX_SPILLED_PACKETS         4096
+
 struct AccountData
 {
     AccountData() : Time(0), Data("") {}
@@ -276,7 +281,7 @@ class WorldSession
         void LogoutPlayer(bool Save);
         void KickPlayer();
 
-        void QueuePacket(WorldPacket* new_packet);
+        bool QueuePacket(WorldPacket* new_packet);          // false if the client floods, the packet is deleted then
         bool Update(uint32 diff, PacketFilter& updater);
 
         /// Handle the authentication waiting queue (to be completed)
@@ -929,12 +934,16 @@ class WorldSession
         QueryCallback<PreparedQueryResult, uint64> _sendStabledPetCallback;
         QueryCallback<PreparedQueryResult, CharacterCreateInfo*, true> _charCreateCallback;
         QueryResultHolderFuture _charLoginCallback;
+        QueryResultHolderFuture _charLoginLoadCallback;     // set by the PlayerLoginLoader after _charLoginCallback
 
     private:
         // private trade methods
         void moveItems(Item* myItems[], Item* hisItems[]);
 
-        // logging helper
+        // packets that do not fit _recvQueue wait in _recvSpill
+        void SpillPacket(WorldPacket* packet);
+        void RefillRecvQueue();
+
         void LogUnexpectedOpcode(WorldPacket* packet, const char* status, const char *reason);
         void LogUnprocessedTail(WorldPacket* packet);
 
@@ -949,6 +958,7 @@ class WorldSession
         std::set<uint32> _allowedCharsToLogin;
 
         uint32 m_GUIDLow;                                   // set loggined or recently logout player (while m_playerRecentlyLogout set)
+        uint32 m_charListGuidLow;                           // last character written from this session, the character screen queries run after its statements
         Player* _player;
         WorldSocket* m_Socket;
         std::string m_Address;
@@ -977,7 +987,11 @@ class WorldSession
         AddonsList m_addonsList;
         uint32 recruiterId;
         bool isRecruiter;
-        ACE_Based::LockedQueue<WorldPacket*, ACE_Thread_Mutex> _recvQueue;
+        ACE_Based::LockFreeQueue<WorldPacket*, MAX_QUEUED_PACKETS> _recvQueue;
+        // packets that did not fit into _recvQueue, while any are spilled new packets are spilled as well to keep their order
+        std::deque<WorldPacket*> _recvSpill;
+        ACE_Thread_Mutex _recvSpillLock;
+        volatile long _recvSpilled;                         // _recvSpill is not empty, read without the lock
         time_t timeLastWhoCommand;
 };
 #endif
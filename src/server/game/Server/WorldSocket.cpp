@@ -23,6 +23,8 @@
 #include <ace/os_include/netinet/os_tcp.h>
 #include <ace/os_include/sys/os_types.h>
 #include <ace/os_include/sys/os_socket.h>
+#include <ace/os_include/sys/os_uio.h>
+#include <ace/OS_NS_sys_socket.h>
 #include <ace/OS_NS_string.h>
 #include <ace/Reactor.h>
 #include <ace/Auto_Ptr.h>
@@ -163,13 +165,38 @@ int WorldSocket::SendPacket(WorldPacket const& pct)
     if (sPacketLog->CanLogPacket())
         sPacketLog->LogPacket(pct, SERVER_TO_CLIENT);
 
-    // Create a copy of the original packet; this is to avoid issues if a hook modifies it.
-    sScriptMgr->OnPacketSend(this, WorldPacket(pct));
+    sScriptMgr->OnPacketSend(this, pct);
 
     ServerPktHeader header(pct.size()+2, pct.GetOpcode());
     m_Crypt.EncryptSend ((uint8*)header.header, header.getHeaderLength());
 
-    if (m_OutBuffer->space() >= pct.size() + header.getHeaderLength() && msg_queue()->is_empty())
+    // Broadcasts reference one copy of the contents from all sockets, only the header is our own.
+    ACE_Message_Block* contents = NULL;
+    if (pct.size() >= MIN_SHARED_PACKET_SIZE)
+        contents = pct.GetSharedContents();
+
+    if (contents)
+    {
+        ACE_Message_Block* mb;
+
+        ACE_NEW_NORETURN(mb, ACE_Message_Block(header.getHeaderLength()));
+        if (!mb)
+        {
+            contents->release();
+            return -1;
+        }
+
+        mb->copy((char*) header.header, header.getHeaderLength());
+        mb->cont(contents);
+
+        if (msg_queue()->enqueue_tail(mb, (ACE_Time_Value*)&ACE_Time_Value::zero) == -1)
+        {
+            sLog->outError("WorldSocket::SendPacket enqueue_tail failed");
+            mb->release();
+            return -1;
+        }
+    }
+    else if (m_OutBuffer->space() >= pct.size() + header.getHeaderLength() && msg_queue()->is_empty())
     {
         // Put the packet on the buffer.
         if (m_OutBuffer->copy((char*) header.header, header.getHeaderLength()) == -1)
@@ -325,15 +352,50 @@ int WorldSocket::handle_output (ACE_HANDLE)
     if (closing_)
         return -1;
 
-    size_t send_len = m_OutBuffer->length();
+    // Gather the buffer and the queued packets into one write. A queued packet
+    // is either one block or its header followed by the shared contents.
+    iovec iov[MAX_OUTPUT_IOVECS];
+    int iovcnt = 0;
+    size_t send_len = 0;
+
+    if (m_OutBuffer->length() > 0)
+    {
+        iov[iovcnt].iov_base = m_OutBuffer->rd_ptr();
+        iov[iovcnt].iov_len = m_OutBuffer->length();
+        send_len += m_OutBuffer->length();
+        ++iovcnt;
+    }
+
+    ACE_Message_Block* mblk = NULL;
+    if (!msg_queue()->is_empty())
+        msg_queue()->peek_dequeue_head(mblk, (ACE_Time_Value*)&ACE_Time_Value::zero);
+
+    for (; mblk && iovcnt < MAX_OUTPUT_IOVECS; mblk = mblk->next())
+    {
+        for (ACE_Message_Block* block = mblk; block && iovcnt < MAX_OUTPUT_IOVECS; block = block->cont())
+        {
+            if (block->length() == 0)
+                continue;
+
+            iov[iovcnt].iov_base = block->rd_ptr();
+            iov[iovcnt].iov_len = block->length();
+            send_len += block->length();
+            ++iovcnt;
+        }
+    }
 
     if (send_len == 0)
-        return handle_output_queue(Guard);
+        return cancel_wakeup_output(Guard);
 
 #ifdef MSG_NOSIGNAL
-    ssize_t n = peer().send (m_OutBuffer->rd_ptr(), send_len, MSG_NOSIGNAL);
+    msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = iov;
+    msg.msg_iovlen = iovcnt;
+
+    ssize_t n = ACE_OS::sendmsg (get_handle(), &msg, MSG_NOSIGNAL);
 #else
-    ssize_t n = peer().send (m_OutBuffer->rd_ptr(), send_len);
+    ssize_t n = peer().sendv (iov, iovcnt);
 #endif // MSG_NOSIGNAL
 
     if (n == 0)
@@ -345,84 +407,58 @@ int WorldSocket::handle_output (ACE_HANDLE)
 
         return -1;
     }
-    else if (n < (ssize_t)send_len) //now n > 0
-    {
-        m_OutBuffer->rd_ptr (static_cast<size_t> (n));
 
-        // move the data to the base of the buffer
-        m_OutBuffer->crunch();
+    size_t sent = static_cast<size_t> (n);
 
-        return schedule_wakeup_output (Guard);
-    }
-    else //now n == send_len
+    if (m_OutBuffer->length() > 0)
     {
-        m_OutBuffer->reset();
-
-        return handle_output_queue (Guard);
-    }
-
-    ACE_NOTREACHED (return 0);
-}
-
-int WorldSocket::handle_output_queue (GuardType& g)
-{
-    if (msg_queue()->is_empty())
-        return cancel_wakeup_output(g);
+        size_t len = std::min(sent, m_OutBuffer->length());
+        m_OutBuffer->rd_ptr(len);
+        sent -= len;
 
-    ACE_Message_Block* mblk;
-
-    if (msg_queue()->dequeue_head(mblk, (ACE_Time_Value*)&ACE_Time_Value::zero) == -1)
-    {
-        sLog->outError("WorldSocket::handle_output_queue dequeue_head");
-        return -1;
+        if (m_OutBuffer->length() == 0)
+            m_OutBuffer->reset();
+        else
+        {
+            // move the data to the base of the buffer
+            m_OutBuffer->crunch();
+        }
     }
 
-    const size_t send_len = mblk->length();
-
-#ifdef MSG_NOSIGNAL
-    ssize_t n = peer().send (mblk->rd_ptr(), send_len, MSG_NOSIGNAL);
-#else
-    ssize_t n = peer().send (mblk->rd_ptr(), send_len);
-#endif // MSG_NOSIGNAL
-
-    if (n == 0)
+    // drop the packets that were written, keep the rest of a partially written one at the head
+    while (sent > 0)
     {
-        mblk->release();
-
-        return -1;
-    }
-    else if (n == -1)
-    {
-        if (errno == EWOULDBLOCK || errno == EAGAIN)
+        if (msg_queue()->dequeue_head(mblk, (ACE_Time_Value*)&ACE_Time_Value::zero) == -1)
         {
-            msg_queue()->enqueue_head(mblk, (ACE_Time_Value*) &ACE_Time_Value::zero);
-            return schedule_wakeup_output (g);
+            sLog->outError("WorldSocket::handle_output dequeue_head");
+            return -1;
         }
 
-        mblk->release();
-        return -1;
-    }
-    else if (n < (ssize_t)send_len) //now n > 0
-    {
-        mblk->rd_ptr(static_cast<size_t> (n));
-
-        if (msg_queue()->enqueue_head(mblk, (ACE_Time_Value*) &ACE_Time_Value::zero) == -1)
+        for (ACE_Message_Block* block = mblk; block && sent > 0; block = block->cont())
         {
-            sLog->outError("WorldSocket::handle_output_queue enqueue_head");
-            mblk->release();
-            return -1;
+            size_t len = std::min(sent, block->length());
+            block->rd_ptr(len);
+            sent -= len;
         }
 
-        return schedule_wakeup_output (g);
+        if (mblk->total_length() > 0)
+        {
+            if (msg_queue()->enqueue_head(mblk, (ACE_Time_Value*) &ACE_Time_Value::zero) == -1)
+            {
+                sLog->outError("WorldSocket::handle_output enqueue_head");
+                mblk->release();
+                return -1;
+            }
+        }
+        else
+            mblk->release();
     }
-    else //now n == send_len
-    {
-        mblk->release();
 
-        return msg_queue()->is_empty() ? cancel_wakeup_output(g) : ACE_Event_Handler::WRITE_MASK;
-    }
+    if (size_t(n) < send_len)
+        return schedule_wakeup_output (Guard);
 
-    ACE_NOTREACHED(return -1);
+    // everything gathered was written, more packets may be queued than fit into one write
+    return msg_queue()->is_empty() ? cancel_wakeup_output(Guard) : ACE_Event_Handler::WRITE_MASK;
 }
 
 int WorldSocket::handle_close (ACE_HANDLE h, ACE_Reactor_Mask)
@@ -707,7 +743,10 @@ int WorldSocket::ProcessIncoming(WorldPacket* new_pct)
                     aptr.release();
                     // WARNINIG here we call it with locks held.
                     // Its possible to cause deadlock if QueuePacket calls back
-                    m_Session->QueuePacket (new_pct);
+                    // A client flooding far faster than its session is updated gets disconnected
+                    if (!m_Session->QueuePacket (new_pct))
+                        return -1;
+
                     return 0;
                 }
                 else
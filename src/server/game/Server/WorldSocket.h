@@ -69,6 +69,11 @@ typedef ACE_Svc_Handler<ACE_SOCK_STREAM, ACE_NULL_SYNCH> WorldHandler;
  * sending packets from "producer" threads is minimal,
  * and doing a lot of writes with small size is tolerated.
  *
+ * Packets that are broadcast to many sockets are not copied, see
+ * WorldPacket::BeginShare: the queue then holds the encrypted header
+ * followed by a reference to the contents shared by all receivers, and
+ * the buffer and queue are written with one gathering write.
+ *
  * The calls to Update() method are managed by WorldSocketMgr
  * and ReactorRunnable.
  *
@@ -148,9 +153,6 @@ class WorldSocket : public WorldHandler
         int cancel_wakeup_output (GuardType& g);
         int schedule_wakeup_output (GuardType& g);
 
-        /// Drain the queue if its not empty.
-        int handle_output_queue (GuardType& g);
-
         /// process one incoming packet.
         /// @param new_pct received packet, note that you need to delete it.
         int ProcessIncoming (WorldPacket* new_pct);
@@ -162,6 +164,15 @@ class WorldSocket : public WorldHandler
         int HandlePing (WorldPacket& recvPacket);
 
     private:
+        enum
+        {
+            /// Buffers written by one handle_output() call.
+            MAX_OUTPUT_IOVECS = 64,
+
+            /// Smaller packets are cheaper to copy into m_OutBuffer than to share.
+            MIN_SHARED_PACKET_SIZE = 128
+        };
+
         /// Time in which the last ping was received
         ACE_Time_Value m_LastPingTime;
 
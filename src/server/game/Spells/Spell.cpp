@@ -1081,8 +1081,10 @@ void Spell::SelectImplicitConeTargets(SpellEffIndex effIndex, SpellImplicitTarge
                     gObjTargets.push_back(gObjTarget);
             }
 
+            CacheLineOfSight(unitTargets);
             for (std::list<Unit*>::iterator itr = unitTargets.begin(); itr != unitTargets.end(); ++itr)
                 AddUnitTarget(*itr, effMask, false);
+            m_targetsInLineOfSight.clear();
 
             for (std::list<GameObject*>::iterator itr = gObjTargets.begin(); itr != gObjTargets.end(); ++itr)
                 AddGOTarget(*itr, effMask);
@@ -1355,8 +1357,10 @@ void Spell::SelectImplicitAreaTargets(SpellEffIndex effIndex, SpellImplicitTarge
             Trinity::Containers::RandomResizeList(unitTargets, maxTargets);
         }
 
+        CacheLineOfSight(unitTargets);
         for (std::list<Unit*>::iterator itr = unitTargets.begin(); itr != unitTargets.end(); ++itr)
             AddUnitTarget(*itr, effMask, false);
+        m_targetsInLineOfSight.clear();
     }
 
     if (!gObjTargets.empty())
@@ -1594,8 +1598,10 @@ void Spell::SelectImplicitChainTargets(SpellEffIndex effIndex, SpellImplicitTarg
             if (Unit* unitTarget = (*itr)->ToUnit())
                 unitTargets.push_back(unitTarget);
 
+        CacheLineOfSight(unitTargets);
         for (std::list<Unit*>::iterator itr = unitTargets.begin(); itr != unitTargets.end(); ++itr)
             AddUnitTarget(*itr, effMask, false);
+        m_targetsInLineOfSight.clear();
     }
 }
 
@@ -6487,20 +6493,66 @@ bool Spell::CheckEffectTarget(Unit const* target, uint32 eff) const
             // all ok by some way or another, skip normal check
             break;
         default:                                            // normal case
-            // Get GO cast coordinates if original caster -> GO
-            WorldObject* caster = NULL;
-            if (IS_GAMEOBJECT_GUID(m_originalCasterGUID))
-                caster = m_caster->GetMap()->GetGameObject(m_originalCasterGUID);
-            if (!caster)
-                caster = m_caster;
-            if (target != m_caster && !target->IsWithinLOSInMap(caster))
-                return false;
+            if (target != m_caster)
+            {
+                LineOfSightMap::const_iterator itr = m_targetsInLineOfSight.find(target->GetGUID());
+                if (itr != m_targetsInLineOfSight.end() ? !itr->second : !target->IsWithinLOSInMap(GetLineOfSightSource()))
+                    return false;
+            }
             break;
     }
 
     return true;
 }
 
+WorldObject* Spell::GetLineOfSightSource() const
+{
+    // Get GO cast coordinates if original caster -> GO
+    WorldObject* caster = NULL;
+    if (IS_GAMEOBJECT_GUID(m_originalCasterGUID))
+        caster = m_caster->GetMap()->GetGameObject(m_originalCasterGUID);
+    if (!caster)
+        caster = m_caster;
+    return caster;
+}
+
+void Spell::CacheLineOfSight(std::list<Unit*> const& targets)
+{
+    // same conditions as the check in CheckEffectTarget
+    if (IsTriggered() || m_spellInfo->AttributesEx2 & SPELL_ATTR2_CAN_TARGET_NOT_IN_LOS || targets.size() < 2)
+        return;
+
+    WorldObject* caster = GetLineOfSightSource();
+
+    // the segments of WorldObject::IsWithinLOSInMap, targets it does not test in the map are left to it
+    std::vector<Unit*> units;
+    std::vector<G3D::Vector3> from;
+    std::vector<G3D::Vector3> to;
+    std::vector<uint32> phasemasks;
+    for (std::list<Unit*>::const_iterator itr = targets.begin(); itr != targets.end(); ++itr)
+    {
+        Unit* target = *itr;
+        if (target == m_caster || !target->IsInWorld() || !target->IsInMap(caster))
+            continue;
+
+        units.push_back(target);
+        from.push_back(G3D::Vector3(target->GetPositionX(), target->GetPositionY(), target->GetPositionZ() + 2.0f));
+        to.push_back(G3D::Vector3(caster->GetPositionX(), caster->GetPositionY(), caster->GetPositionZ() + 2.0f));
+        phasemasks.push_back(target->GetPhaseMask());
+    }
+
+    if (units.size() < 2)
+        return;
+
+    bool* results = new bool[units.size()];
+    caster->GetMap()->isInLineOfSight(&from[0], &to[0], &phasemasks[0], uint32(units.size()), results);
+
+    for (size_t i = 0; i < units.size(); ++i)
+        m_targetsInLineOfSight[units[i]->GetGUID()] = results[i];
+
+    delete[] results;
+}
+
 bool Spell::IsNextMeleeSwingSpell() const
 {
     return m_spellInfo->Attributes & SPELL_ATTR0_ON_NEXT_SWING;
@@ -596,6 +596,14 @@ class Spell
 
         SpellDestination m_destTargets[MAX_SPELL_EFFECTS];
 
+        // line of sight of implicit area and chain targets to the caster, tested for all of them at once
+        // by CacheLineOfSight before they are added and used by CheckEffectTarget
+        typedef UNORDERED_MAP<uint64, bool> LineOfSightMap;
+        LineOfSightMap m_targetsInLineOfSight;
+
+        void CacheLineOfSight(std::list<Unit*> const& targets);
+        WorldObject* GetLineOfSightSource() const;
+
         void AddUnitTarget(Unit* target, uint32 effectMask, bool checkIfValid = true, bool implicit = true);
         void AddGOTarget(GameObject* target, uint32 effectMask);
         void AddItemTarget(Item* item, uint32 effectMask);
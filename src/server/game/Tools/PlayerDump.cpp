@@ -671,7 +671,7 @@ DumpReturn PlayerDumpReader::LoadDump(const std::string& file, uint32 account, s
         trans->Append(line.c_str());
     }
 
-    CharacterDatabase.CommitTransaction(trans);
+    CharacterDatabase.CommitTransaction(trans, guid);
 
     // in case of name conflict player has to rename at login anyway
     sWorld->AddCharacterNameData(guid, name, gender, race, playerClass);
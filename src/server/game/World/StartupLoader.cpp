@@ -0,0 +1,153 @@
+/*
+ * Copyright (C) 2008-2012 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "StartupLoader.h"
+#include "Common.h"
+#include "Log.h"
+#include "Timer.h"
+
+#include <ace/Guard_T.h>
+
+#include <algorithm>
+
+static bool StageTimeCompare(std::pair<uint32, char const*> const& left, std::pair<uint32, char const*> const& right)
+{
+    return left.first > right.first;
+}
+
+StartupLoader::StartupLoader() : _finished(0), _threads(1), _totalTime(0), _condition(_lock)
+{
+}
+
+StartupLoader::~StartupLoader()
+{
+    for (std::vector<StageInfo>::iterator itr = _stages.begin(); itr != _stages.end(); ++itr)
+        delete itr->Stage;
+}
+
+uint32 StartupLoader::AddStage(char const* name, StartupStage* stage, int32 dependency)
+{
+    uint32 index = uint32(_stages.size());
+    _stages.push_back(StageInfo(name, stage));
+
+    if (dependency >= 0)
+        AddDependency(index, uint32(dependency));
+
+    return index;
+}
+
+void StartupLoader::AddDependency(uint32 stage, uint32 dependency)
+{
+    ASSERT(dependency < stage && stage < _stages.size());
+
+    _stages[dependency].Dependents.push_back(stage);
+    ++_stages[stage].Dependencies;
+}
+
+void StartupLoader::LoadStage(uint32 index)
+{
+    StageInfo& info = _stages[index];
+
+    sLog->outString("Loading %s...", info.Name);
+
+    uint32 oldMSTime = getMSTime();
+    info.Stage->Load();
+    info.Time = GetMSTimeDiffToNow(oldMSTime);
+}
+
+void StartupLoader::Run(uint32 threads)
+{
+    uint32 oldMSTime = getMSTime();
+
+    _threads = std::max<uint32>(1, std::min<uint32>(threads, uint32(_stages.size())));
+
+    if (_threads == 1)
+    {
+        for (uint32 i = 0; i < _stages.size(); ++i)
+            LoadStage(i);
+    }
+    else
+    {
+        for (uint32 i = 0; i < _stages.size(); ++i)
+            if (!_stages[i].Dependencies)
+                _ready.push_back(i);
+
+        // stages added first are taken first, _ready is used as a stack
+        std::reverse(_ready.begin(), _ready.end());
+
+        if (activate(THR_NEW_LWP | THR_JOINABLE, int(_threads)) == -1)
+        {
+            sLog->outError("StartupLoader: can not start loader threads, loading sequentially");
+            _threads = 1;
+            for (uint32 i = 0; i < _stages.size(); ++i)
+                LoadStage(i);
+        }
+        else
+            wait();
+    }
+
+    _totalTime = GetMSTimeDiffToNow(oldMSTime);
+}
+
+int StartupLoader::svc()
+{
+    TRINITY_GUARD(ACE_Thread_Mutex, _lock);
+
+    while (_finished < _stages.size())
+    {
+        if (_ready.empty())
+        {
+            _condition.wait();
+            continue;
+        }
+
+        uint32 index = _ready.back();
+        _ready.pop_back();
+
+        _lock.release();
+        LoadStage(index);
+        _lock.acquire();
+
+        ++_finished;
+
+        std::vector<uint32> const& dependents = _stages[index].Dependents;
+        for (std::vector<uint32>::const_iterator itr = dependents.begin(); itr != dependents.end(); ++itr)
+            if (!--_stages[*itr].Dependencies)
+                _ready.push_back(*itr);
+
+        _condition.broadcast();
+    }
+
+    return 0;
+}
+
+void StartupLoader::ReportTimes() const
+{
+    std::vector<std::pair<uint32, char const*> > times;
+    uint32 sum = 0;
+    for (std::vector<StageInfo>::const_iterator itr = _stages.begin(); itr != _stages.end(); ++itr)
+    {
+        times.push_back(std::make_pair(itr->Time, itr->Name));
+        sum += itr->Time;
+    }
+
+    std::sort(times.begin(), times.end(), StageTimeCompare);
+
+    sLog->outString("Startup stages loaded in %u ms on %u threads (%u ms one after another):", _totalTime, _threads, sum);
+    for (std::vector<std::pair<uint32, char const*> >::const_iterator itr = times.begin(); itr != times.end(); ++itr)
+        sLog->outString("%8u ms  %s", itr->first, itr->second);
+}
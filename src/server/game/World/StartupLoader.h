@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2008-2012 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_STARTUPLOADER_H
+#define TRINITY_STARTUPLOADER_H
+
+#include "Define.h"
+
+#include <ace/Task.h>
+#include <ace/Thread_Mutex.h>
+#include <ace/Condition_Thread_Mutex.h>
+
+#include <vector>
+
+// One loading step of the server startup
+class StartupStage
+{
+    public:
+        virtual ~StartupStage() { }
+        virtual void Load() = 0;
+};
+
+template<class T>
+class StartupMemberStage : public StartupStage
+{
+    public:
+        StartupMemberStage(T* object, void (T::*loader)()) : _object(object), _loader(loader) { }
+        void Load() { (_object->*_loader)(); }
+
+    private:
+        T* _object;
+        void (T::*_loader)();
+};
+
+class StartupFunctionStage : public StartupStage
+{
+    public:
+        explicit StartupFunctionStage(void (*loader)()) : _loader(loader) { }
+        void Load() { _loader(); }
+
+    private:
+        void (*_loader)();
+};
+
+// Runs independent startup loaders concurrently.
+// Stages may only depend on stages added before them and run as soon as those are done, so the order
+// in which stages are added is always a valid order to run them one after another. Loaders running at
+// the same time must not write data used by each other; reading data loaded by earlier stages is fine.
+class StartupLoader : protected ACE_Task_Base
+{
+    public:
+        StartupLoader();
+        ~StartupLoader();
+
+        // The singleton is fetched by the caller, so it is created on the calling thread
+        template<class T>
+        uint32 AddStage(char const* name, T* object, void (T::*loader)(), int32 dependency = -1)
+        {
+            return AddStage(name, new StartupMemberStage<T>(object, loader), dependency);
+        }
+
+        uint32 AddStage(char const* name, void (*loader)(), int32 dependency = -1)
+        {
+            return AddStage(name, new StartupFunctionStage(loader), dependency);
+        }
+
+        void AddDependency(uint32 stage, uint32 dependency);
+
+        // Loads all stages, returns when all are done
+        void Run(uint32 threads);
+
+        // Logs the time of every stage, slowest first
+        void ReportTimes() const;
+
+        virtual int svc();
+
+    private:
+        struct StageInfo
+        {
+            StageInfo(char const* name, StartupStage* stage) : Name(name), Stage(stage), Dependencies(0), Time(0) { }
+
+            char const* Name;
+            StartupStage* Stage;
+            std::vector<uint32> Dependents;
+            uint32 Dependencies;                            // stages still to be loaded before this one
+            uint32 Time;                                    // ms
+        };
+
+        uint32 AddStage(char const* name, StartupStage* stage, int32 dependency);
+        void LoadStage(uint32 index);
+
+        std::vector<StageInfo> _stages;
+        std::vector<uint32> _ready;
+        uint32 _finished;
+        uint32 _threads;
+        uint32 _totalTime;                                  // ms, from the start of Run
+
+        ACE_Thread_Mutex _lock;
+        ACE_Condition_Thread_Mutex _condition;
+};
+
+#endif
@@ -78,6 +78,8 @@
 #include "Warden.h"
 #include "CalendarMgr.h"
 #include "TransportMgr.h"
+#include "TickProfiler.h"
+#include "StartupLoader.h"
 
 ACE_Atomic_Op<ACE_Thread_Mutex, bool> World::m_stopEvent = false;
 uint8 World::m_ExitCode = SHUTDOWN_EXIT_CODE;
@@ -113,6 +115,9 @@ World::World()
 
     m_updateTimeSum = 0;
     m_updateTimeCount = 0;
+    m_currentTime = 0;
+    m_phaseTimestamp = 0;
+    m_playerLoginsThisUpdate = 0;
 
     m_isClosed = false;
 
@@ -1140,6 +1145,7 @@ void World::LoadConfigSettings(bool reload)
 
     m_int_configs[CONFIG_MAX_WHO] = ConfigMgr::GetIntDefault("MaxWhoListReturns", 49);
     m_bool_configs[CONFIG_PET_LOS] = ConfigMgr::GetBoolDefault("vmap.petLOS", true);
+    m_int_configs[CONFIG_COLLISION_QUERY_CACHE_SIZE] = ConfigMgr::GetIntDefault("vmap.queryCacheSize", 4096);
     m_bool_configs[CONFIG_START_ALL_SPELLS] = ConfigMgr::GetBoolDefault("PlayerStart.AllSpells", false);
     if (m_bool_configs[CONFIG_START_ALL_SPELLS])
         sLog->outString("WORLD: WARNING: PlayerStart.AllSpells enabled - may not function as intended!");
@@ -1159,6 +1165,13 @@ void World::LoadConfigSettings(bool reload)
     m_int_configs[CONFIG_INTERVAL_LOG_UPDATE] = ConfigMgr::GetIntDefault("RecordUpdateTimeDiffInterval", 60000);
     m_int_configs[CONFIG_MIN_LOG_UPDATE] = ConfigMgr::GetIntDefault("MinRecordUpdateTimeDiff", 100);
     m_int_configs[CONFIG_NUMTHREADS] = ConfigMgr::GetIntDefault("MapUpdate.Threads", 1);
+    m_int_configs[CONFIG_STARTUP_LOADER_THREADS] = ConfigMgr::GetIntDefault("StartupLoader.Threads", 4);
+    m_int_configs[CONFIG_GRID_PRELOAD_THREADS] = ConfigMgr::GetIntDefault("MapUpdate.PreloadThreads", 1);
+    m_int_configs[CONFIG_LOGIN_LOADER_THREADS] = ConfigMgr::GetIntDefault("PlayerLogin.LoaderThreads", 2);
+    m_int_configs[CONFIG_MAX_LOGINS_PER_UPDATE] = ConfigMgr::GetIntDefault("PlayerLogin.MaxPerUpdate", 50);
+
+    m_bool_configs[CONFIG_TICK_PROFILER] = ConfigMgr::GetBoolDefault("Profiler.Enable", false);
+    sTickProfiler->SetEnabled(m_bool_configs[CONFIG_TICK_PROFILER]);
     m_int_configs[CONFIG_MAX_RESULTS_LOOKUP_COMMANDS] = ConfigMgr::GetIntDefault("Command.LookupMaxResults", 0);
 
     // chat logging
@@ -1513,30 +1526,36 @@ void World::SetInitialWorldSettings()
     sLog->outString("Loading Player level dependent mail rewards...");
     sObjectMgr->LoadMailLevelRewards();
 
-    // Loot tables
-    LoadLootTables();
+    ///- Loaders that only read the data loaded so far and do not depend on each other
+    StartupLoader loader;
+
+    loader.AddStage("Loot Tables", &LoadLootTables);
+    loader.AddStage("Skill Discovery Table", &LoadSkillDiscoveryTable);
+    loader.AddStage("Skill Extra Item Table", &LoadSkillExtraItemTable);
+    loader.AddStage("Skill Fishing base level requirements", sObjectMgr, &ObjectMgr::LoadFishingBaseSkillLevel);
+
+    uint32 achievements = loader.AddStage("Achievements", sAchievementMgr, &AchievementGlobalMgr::LoadAchievementReferenceList);
+    uint32 achievementCriteria = loader.AddStage("Achievement Criteria Lists", sAchievementMgr, &AchievementGlobalMgr::LoadAchievementCriteriaList, achievements);
+    loader.AddStage("Achievement Criteria Data", sAchievementMgr, &AchievementGlobalMgr::LoadAchievementCriteriaData, achievementCriteria);
+    uint32 achievementRewards = loader.AddStage("Achievement Rewards", sAchievementMgr, &AchievementGlobalMgr::LoadRewards, achievements);
+    loader.AddStage("Achievement Reward Locales", sAchievementMgr, &AchievementGlobalMgr::LoadRewardLocales, achievementRewards);
+    loader.AddStage("Completed Achievements", sAchievementMgr, &AchievementGlobalMgr::LoadCompletedAchievements, achievements);
 
-    sLog->outString("Loading Skill Discovery Table...");
-    LoadSkillDiscoveryTable();
+    loader.AddStage("ReservedNames", sObjectMgr, &ObjectMgr::LoadReservedPlayersNames);
+    loader.AddStage("BattleMasters", sBattlegroundMgr, &BattlegroundMgr::LoadBattleMastersEntry);
+    loader.AddStage("GameTeleports", sObjectMgr, &ObjectMgr::LoadGameTele);
 
-    sLog->outString("Loading Skill Extra Item Table...");
-    LoadSkillExtraItemTable();
+    uint32 gossipMenus = loader.AddStage("Gossip menu", sObjectMgr, &ObjectMgr::LoadGossipMenu);
+    loader.AddStage("Gossip menu options", sObjectMgr, &ObjectMgr::LoadGossipMenuItems, gossipMenus);
 
-    sLog->outString("Loading Skill Fishing base level requirements...");
-    sObjectMgr->LoadFishingBaseSkillLevel();
+    loader.AddStage("Waypoints", sWaypointMgr, &WaypointMgr::Load);
+    loader.AddStage("SmartAI Waypoints", sSmartWaypointMgr, &SmartWaypointMgr::LoadFromDB);
+    loader.AddStage("Creature Formations", sFormationMgr, &FormationMgr::LoadCreatureFormations);
 
-    sLog->outString("Loading Achievements...");
-    sAchievementMgr->LoadAchievementReferenceList();
-    sLog->outString("Loading Achievement Criteria Lists...");
-    sAchievementMgr->LoadAchievementCriteriaList();
-    sLog->outString("Loading Achievement Criteria Data...");
-    sAchievementMgr->LoadAchievementCriteriaData();
-    sLog->outString("Loading Achievement Rewards...");
-    sAchievementMgr->LoadRewards();
-    sLog->outString("Loading Achievement Reward Locales...");
-    sAchievementMgr->LoadRewardLocales();
-    sLog->outString("Loading Completed Achievements...");
-    sAchievementMgr->LoadCompletedAchievements();
+    uint32 creatureTexts = loader.AddStage("Creature Texts", sCreatureTextMgr, &CreatureTextMgr::LoadCreatureTexts);
+    loader.AddStage("Creature Text Locales", sCreatureTextMgr, &CreatureTextMgr::LoadCreatureTextLocales, creatureTexts);
+
+    loader.Run(getIntConfig(CONFIG_STARTUP_LOADER_THREADS));
 
     // Delete expired auctions before loading
     sLog->outString("Deleting expired auctions...");
@@ -1556,39 +1575,15 @@ void World::SetInitialWorldSettings()
     sLog->outString("Loading Groups...");
     sGroupMgr->LoadGroups();
 
-    sLog->outString("Loading ReservedNames...");
-    sObjectMgr->LoadReservedPlayersNames();
-
     sLog->outString("Loading GameObjects for quests...");
     sObjectMgr->LoadGameObjectForQuests();
 
-    sLog->outString("Loading BattleMasters...");
-    sBattlegroundMgr->LoadBattleMastersEntry();
-
-    sLog->outString("Loading GameTeleports...");
-    sObjectMgr->LoadGameTele();
-
-    sLog->outString("Loading Gossip menu...");
-    sObjectMgr->LoadGossipMenu();
-
-    sLog->outString("Loading Gossip menu options...");
-    sObjectMgr->LoadGossipMenuItems();
-
     sLog->outString("Loading Vendors...");
     sObjectMgr->LoadVendors();                                   // must be after load CreatureTemplate and ItemTemplate
 
     sLog->outString("Loading Trainers...");
     sObjectMgr->LoadTrainerSpell();                              // must be after load CreatureTemplate
 
-    sLog->outString("Loading Waypoints...");
-    sWaypointMgr->Load();
-
-    sLog->outString("Loading SmartAI Waypoints...");
-    sSmartWaypointMgr->LoadFromDB();
-
-    sLog->outString("Loading Creature Formations...");
-    sFormationMgr->LoadCreatureFormations();
-
     sLog->outString("Loading World States...");              // must be loaded before battleground, outdoor PvP and conditions
     LoadWorldStates();
 
@@ -1646,12 +1641,6 @@ void World::SetInitialWorldSettings()
     sLog->outString("Loading spell script names...");
     sObjectMgr->LoadSpellScriptNames();
 
-    sLog->outString("Loading Creature Texts...");
-    sCreatureTextMgr->LoadCreatureTexts();
-
-    sLog->outString("Loading Creature Text Locales...");
-    sCreatureTextMgr->LoadCreatureTextLocales();
-
     sLog->outString("Initializing Scripts...");
     sScriptMgr->Initialize();
     sScriptMgr->OnConfigLoad(false);                                // must be done after the ScriptMgr has been properly initialized
@@ -1703,6 +1692,10 @@ void World::SetInitialWorldSettings()
     sLog->outString("Starting Map System");
     sMapMgr->Initialize();
 
+    if (int loaderThreads = getIntConfig(CONFIG_LOGIN_LOADER_THREADS))
+        if (m_loginLoader.activate(loaderThreads) == -1)
+            sLog->outError("Failed to start the player login loader threads, logins are loaded on the world thread.");
+
     sLog->outString("Starting Game Event system...");
     uint32 nextGameEvent = sGameEventMgr->StartSystem();
     m_timers[WUPDATE_EVENTS].SetInterval(nextGameEvent);    //depend on next event
@@ -1763,6 +1756,8 @@ void World::SetInitialWorldSettings()
 
     uint32 startupDuration = GetMSTimeDiffToNow(startupBegin);
     sLog->outString();
+    loader.ReportTimes();
+    sLog->outString();
     sLog->outString("WORLD: World initialized in %u minutes %u seconds", (startupDuration / 60000), ((startupDuration % 60000) / 1000));
     sLog->outString();
 }
@@ -1811,28 +1806,46 @@ void World::DetectDBCLang()
     sLog->outString();
 }
 
-void World::RecordTimeDiff(const char *text, ...)
+char const* World::GetPhaseName(WorldUpdatePhase phase)
 {
-    if (m_updateTimeCount != 1)
-        return;
-    if (!text)
+    switch (phase)
     {
-        m_currentTime = getMSTime();
-        return;
+        case WUPDATE_PHASE_SESSIONS:      return "UpdateSessions";
+        case WUPDATE_PHASE_MAPS:          return "UpdateMapMgr";
+        case WUPDATE_PHASE_BATTLEGROUNDS: return "UpdateBattlegroundMgr";
+        case WUPDATE_PHASE_OUTDOORPVP:    return "UpdateOutdoorPvPMgr";
+        case WUPDATE_PHASE_LFG:           return "UpdateLFGMgr";
+        case WUPDATE_PHASE_CALLBACKS:     return "ProcessQueryCallbacks";
+        default:                          return "Unknown";
     }
+}
+
+void World::StartPhaseTimer()
+{
+    m_currentTime = getMSTime();
+    m_phaseTimestamp = TickProfiler::GetTimestamp();
+}
+
+void World::RecordPhaseTime(WorldUpdatePhase phase)
+{
+    uint64 timestamp = TickProfiler::GetTimestamp();
+    if (sTickProfiler->IsEnabled())
+        sTickProfiler->Record(PROFILE_WORLD, GetPhaseName(phase), phase, m_phaseTimestamp, timestamp);
+    m_phaseTimestamp = timestamp;
 
     uint32 thisTime = getMSTime();
     uint32 diff = getMSTimeDiff(m_currentTime, thisTime);
 
-    if (diff > m_int_configs[CONFIG_MIN_LOG_UPDATE])
-    {
-        va_list ap;
-        char str[256];
-        va_start(ap, text);
-        vsnprintf(str, 256, text, ap);
-        va_end(ap);
-        sLog->outDetail("Difftime %s: %u.", str, diff);
-    }
+    WorldUpdatePhaseTime& time = m_phaseTimes[phase];
+    time.Last = diff;
+    if (diff > time.Max)
+        time.Max = diff;
+    time.Sum += diff;
+    ++time.Count;
+
+    // single phases are only reported on the sampled tick
+    if (m_updateTimeCount == 1 && diff > m_int_configs[CONFIG_MIN_LOG_UPDATE])
+        sLog->outDetail("Difftime %s: %u.", GetPhaseName(phase), diff);
 
     m_currentTime = thisTime;
 }
@@ -1872,6 +1885,8 @@ void World::LoadAutobroadcasts()
 /// Update the World !
 void World::Update(uint32 diff)
 {
+    ProfileScope profile(PROFILE_WORLD, "World::Update");
+
     m_updateTime = diff;
 
     if (m_int_configs[CONFIG_INTERVAL_LOG_UPDATE] && diff > m_int_configs[CONFIG_MIN_LOG_UPDATE])
@@ -1879,6 +1894,14 @@ void World::Update(uint32 diff)
         if (m_updateTimeSum > m_int_configs[CONFIG_INTERVAL_LOG_UPDATE])
         {
             sLog->outBasic("Update time diff: %u. Players online: %u.", m_updateTimeSum / m_updateTimeCount, GetActiveSessionCount());
+            for (uint8 i = 0; i < WUPDATE_PHASE_COUNT; ++i)
+            {
+                WorldUpdatePhaseTime& time = m_phaseTimes[i];
+                if (time.Count)
+                    sLog->outBasic("Update phase %s: avg %u max %u.", GetPhaseName(WorldUpdatePhase(i)), uint32(time.Sum / time.Count), time.Max);
+                time = WorldUpdatePhaseTime();
+            }
+
             m_updateTimeSum = m_updateTime;
             m_updateTimeCount = 1;
         }
@@ -1932,9 +1955,10 @@ void World::Update(uint32 diff)
     }
 
     /// <li> Handle session updates when the timer has passed
-    RecordTimeDiff(NULL);
+    /// thread-unsafe packet handlers are all processed here, while no map is updated
+    StartPhaseTimer();
     UpdateSessions(diff);
-    RecordTimeDiff("UpdateSessions");
+    RecordPhaseTime(WUPDATE_PHASE_SESSIONS);
 
     /// <li> Handle weather updates when the timer has passed
     if (m_timers[WUPDATE_WEATHERS].Passed())
@@ -1943,45 +1967,13 @@ void World::Update(uint32 diff)
         WeatherMgr::Update(uint32(m_timers[WUPDATE_WEATHERS].GetInterval()));
     }
 
-    /// <li> Update uptime table
-    if (m_timers[WUPDATE_UPTIME].Passed())
-    {
-        uint32 tmpDiff = uint32(m_gameTime - m_startTime);
-        uint32 maxOnlinePlayers = GetMaxPlayerCount();
-
-        m_timers[WUPDATE_UPTIME].Reset();
-
-        PreparedStatement* stmt = LoginDatabase.GetPreparedStatement(LOGIN_UPD_UPTIME_PLAYERS);
-
-        stmt->setUInt32(0, tmpDiff);
-        stmt->setUInt16(1, uint16(maxOnlinePlayers));
-        stmt->setUInt32(2, realmID);
-        stmt->setUInt32(3, uint32(m_startTime));
-
-        LoginDatabase.Execute(stmt);
-    }
-
-    /// <li> Clean logs table
-    if (sWorld->getIntConfig(CONFIG_LOGDB_CLEARTIME) > 0) // if not enabled, ignore the timer
-    {
-        if (m_timers[WUPDATE_CLEANDB].Passed())
-        {
-            m_timers[WUPDATE_CLEANDB].Reset();
-
-            PreparedStatement* stmt = LoginDatabase.GetPreparedStatement(LOGIN_DEL_OLD_LOGS);
-
-            stmt->setUInt32(0, sWorld->getIntConfig(CONFIG_LOGDB_CLEARTIME));
-            stmt->setUInt32(1, uint32(time(0)));
-
-            LoginDatabase.Execute(stmt);
-        }
-    }
-
     /// <li> Handle all other objects
     ///- Update objects when the timer has passed (maps, transport, creatures, ...)
-    RecordTimeDiff(NULL);
+    UpdateDatabaseMaintenance();
+
+    StartPhaseTimer();
     sMapMgr->Update(diff);
-    RecordTimeDiff("UpdateMapMgr");
+    RecordPhaseTime(WUPDATE_PHASE_MAPS);
 
     if (sWorld->getBoolConfig(CONFIG_AUTOBROADCAST))
     {
@@ -1992,11 +1984,12 @@ void World::Update(uint32 diff)
         }
     }
 
+    StartPhaseTimer();
     sBattlegroundMgr->Update(diff);
-    RecordTimeDiff("UpdateBattlegroundMgr");
+    RecordPhaseTime(WUPDATE_PHASE_BATTLEGROUNDS);
 
     sOutdoorPvPMgr->Update(diff);
-    RecordTimeDiff("UpdateOutdoorPvPMgr");
+    RecordPhaseTime(WUPDATE_PHASE_OUTDOORPVP);
 
     ///- Delete all characters which have been deleted X days before
     if (m_timers[WUPDATE_DELETECHARS].Passed())
@@ -2005,12 +1998,13 @@ void World::Update(uint32 diff)
         Player::DeleteOldCharacters();
     }
 
+    StartPhaseTimer();
     sLFGMgr->Update(diff);
-    RecordTimeDiff("UpdateLFGMgr");
+    RecordPhaseTime(WUPDATE_PHASE_LFG);
 
     // execute callbacks from sql queries that were queued recently
     ProcessQueryCallbacks();
-    RecordTimeDiff("ProcessQueryCallbacks");
+    RecordPhaseTime(WUPDATE_PHASE_CALLBACKS);
 
     ///- Erase corpses once every 20 minutes
     if (m_timers[WUPDATE_CORPSES].Passed())
@@ -2028,6 +2022,51 @@ void World::Update(uint32 diff)
         m_timers[WUPDATE_EVENTS].Reset();
     }
 
+    // update the instance reset times
+    sInstanceSaveMgr->Update();
+
+    // And last, but not least handle the issued cli commands
+    ProcessCliCommands();
+
+    sScriptMgr->OnWorldUpdate(diff);
+}
+
+void World::UpdateDatabaseMaintenance()
+{
+    /// <li> Update uptime table
+    if (m_timers[WUPDATE_UPTIME].Passed())
+    {
+        uint32 tmpDiff = uint32(m_gameTime - m_startTime);
+        uint32 maxOnlinePlayers = GetMaxPlayerCount();
+
+        m_timers[WUPDATE_UPTIME].Reset();
+
+        PreparedStatement* stmt = LoginDatabase.GetPreparedStatement(LOGIN_UPD_UPTIME_PLAYERS);
+
+        stmt->setUInt32(0, tmpDiff);
+        stmt->setUInt16(1, uint16(maxOnlinePlayers));
+        stmt->setUInt32(2, realmID);
+        stmt->setUInt32(3, uint32(m_startTime));
+
+        LoginDatabase.Execute(stmt);
+    }
+
+    /// <li> Clean logs table
+    if (sWorld->getIntConfig(CONFIG_LOGDB_CLEARTIME) > 0) // if not enabled, ignore the timer
+    {
+        if (m_timers[WUPDATE_CLEANDB].Passed())
+        {
+            m_timers[WUPDATE_CLEANDB].Reset();
+
+            PreparedStatement* stmt = LoginDatabase.GetPreparedStatement(LOGIN_DEL_OLD_LOGS);
+
+            stmt->setUInt32(0, sWorld->getIntConfig(CONFIG_LOGDB_CLEARTIME));
+            stmt->setUInt32(1, uint32(time(0)));
+
+            LoginDatabase.Execute(stmt);
+        }
+    }
+
     ///- Ping to keep MySQL connections alive
     if (m_timers[WUPDATE_PINGDB].Passed())
     {
@@ -2037,14 +2076,6 @@ void World::Update(uint32 diff)
         LoginDatabase.KeepAlive();
         WorldDatabase.KeepAlive();
     }
-
-    // update the instance reset times
-    sInstanceSaveMgr->Update();
-
-    // And last, but not least handle the issued cli commands
-    ProcessCliCommands();
-
-    sScriptMgr->OnWorldUpdate(diff);
 }
 
 void World::ForceGameEventUpdate()
@@ -2384,14 +2415,14 @@ BanReturn World::BanCharacter(std::string name, std::string duration, std::strin
     // make sure there is only one active ban
     PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_UPD_CHARACTER_BAN);
     stmt->setUInt32(0, guid);
-    CharacterDatabase.Execute(stmt);
+    CharacterDatabase.Execute(stmt, guid);
 
     stmt = CharacterDatabase.GetPreparedStatement(CHAR_INS_CHARACTER_BAN);
     stmt->setUInt32(0, guid);
     stmt->setUInt32(1, duration_secs);
     stmt->setString(2, author);
     stmt->setString(3, reason);
-    CharacterDatabase.Execute(stmt);
+    CharacterDatabase.Execute(stmt, guid);
 
     if (pBanned)
         pBanned->GetSession()->KickPlayer();
@@ -2425,7 +2456,7 @@ bool World::RemoveBanCharacter(std::string name)
 
     PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_UPD_CHARACTER_BAN);
     stmt->setUInt32(0, guid);
-    CharacterDatabase.Execute(stmt);
+    CharacterDatabase.Execute(stmt, guid);
     return true;
 }
 
@@ -2545,6 +2576,8 @@ void World::SendServerMessage(ServerMessageType type, const char *text, Player*
 
 void World::UpdateSessions(uint32 diff)
 {
+    m_playerLoginsThisUpdate = 0;
+
     ///- Add new sessions
     WorldSession* sess = NULL;
     while (addSessQueue.next(sess))
@@ -2572,6 +2605,16 @@ void World::UpdateSessions(uint32 diff)
     }
 }
 
+bool World::CanFinishPlayerLogin()
+{
+    uint32 maxLogins = getIntConfig(CONFIG_MAX_LOGINS_PER_UPDATE);
+    if (maxLogins && m_playerLoginsThisUpdate >= maxLogins)
+        return false;
+
+    ++m_playerLoginsThisUpdate;
+    return true;
+}
+
 // This handles the issued and queued CLI commands
 void World::ProcessCliCommands()
 {
@@ -2726,7 +2769,7 @@ void World::ResetDailyQuests()
     sLog->outDetail("Daily quests reset for all characters.");
 
     PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_QUEST_STATUS_DAILY);
-    CharacterDatabase.Execute(stmt);
+    CharacterDatabase.ExecuteForAllKeys(stmt);
 
     for (SessionMap::const_iterator itr = m_sessions.begin(); itr != m_sessions.end(); ++itr)
         if (itr->second->GetPlayer())
@@ -2758,7 +2801,7 @@ void World::SetPlayerSecurityLimit(AccountTypes _sec)
 void World::ResetWeeklyQuests()
 {
     PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_QUEST_STATUS_WEEKLY);
-    CharacterDatabase.Execute(stmt);
+    CharacterDatabase.ExecuteForAllKeys(stmt);
 
     for (SessionMap::const_iterator itr = m_sessions.begin(); itr != m_sessions.end(); ++itr)
         if (itr->second->GetPlayer())
@@ -2775,7 +2818,7 @@ void World::ResetEventSeasonalQuests(uint16 event_id)
 {
     PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_QUEST_STATUS_SEASONAL);
     stmt->setUInt16(0,event_id);
-    CharacterDatabase.Execute(stmt);
+    CharacterDatabase.ExecuteForAllKeys(stmt);
 
     for (SessionMap::const_iterator itr = m_sessions.begin(); itr != m_sessions.end(); ++itr)
         if (itr->second->GetPlayer())
@@ -2787,7 +2830,7 @@ void World::ResetRandomBG()
     sLog->outDetail("Random BG status reset for all characters.");
 
     PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_BATTLEGROUND_RANDOM);
-    CharacterDatabase.Execute(stmt);
+    CharacterDatabase.ExecuteForAllKeys(stmt);
 
     for (SessionMap::const_iterator itr = m_sessions.begin(); itr != m_sessions.end(); ++itr)
         if (itr->second->GetPlayer())
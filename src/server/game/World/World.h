@@ -30,6 +30,7 @@
 #include "SharedDefines.h"
 #include "QueryResult.h"
 #include "Callback.h"
+#include "PlayerLoginLoader.h"
 
 #include <map>
 #include <set>
@@ -81,6 +82,28 @@ enum WorldTimers
     WUPDATE_COUNT
 };
 
+/// Timed phases of World::Update
+enum WorldUpdatePhase
+{
+    WUPDATE_PHASE_SESSIONS,                                 // thread-unsafe packet handlers
+    WUPDATE_PHASE_MAPS,
+    WUPDATE_PHASE_BATTLEGROUNDS,
+    WUPDATE_PHASE_OUTDOORPVP,
+    WUPDATE_PHASE_LFG,
+    WUPDATE_PHASE_CALLBACKS,
+    WUPDATE_PHASE_COUNT
+};
+
+struct WorldUpdatePhaseTime
+{
+    WorldUpdatePhaseTime() : Last(0), Max(0), Sum(0), Count(0) { }
+
+    uint32 Last;
+    uint32 Max;
+    uint64 Sum;
+    uint32 Count;
+};
+
 /// Configuration elements
 enum WorldBoolConfigs
 {
@@ -164,6 +187,7 @@ enum WorldBoolConfigs
     CONFIG_QUEST_IGNORE_AUTO_ACCEPT,
     CONFIG_QUEST_IGNORE_AUTO_COMPLETE,
     CONFIG_WARDEN_ENABLED,
+    CONFIG_TICK_PROFILER,
     BOOL_CONFIG_VALUE_COUNT
 };
 
@@ -318,6 +342,11 @@ enum WorldIntConfigs
     CONFIG_WARDEN_CLIENT_BAN_DURATION,
     CONFIG_WARDEN_NUM_MEM_CHECKS,
     CONFIG_WARDEN_NUM_OTHER_CHECKS,
+    CONFIG_STARTUP_LOADER_THREADS,
+    CONFIG_GRID_PRELOAD_THREADS,
+    CONFIG_COLLISION_QUERY_CACHE_SIZE,
+    CONFIG_LOGIN_LOADER_THREADS,
+    CONFIG_MAX_LOGINS_PER_UPDATE,
     INT_CONFIG_VALUE_COUNT
 };
 
@@ -738,7 +767,10 @@ class World
         void LoadDBVersion();
         char const* GetDBVersion() const { return m_DBVersion.c_str(); }
 
-        void RecordTimeDiff(const char * text, ...);
+        void StartPhaseTimer();
+        void RecordPhaseTime(WorldUpdatePhase phase);
+        WorldUpdatePhaseTime const& GetPhaseTime(WorldUpdatePhase phase) const { return m_phaseTimes[phase]; }
+        static char const* GetPhaseName(WorldUpdatePhase phase);
 
         void LoadAutobroadcasts();
 
@@ -755,6 +787,10 @@ class World
         void UpdateCharacterNameData(uint32 guid, std::string const& name, uint8 gender = GENDER_NONE, uint8 race = RACE_NONE);
         void DeleteCharaceterNameData(uint32 guid) { _characterNameDataMap.erase(guid); }
 
+        PlayerLoginLoader* GetPlayerLoginLoader() { return &m_loginLoader; }
+        // counts a login finished in the current session update, false once CONFIG_MAX_LOGINS_PER_UPDATE is reached
+        bool CanFinishPlayerLogin();
+
         uint32 GetCleaningFlags() const { return m_CleaningFlags; }
         void   SetCleaningFlags(uint32 flags) { m_CleaningFlags = flags; }
         void   ResetEventSeasonalQuests(uint16 event_id);
@@ -769,6 +805,9 @@ class World
         void ResetDailyQuests();
         void ResetWeeklyQuests();
         void ResetRandomBG();
+
+        // uptime table, log cleanup and database pings
+        void UpdateDatabaseMaintenance();
     private:
         static ACE_Atomic_Op<ACE_Thread_Mutex, bool> m_stopEvent;
         static uint8 m_ExitCode;
@@ -787,6 +826,8 @@ class World
         uint32 m_updateTime, m_updateTimeSum;
         uint32 m_updateTimeCount;
         uint32 m_currentTime;
+        uint64 m_phaseTimestamp;                            // start of the current phase for the tick profiler
+        WorldUpdatePhaseTime m_phaseTimes[WUPDATE_PHASE_COUNT];
 
         SessionMap m_sessions;
         typedef UNORDERED_MAP<uint32, time_t> DisconnectMap;
@@ -847,6 +888,9 @@ class World
 
         void ProcessQueryCallbacks();
         ACE_Future_Set<PreparedQueryResult> m_realmCharCallbacks;
+
+        PlayerLoginLoader m_loginLoader;
+        uint32 m_playerLoginsThisUpdate;
 };
 
 extern uint32 realmID;
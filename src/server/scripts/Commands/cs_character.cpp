@@ -210,7 +210,7 @@ public:
         stmt->setString(0, delInfo.name);
         stmt->setUInt32(1, delInfo.accountId);
         stmt->setUInt32(2, delInfo.lowGuid);
-        CharacterDatabase.Execute(stmt);
+        CharacterDatabase.Execute(stmt, delInfo.lowGuid);
 
         stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_CHARACTER_NAME_DATA);
         stmt->setUInt32(0, delInfo.lowGuid);
@@ -290,7 +290,7 @@ public:
             PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_UPD_ADD_AT_LOGIN_FLAG);
             stmt->setUInt16(0, uint16(AT_LOGIN_RENAME));
             stmt->setUInt32(1, GUID_LOPART(targetGuid));
-            CharacterDatabase.Execute(stmt);
+            CharacterDatabase.Execute(stmt, GUID_LOPART(targetGuid));
         }
 
         return true;
@@ -359,7 +359,7 @@ public:
             stmt->setUInt32(1, GUID_LOPART(targetGuid));
             handler->PSendSysMessage(LANG_CUSTOMIZE_PLAYER_GUID, oldNameLink.c_str(), GUID_LOPART(targetGuid));
         }
-        CharacterDatabase.Execute(stmt);
+        CharacterDatabase.Execute(stmt, GUID_LOPART(targetGuid));
 
         return true;
     }
@@ -387,7 +387,7 @@ public:
             handler->PSendSysMessage(LANG_CUSTOMIZE_PLAYER_GUID, oldNameLink.c_str(), GUID_LOPART(targetGuid));
             stmt->setUInt32(1, GUID_LOPART(targetGuid));
         }
-        CharacterDatabase.Execute(stmt);
+        CharacterDatabase.Execute(stmt, GUID_LOPART(targetGuid));
 
         return true;
     }
@@ -416,7 +416,7 @@ public:
             handler->PSendSysMessage(LANG_CUSTOMIZE_PLAYER_GUID, oldNameLink.c_str(), GUID_LOPART(targetGuid));
             stmt->setUInt32(1, GUID_LOPART(targetGuid));
         }
-        CharacterDatabase.Execute(stmt);
+        CharacterDatabase.Execute(stmt, GUID_LOPART(targetGuid));
 
         return true;
     }
@@ -118,9 +118,8 @@ public:
         bool first = true;
         bool footer = false;
 
-        TRINITY_READ_GUARD(HashMapHolder<Player>::LockType, *HashMapHolder<Player>::GetLock());
-        HashMapHolder<Player>::MapType const& m = sObjectAccessor->GetPlayers();
-        for (HashMapHolder<Player>::MapType::const_iterator itr = m.begin(); itr != m.end(); ++itr)
+        HashMapHolder<Player>::ReadGuard guard;
+        for (HashMapHolder<Player>::const_iterator itr = HashMapHolder<Player>::begin(); itr != HashMapHolder<Player>::end(); ++itr)
         {
             AccountTypes itrSec = itr->second->GetSession()->GetSecurity();
             if ((itr->second->isGameMaster() || (!AccountMgr::IsPlayerAccount(itrSec) && itrSec <= AccountTypes(sWorld->getIntConfig(CONFIG_GM_LEVEL_IN_GM_LIST)))) &&
@@ -517,6 +517,7 @@ public:
             cInfo->MechanicImmuneMask = fields[81].GetUInt32();
             cInfo->flags_extra        = fields[82].GetUInt32();
             cInfo->ScriptID           = sObjectMgr->GetScriptId(fields[83].GetCString());
+            cInfo->ProfileName        = sObjectMgr->GetCreatureProfileName(*cInfo);
 
             sObjectMgr->CheckCreatureTemplate(cInfo);
         }
@@ -1204,6 +1205,7 @@ public:
     {
         sLog->outString("Re-Loading Locales Item ... ");
         sObjectMgr->LoadItemLocales();
+        sAuctionMgr->ClearSearchNames();
         handler->SendGlobalGMSysMessage("DB table `locales_item` reloaded.");
         return true;
     }
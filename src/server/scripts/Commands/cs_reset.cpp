@@ -177,7 +177,7 @@ public:
             PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_UPD_ADD_AT_LOGIN_FLAG);
             stmt->setUInt16(0, uint16(AT_LOGIN_RESET_SPELLS));
             stmt->setUInt32(1, GUID_LOPART(targetGuid));
-            CharacterDatabase.Execute(stmt);
+            CharacterDatabase.Execute(stmt, GUID_LOPART(targetGuid));
 
             handler->PSendSysMessage(LANG_RESET_SPELLS_OFFLINE, targetName.c_str());
         }
@@ -251,7 +251,7 @@ public:
             PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_UPD_ADD_AT_LOGIN_FLAG);
             stmt->setUInt16(0, uint16(AT_LOGIN_NONE | AT_LOGIN_RESET_PET_TALENTS));
             stmt->setUInt32(1, GUID_LOPART(targetGuid));
-            CharacterDatabase.Execute(stmt);
+            CharacterDatabase.Execute(stmt, GUID_LOPART(targetGuid));
 
             std::string nameLink = handler->playerLink(targetName);
             handler->PSendSysMessage(LANG_RESET_TALENTS_OFFLINE, nameLink.c_str());
@@ -296,11 +296,10 @@ public:
 
         PreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_UPD_ALL_AT_LOGIN_FLAGS);
         stmt->setUInt16(0, uint16(atLogin));
-        CharacterDatabase.Execute(stmt);
+        CharacterDatabase.ExecuteForAllKeys(stmt);
 
-        TRINITY_READ_GUARD(HashMapHolder<Player>::LockType, *HashMapHolder<Player>::GetLock());
-        HashMapHolder<Player>::MapType const& plist = sObjectAccessor->GetPlayers();
-        for (HashMapHolder<Player>::MapType::const_iterator itr = plist.begin(); itr != plist.end(); ++itr)
+        HashMapHolder<Player>::ReadGuard guard;
+        for (HashMapHolder<Player>::const_iterator itr = HashMapHolder<Player>::begin(); itr != HashMapHolder<Player>::end(); ++itr)
             itr->second->SetAtLoginFlag(atLogin);
 
         return true;
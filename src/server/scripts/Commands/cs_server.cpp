@@ -27,6 +27,8 @@ EndScriptData */
 #include "SystemConfig.h"
 #include "Config.h"
 #include "ObjectAccessor.h"
+#include "MapManager.h"
+#include "TickProfiler.h"
 
 class server_commandscript : public CommandScript
 {
@@ -63,6 +65,14 @@ public:
             { NULL,             0,                  false, NULL,                                    "", NULL }
         };
 
+        static ChatCommand serverProfileCommandTable[] =
+        {
+            { "dump",           SEC_ADMINISTRATOR,  true,  &HandleServerProfileDumpCommand,         "", NULL },
+            { "reset",          SEC_ADMINISTRATOR,  true,  &HandleServerProfileResetCommand,        "", NULL },
+            { ""   ,            SEC_ADMINISTRATOR,  true,  &HandleServerProfileCommand,             "", NULL },
+            { NULL,             0,                  false, NULL,                                    "", NULL }
+        };
+
         static ChatCommand serverSetCommandTable[] =
         {
             { "difftime",       SEC_CONSOLE,        true,  &HandleServerSetDiffTimeCommand,         "", NULL },
@@ -79,9 +89,12 @@ public:
             { "exit",           SEC_CONSOLE,        true,  &HandleServerExitCommand,                "", NULL },
             { "idlerestart",    SEC_ADMINISTRATOR,  true,  NULL,                                    "", serverIdleRestartCommandTable },
             { "idleshutdown",   SEC_ADMINISTRATOR,  true,  NULL,                                    "", serverIdleShutdownCommandTable },
+            { "dbstats",        SEC_ADMINISTRATOR,  true,  &HandleServerDatabaseStatsCommand,       "", NULL },
             { "info",           SEC_PLAYER,         true,  &HandleServerInfoCommand,                "", NULL },
+            { "mapstats",       SEC_ADMINISTRATOR,  true,  &HandleServerMapStatsCommand,            "", NULL },
             { "motd",           SEC_PLAYER,         true,  &HandleServerMotdCommand,                "", NULL },
             { "plimit",         SEC_ADMINISTRATOR,  true,  &HandleServerPLimitCommand,              "", NULL },
+            { "profile",        SEC_ADMINISTRATOR,  true,  NULL,                                    "", serverProfileCommandTable },
             { "restart",        SEC_ADMINISTRATOR,  true,  NULL,                                    "", serverRestartCommandTable },
             { "shutdown",       SEC_ADMINISTRATOR,  true,  NULL,                                    "", serverShutdownCommandTable },
             { "set",            SEC_ADMINISTRATOR,  true,  NULL,                                    "", serverSetCommandTable },
@@ -126,6 +139,119 @@ public:
 
         return true;
     }
+    template<class T>
+    static void SendDatabaseStats(ChatHandler* handler, char const* name, DatabaseWorkerPool<T> const& database)
+    {
+        uint32 queued;
+        DatabaseWorkerStats stats;
+        database.GetAsyncStats(queued, stats);
+
+        handler->PSendSysMessage("%s: queued %u executed " UI64FMTD " latency avg %u max %u",
+            name, queued, stats.Executed, uint32(stats.Executed ? stats.TotalLatency / stats.Executed : 0), stats.MaxLatency);
+    }
+
+    // Display queue depth and latency (ms) of the asynchronous database operations
+    static bool HandleServerDatabaseStatsCommand(ChatHandler* handler, char const* /*args*/)
+    {
+        SendDatabaseStats(handler, "World", WorldDatabase);
+        SendDatabaseStats(handler, "Character", CharacterDatabase);
+        SendDatabaseStats(handler, "Login", LoginDatabase);
+        return true;
+    }
+
+    static bool MapUpdateCostCompare(Map const* left, Map const* right)
+    {
+        return left->GetUpdateStats().GetAverageCost() > right->GetUpdateStats().GetAverageCost();
+    }
+
+    // Display update timing of the most expensive maps, or reset it with "reset"
+    static bool HandleServerMapStatsCommand(ChatHandler* handler, char const* args)
+    {
+        std::vector<Map*> maps;
+        sMapMgr->GetAllMaps(maps);
+
+        if (*args && strncmp(args, "reset", strlen(args)) == 0)
+        {
+            for (std::vector<Map*>::iterator itr = maps.begin(); itr != maps.end(); ++itr)
+            {
+                (*itr)->GetUpdateStats().Reset();
+                (*itr)->GetCollisionCache().ResetStats();
+            }
+
+            handler->SendSysMessage("Map update statistics reset.");
+            return true;
+        }
+
+        uint32 limit = *args ? uint32(atoi(args)) : 10;
+        if (!limit)
+            limit = 10;
+
+        std::sort(maps.begin(), maps.end(), MapUpdateCostCompare);
+
+        handler->SendSysMessage("Map update cost (ms), histogram buckets <1 <2 <5 <10 <25 <50 <100 <250 >=250, collision cache hits/misses:");
+        for (std::vector<Map*>::const_iterator itr = maps.begin(); itr != maps.end() && limit; ++itr, --limit)
+        {
+            MapUpdateStats const& stats = (*itr)->GetUpdateStats();
+            CollisionQueryCache const& cache = (*itr)->GetCollisionCache();
+            handler->PSendSysMessage("Map %u (%s) instance %u: last %u avg %u max %u updates %u | %u %u %u %u %u %u %u %u %u | " UI64FMTD "/" UI64FMTD,
+                (*itr)->GetId(), (*itr)->GetMapName(), (*itr)->GetInstanceId(), stats.LastCost, stats.GetAverageCost(), stats.MaxCost, stats.Updates,
+                stats.Histogram[0], stats.Histogram[1], stats.Histogram[2], stats.Histogram[3], stats.Histogram[4],
+                stats.Histogram[5], stats.Histogram[6], stats.Histogram[7], stats.Histogram[8], cache.GetHits(), cache.GetMisses());
+        }
+
+        return true;
+    }
+
+    // Display the most expensive scopes recorded by the tick profiler
+    static bool HandleServerProfileCommand(ChatHandler* handler, char const* args)
+    {
+        if (!sTickProfiler->IsEnabled())
+            handler->SendSysMessage("Tick profiler is disabled (Profiler.Enable), showing the samples recorded before.");
+
+        uint32 limit = *args ? uint32(atoi(args)) : 10;
+        if (!limit)
+            limit = 10;
+
+        std::vector<ProfilerEntry> entries;
+        sTickProfiler->GetTopEntries(entries, limit);
+
+        handler->SendSysMessage("Most expensive profiled scopes (total/max in microseconds):");
+        for (std::vector<ProfilerEntry>::const_iterator itr = entries.begin(); itr != entries.end(); ++itr)
+            handler->PSendSysMessage("%s %s (%u): calls %u total " UI64FMTD " max " UI64FMTD,
+                TickProfiler::GetCategoryName(itr->Category), itr->Name ? itr->Name : "", itr->Id, itr->Calls, itr->TotalTime, itr->MaxTime);
+
+        return true;
+    }
+
+    // Write the recorded profiler samples to a file in Chrome trace format
+    static bool HandleServerProfileDumpCommand(ChatHandler* handler, char const* args)
+    {
+        std::string fileName = *args ? args : "profile.json";
+        if (!TickProfiler::IsValidTraceFileName(fileName))
+        {
+            handler->PSendSysMessage("Invalid file name %s, it is written to LogsDir and must not contain a path.", fileName.c_str());
+            handler->SetSentErrorMessage(true);
+            return false;
+        }
+
+        if (!sTickProfiler->WriteChromeTrace(fileName))
+        {
+            handler->PSendSysMessage("Could not write profiler samples to %s.", fileName.c_str());
+            handler->SetSentErrorMessage(true);
+            return false;
+        }
+
+        handler->PSendSysMessage("Profiler samples written to %s.", fileName.c_str());
+        return true;
+    }
+
+    static bool HandleServerProfileResetCommand(ChatHandler* handler, char const* /*args*/)
+    {
+        sTickProfiler->Reset();
+        handler->SendSysMessage("Profiler samples dropped.");
+        return true;
+    }
+
     // Display the 'Message of the day' for the realm
     static bool HandleServerMotdCommand(ChatHandler* handler, char const* /*args*/)
     {
@@ -86,6 +86,7 @@
 #include <algorithm>
 
 #include "Threading/LockedQueue.h"
+#include "Threading/LockFreeQueue.h"
 #include "Threading/Threading.h"
 
 #include <ace/Basic_Types.h>
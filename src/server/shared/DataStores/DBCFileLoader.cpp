@@ -23,72 +23,72 @@
 #include "DBCFileLoader.h"
 #include "Errors.h"
 
+#include <ace/Mem_Map.h>
+
 DBCFileLoader::DBCFileLoader()
 {
+    mapping = NULL;
     data = NULL;
     fieldsOffset = NULL;
 }
 
 bool DBCFileLoader::Load(const char* filename, const char* fmt)
 {
-    uint32 header;
-    if (data)
+    if (mapping)
     {
-        delete [] data;
+        delete mapping;
+        mapping = NULL;
         data = NULL;
     }
 
-    FILE* f = fopen(filename, "rb");
-    if (!f)
+    // Records are read from a private mapping of the file instead of a heap copy, records and strings
+    // used in place stay valid as long as the mapping is kept (see ReleaseMapping). Pages written to
+    // after loading (corrections of dbc data) are copied by the system.
+    ACE_Mem_Map* map = new ACE_Mem_Map();
+    if (map->map(filename, static_cast<size_t>(-1), O_RDONLY, ACE_DEFAULT_FILE_PERMS, PROT_RDWR, ACE_MAP_PRIVATE) == -1)
+    {
+        delete map;
         return false;
+    }
 
-    if (fread(&header, 4, 1, f) != 1)                        // Number of records
+    // the mapping stays valid without the file descriptor, hundreds of dbc files stay mapped
+    map->close_handle();
+
+    if (map->size() < 5 * sizeof(uint32))
     {
-        fclose(f);
+        delete map;
         return false;
     }
 
+    uint32 const* fileHeader = reinterpret_cast<uint32 const*>(map->addr());
 
+    uint32 header = fileHeader[0];
     EndianConvert(header);
 
     if (header != 0x43424457)                                //'WDBC'
     {
-        fclose(f);
-        return false;
-    }
-
-    if (fread(&recordCount, 4, 1, f) != 1)                   // Number of records
-    {
-        fclose(f);
+        delete map;
         return false;
     }
 
+    recordCount = fileHeader[1];                             // Number of records
     EndianConvert(recordCount);
 
-    if (fread(&fieldCount, 4, 1, f) != 1)                    // Number of fields
-    {
-        fclose(f);
-        return false;
-    }
-
+    fieldCount = fileHeader[2];                              // Number of fields
     EndianConvert(fieldCount);
 
-    if (fread(&recordSize, 4, 1, f) != 1)                    // Size of a record
-    {
-        fclose(f);
-        return false;
-    }
-
+    recordSize = fileHeader[3];                              // Size of a record
     EndianConvert(recordSize);
 
-    if (fread(&stringSize, 4, 1, f) != 1)                    // String size
+    stringSize = fileHeader[4];                              // String size
+    EndianConvert(stringSize);
+
+    if (map->size() < 5 * sizeof(uint32) + size_t(recordSize) * recordCount + stringSize)
     {
-        fclose(f);
+        delete map;
         return false;
     }
 
-    EndianConvert(stringSize);
-
     fieldsOffset = new uint32[fieldCount];
     fieldsOffset[0] = 0;
     for (uint32 i = 1; i < fieldCount; ++i)
@@ -100,29 +100,90 @@ bool DBCFileLoader::Load(const char* filename, const char* fmt)
             fieldsOffset[i] += sizeof(uint32);
     }
 
-    data = new unsigned char[recordSize * recordCount + stringSize];
+    mapping = map;
+    data = reinterpret_cast<unsigned char*>(map->addr()) + 5 * sizeof(uint32);
     stringTable = data + recordSize*recordCount;
 
-    if (fread(data, recordSize * recordCount + stringSize, 1, f) != 1)
-    {
-        fclose(f);
-        return false;
-    }
-
-    fclose(f);
-
     return true;
 }
 
 DBCFileLoader::~DBCFileLoader()
 {
-    if (data)
-        delete [] data;
+    delete mapping;
 
     if (fieldsOffset)
         delete [] fieldsOffset;
 }
 
+ACE_Mem_Map* DBCFileLoader::ReleaseMapping()
+{
+    ACE_Mem_Map* map = mapping;
+    mapping = NULL;
+    return map;
+}
+
+bool DBCFileLoader::HasStrings(const char* format)
+{
+    return strchr(format, FT_STRING) != NULL;
+}
+
+bool DBCFileLoader::CanIndexInPlace(const char* format) const
+{
+#if TRINITY_ENDIAN == TRINITY_BIGENDIAN
+    return false;
+#else
+    if (strlen(format) != fieldCount)
+        return false;
+
+    // every field has to be stored in the structure exactly as in the file
+    for (uint32 x = 0; format[x]; ++x)
+        if (format[x] != FT_INT && format[x] != FT_IND && format[x] != FT_FLOAT && format[x] != FT_BYTE)
+            return false;
+
+    return GetFormatRecordSize(format) == recordSize;
+#endif
+}
+
+char* DBCFileLoader::IndexInPlace(const char* format, uint32& records, char**& indexTable)
+{
+    typedef char* ptr;
+
+    int32 i;
+    GetFormatRecordSize(format, &i);
+
+    if (i >= 0)
+    {
+        uint32 maxi = 0;
+        for (uint32 y = 0; y < recordCount; ++y)
+        {
+            uint32 ind = getRecord(y).getUInt(i);
+            if (ind > maxi)
+                maxi = ind;
+        }
+
+        ++maxi;
+        records = maxi;
+        indexTable = new ptr[maxi];
+        memset(indexTable, 0, maxi * sizeof(ptr));
+    }
+    else
+    {
+        records = recordCount;
+        indexTable = new ptr[recordCount];
+    }
+
+    for (uint32 y = 0; y < recordCount; ++y)
+    {
+        char* record = reinterpret_cast<char*>(data + y * recordSize);
+        if (i >= 0)
+            indexTable[getRecord(y).getUInt(i)] = record;
+        else
+            indexTable[y] = record;
+    }
+
+    return reinterpret_cast<char*>(data);
+}
+
 DBCFileLoader::Record DBCFileLoader::getRecord(size_t id)
 {
     assert(data);
@@ -277,8 +338,8 @@ char* DBCFileLoader::AutoProduceStrings(const char* format, char* dataTable)
     if (strlen(format) != fieldCount)
         return NULL;
 
-    char* stringPool = new char[stringSize];
-    memcpy(stringPool, stringTable, stringSize);
+    // strings are used in place, the caller keeps the mapping
+    char* stringPool = reinterpret_cast<char*>(stringTable);
 
     uint32 offset = 0;
 
@@ -304,8 +365,7 @@ char* DBCFileLoader::AutoProduceStrings(const char* format, char* dataTable)
                     char** slot = (char**)(&dataTable[offset]);
                     if (!*slot || !**slot)
                     {
-                        const char * st = getRecord(y).getString(x);
-                        *slot=stringPool+(st-(const char*)stringTable);
+                        *slot = const_cast<char*>(getRecord(y).getString(x));
                     }
                     offset += sizeof(char*);
                     break;
@@ -22,6 +22,8 @@
 #include "Utilities/ByteConverter.h"
 #include <cassert>
 
+class ACE_Mem_Map;
+
 enum
 {
     FT_NA='x',                                              //not used or unknown, 4 byte size
@@ -95,7 +97,15 @@ class DBCFileLoader
         uint32 GetOffset(size_t id) const { return (fieldsOffset != NULL && id < fieldCount) ? fieldsOffset[id] : 0; }
         bool IsLoaded() const { return data != NULL; }
         char* AutoProduceData(const char* fmt, uint32& count, char**& indexTable, uint32 sqlRecordCount, uint32 sqlHighestIndex, char *& sqlDataTable);
+        // fills the string fields with pointers into the mapped file, returns the string table
         char* AutoProduceStrings(const char* fmt, char* dataTable);
+        // true if the structures can point into the mapped records without conversion
+        bool CanIndexInPlace(const char* fmt) const;
+        // builds only the index table, returns the records in the mapped file
+        char* IndexInPlace(const char* fmt, uint32& count, char**& indexTable);
+        // the caller takes over the mapped file, needed as long as records or strings are used in place
+        ACE_Mem_Map* ReleaseMapping();
+        static bool HasStrings(const char* format);
         static uint32 GetFormatRecordSize(const char * format, int32 * index_pos = NULL);
     private:
 
@@ -104,6 +114,7 @@ class DBCFileLoader
         uint32 fieldCount;
         uint32 stringSize;
         uint32 *fieldsOffset;
+        ACE_Mem_Map *mapping;
         unsigned char *data;
         unsigned char *stringTable;
 };
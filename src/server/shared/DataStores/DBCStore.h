@@ -26,6 +26,8 @@
 #include "Implementation/WorldDatabase.h"
 #include "DatabaseEnv.h"
 
+#include <ace/Mem_Map.h>
+
 struct SqlDbc
 {
     const std::string * formatString;
@@ -68,10 +70,10 @@ struct SqlDbc
 template<class T>
 class DBCStorage
 {
-    typedef std::list<char*> StringPoolList;
+    typedef std::list<ACE_Mem_Map*> MappingList;
     public:
         explicit DBCStorage(const char *f) :
-            fmt(f), nCount(0), fieldCount(0), dataTable(NULL)
+            fmt(f), nCount(0), fieldCount(0), dataTable(NULL), dataInPlace(false)
         {
             indexTable.asT = NULL;
         }
@@ -126,10 +128,25 @@ class DBCStorage
             char * sqlDataTable;
             fieldCount = dbc.GetCols();
 
+            // Records stored like the structure are used from the mapped file directly
+            if (!result && dbc.CanIndexInPlace(fmt))
+            {
+                dataTable = (T*)dbc.IndexInPlace(fmt, nCount, indexTable.asChar);
+                dataInPlace = true;
+                mappings.push_back(dbc.ReleaseMapping());
+                return indexTable.asT != NULL;
+            }
+
             dataTable = (T*)dbc.AutoProduceData(fmt, nCount, indexTable.asChar,
                 sqlRecordCount, sqlHighestIndex, sqlDataTable);
 
-            stringPoolList.push_back(dbc.AutoProduceStrings(fmt, (char*)dataTable));
+            // Strings point into the mapped file, records without strings do not need it anymore
+            char* stringPool = NULL;
+            if (DBCFileLoader::HasStrings(fmt))
+            {
+                stringPool = dbc.AutoProduceStrings(fmt, (char*)dataTable);
+                mappings.push_back(dbc.ReleaseMapping());
+            }
 
             // Insert sql data into arrays
             if (result)
@@ -179,7 +196,7 @@ class DBCStorage
                                         break;
                                     case FT_STRING:
                                         // Beginning of the pool - empty string
-                                        *((char**)(&sqlDataTable[offset]))=stringPoolList.back();
+                                        *((char**)(&sqlDataTable[offset]))=stringPool;
                                         offset+=sizeof(char*);
                                         break;
                                 }
@@ -246,7 +263,11 @@ class DBCStorage
             if (!dbc.Load(fn, fmt))
                 return false;
 
-            stringPoolList.push_back(dbc.AutoProduceStrings(fmt, (char*)dataTable));
+            if (DBCFileLoader::HasStrings(fmt))
+            {
+                dbc.AutoProduceStrings(fmt, (char*)dataTable);
+                mappings.push_back(dbc.ReleaseMapping());
+            }
 
             return true;
         }
@@ -258,13 +279,15 @@ class DBCStorage
 
             delete[] ((char*)indexTable.asT);
             indexTable.asT = NULL;
-            delete[] ((char*)dataTable);
+            if (!dataInPlace)
+                delete[] ((char*)dataTable);
             dataTable = NULL;
+            dataInPlace = false;
 
-            while (!stringPoolList.empty())
+            while (!mappings.empty())
             {
-                delete[] stringPoolList.front();
-                stringPoolList.pop_front();
+                delete mappings.front();
+                mappings.pop_front();
             }
             nCount = 0;
         }
@@ -282,7 +305,8 @@ class DBCStorage
         indexTable;
 
         T* dataTable;
-        StringPoolList stringPoolList;
+        bool dataInPlace;                                   // dataTable points into a mapped file
+        MappingList mappings;                               // mapped files holding records or strings in use, without open descriptors
 };
 
 #endif
@@ -20,6 +20,7 @@
 #include "SQLOperation.h"
 #include "MySQLConnection.h"
 #include "MySQLThreading.h"
+#include "Timer.h"
 
 DatabaseWorker::DatabaseWorker(ACE_Activation_Queue* new_queue, MySQLConnection* con) :
 m_queue(new_queue),
@@ -41,11 +42,28 @@ int DatabaseWorker::svc()
         if (!request)
             break;
 
-        request->SetConnection(m_conn);
-        request->call();
-
-        delete request;
+        Execute(request);
     }
 
     return 0;
 }
+
+void DatabaseWorker::Execute(SQLOperation* request)
+{
+    request->SetConnection(m_conn);
+    request->call();
+
+    Finish(request);
+}
+
+void DatabaseWorker::Finish(SQLOperation* request)
+{
+    uint32 latency = getMSTimeDiff(request->m_queueTime, getMSTime());
+
+    ++m_stats.Executed;
+    m_stats.TotalLatency += latency;
+    if (latency > m_stats.MaxLatency)
+        m_stats.MaxLatency = latency;
+
+    delete request;
+}
@@ -21,7 +21,20 @@
 #include <ace/Task.h>
 #include <ace/Activation_Queue.h>
 
+#include "Define.h"
+
 class MySQLConnection;
+class SQLOperation;
+
+//! Counters of one asynchronous connection, only written by its worker thread
+struct DatabaseWorkerStats
+{
+    DatabaseWorkerStats() : Executed(0), TotalLatency(0), MaxLatency(0) { }
+
+    uint64 Executed;                                        //! Operations executed
+    uint64 TotalLatency;                                    //! Sum of the ms from enqueueing to the end of execution
+    uint32 MaxLatency;
+};
 
 class DatabaseWorker : protected ACE_Task_Base
 {
@@ -32,10 +45,17 @@ class DatabaseWorker : protected ACE_Task_Base
         int svc();
         int wait() { return ACE_Task_Base::wait(); }
 
+        DatabaseWorkerStats const& GetStats() const { return m_stats; }
+
     private:
         DatabaseWorker() : ACE_Task_Base() {}
+
+        void Execute(SQLOperation* request);
+        void Finish(SQLOperation* request);
+
         ACE_Activation_Queue* m_queue;
         MySQLConnection* m_conn;
+        DatabaseWorkerStats m_stats;
 };
 
 #endif
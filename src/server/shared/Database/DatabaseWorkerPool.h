@@ -19,6 +19,8 @@
 #define _DATABASEWORKERPOOL_H
 
 #include <ace/Thread_Mutex.h>
+#include <ace/Atomic_Op.h>
+#include <ace/Thread.h>
 
 #include "Common.h"
 #include "Callback.h"
@@ -30,6 +32,7 @@
 #include "QueryResult.h"
 #include "QueryHolder.h"
 #include "AdhocStatement.h"
+#include "Timer.h"
 
 class PingOperation : public SQLOperation
 {
@@ -46,8 +49,7 @@ class DatabaseWorkerPool
 {
     public:
         /* Activity state */
-        DatabaseWorkerPool() :
-        _queue(new ACE_Activation_Queue())
+        DatabaseWorkerPool() : _nextSynch(0)
         {
             memset(_connectionCount, 0, sizeof(_connectionCount));
             _connections.resize(IDX_SIZE);
@@ -67,11 +69,13 @@ class DatabaseWorkerPool
             sLog->outSQLDriver("Opening DatabasePool '%s'. Asynchronous connections: %u, synchronous connections: %u.",
                 GetDatabaseName(), async_threads, synch_threads);
 
-            //! Open asynchronous connections (delayed operations)
+            //! Open asynchronous connections (delayed operations), each one with its own queue
             _connections[IDX_ASYNC].resize(async_threads);
+            _queues.resize(async_threads);
             for (uint8 i = 0; i < async_threads; ++i)
             {
-                T* t = new T(_queue, _connectionInfo);
+                _queues[i] = new ACE_Activation_Queue();
+                T* t = new T(_queues[i], _connectionInfo);
                 res &= t->Open();
                 _connections[IDX_ASYNC][i] = t;
                 ++_connectionCount[IDX_ASYNC];
@@ -103,7 +107,8 @@ class DatabaseWorkerPool
             //! Shuts down delaythreads for this connection pool by underlying deactivate().
             //! The next dequeue attempt in the worker thread tasks will result in an error,
             //! ultimately ending the worker thread task.
-            _queue->queue()->close();
+            for (size_t i = 0; i < _queues.size(); ++i)
+                _queues[i]->queue()->close();
 
             for (uint8 i = 0; i < _connectionCount[IDX_ASYNC]; ++i)
             {
@@ -124,8 +129,9 @@ class DatabaseWorkerPool
             for (uint8 i = 0; i < _connectionCount[IDX_SYNCH]; ++i)
                 _connections[IDX_SYNCH][i]->Close();
 
-            //! Deletes the ACE_Activation_Queue object and its underlying ACE_Message_Queue
-            delete _queue;
+            //! Deletes the ACE_Activation_Queue objects and their underlying ACE_Message_Queue
+            for (size_t i = 0; i < _queues.size(); ++i)
+                delete _queues[i];
 
             sLog->outSQLDriver("All connections on DatabasePool '%s' closed.", GetDatabaseName());
         }
@@ -145,6 +151,17 @@ class DatabaseWorkerPool
             Enqueue(task);
         }
 
+        //! Enqueues a one-way SQL operation in string format that will be executed asynchronously,
+        //! after all operations enqueued before with the same affinity key (e.g. a character guid).
+        void Execute(const char* sql, uint32 affinity)
+        {
+            if (!sql)
+                return;
+
+            BasicStatementTask* task = new BasicStatementTask(sql);
+            Enqueue(task, affinity);
+        }
+
         //! Enqueues a one-way SQL operation in string format -with variable args- that will be executed asynchronously.
         //! This method should only be used for queries that are only executed once, e.g during startup.
         void PExecute(const char* sql, ...)
@@ -169,6 +186,25 @@ class DatabaseWorkerPool
             Enqueue(task);
         }
 
+        //! Enqueues a one-way SQL operation in prepared statement format that will be executed asynchronously,
+        //! after all operations enqueued before with the same affinity key (e.g. a character guid).
+        //! Statement must be prepared with CONNECTION_ASYNC flag.
+        void Execute(PreparedStatement* stmt, uint32 affinity)
+        {
+            PreparedStatementTask* task = new PreparedStatementTask(stmt);
+            Enqueue(task, affinity);
+        }
+
+        //! Enqueues a one-way SQL operation in prepared statement format that touches the rows of many affinity keys
+        //! (e.g. all characters), it is executed after all operations enqueued before with any key.
+        //! Statement must be prepared with CONNECTION_ASYNC flag.
+        void ExecuteForAllKeys(PreparedStatement* stmt)
+        {
+            SQLTransaction trans = BeginTransaction();
+            trans->Append(stmt);
+            CommitTransactionForAllKeys(trans);
+        }
+
         /**
             Direct synchronous one-way statement methods.
         */
@@ -318,6 +354,17 @@ class DatabaseWorkerPool
             return res;
         }
 
+        //! Enqueues a query in prepared format like AsyncQuery, to be executed after all operations enqueued before
+        //! with the same affinity key (e.g. a character guid).
+        //! Statement must be prepared with CONNECTION_ASYNC flag.
+        PreparedQueryResultFuture AsyncQuery(PreparedStatement* stmt, uint32 affinity)
+        {
+            PreparedQueryResultFuture res;
+            PreparedStatementTask* task = new PreparedStatementTask(stmt, res);
+            Enqueue(task, affinity);
+            return res;
+        }
+
         //! Enqueues a vector of SQL operations (can be both adhoc and prepared) that will set the value of the QueryResultHolderFuture
         //! return object as soon as the query is executed.
         //! The return value is then processed in ProcessQueryCallback methods.
@@ -330,6 +377,16 @@ class DatabaseWorkerPool
             return res;     //! Fool compiler, has no use yet
         }
 
+        //! Enqueues a vector of SQL operations like DelayQueryHolder, to be executed after all operations enqueued
+        //! before with the same affinity key (e.g. the guid of the character being loaded).
+        QueryResultHolderFuture DelayQueryHolder(SQLQueryHolder* holder, uint32 affinity)
+        {
+            QueryResultHolderFuture res;
+            SQLQueryHolderTask* task = new SQLQueryHolderTask(holder, res);
+            Enqueue(task, affinity);
+            return res;
+        }
+
         /**
             Transaction context methods.
         */
@@ -364,6 +421,37 @@ class DatabaseWorkerPool
             Enqueue(new TransactionTask(transaction));
         }
 
+        //! Enqueues a collection of one-way SQL operations like CommitTransaction, to be executed after all operations
+        //! enqueued before with the same affinity key (e.g. a character guid).
+        void CommitTransaction(SQLTransaction transaction, uint32 affinity)
+        {
+            Enqueue(new TransactionTask(transaction), affinity);
+        }
+
+        //! Enqueues a transaction of two affinity keys (e.g. a trade between two characters), it is executed after all
+        //! operations enqueued before with either key and before all operations enqueued later with either key.
+        //! Key 0 shares the queue of the operations without key (e.g. guild and auction rows).
+        void CommitTransaction(SQLTransaction transaction, uint32 affinity, uint32 otherAffinity)
+        {
+            uint32 affinities[2] = { affinity, otherAffinity };
+            CommitTransaction(transaction, affinities, 2);
+        }
+
+        //! Enqueues a transaction of three affinity keys (e.g. an auction row and the mails to its seller and buyer),
+        //! ordered like the transactions of two keys.
+        void CommitTransaction(SQLTransaction transaction, uint32 affinity, uint32 secondAffinity, uint32 thirdAffinity)
+        {
+            uint32 affinities[3] = { affinity, secondAffinity, thirdAffinity };
+            CommitTransaction(transaction, affinities, 3);
+        }
+
+        //! Enqueues a transaction that touches the rows of many affinity keys (e.g. all characters), it is executed after
+        //! all operations enqueued before with any key and before all operations enqueued later with any key.
+        void CommitTransactionForAllKeys(SQLTransaction transaction)
+        {
+            EnqueueRendezvous(transaction, _queues);
+        }
+
         //! Directly executes a collection of one-way SQL operations (can be both adhoc and prepared). The order in which these operations
         //! were appended to the transaction will be respected during execution.
         void DirectCommitTransaction(SQLTransaction& transaction)
@@ -451,11 +539,25 @@ class DatabaseWorkerPool
                 }
             }
 
-            //! Assuming all worker threads are free, every worker thread will receive 1 ping operation request
-            //! If one or more worker threads are busy, the ping operations will not be split evenly, but this doesn't matter
-            //! as the sole purpose is to prevent connections from idling.
-            for (size_t i = 0; i < _connections[IDX_ASYNC].size(); ++i)
-                Enqueue(new PingOperation);
+            //! Every worker thread receives 1 ping operation request in its own queue
+            for (size_t i = 0; i < _queues.size(); ++i)
+                Enqueue(new PingOperation, i);
+        }
+
+        //! Sums up the counters of the asynchronous connections, queued are the operations waiting for execution
+        void GetAsyncStats(uint32& queued, DatabaseWorkerStats& stats) const
+        {
+            queued = 0;
+            for (size_t i = 0; i < _queues.size(); ++i)
+                queued += _queues[i]->method_count();
+
+            for (uint8 i = 0; i < _connectionCount[IDX_ASYNC]; ++i)
+            {
+                DatabaseWorkerStats const& workerStats = _connections[IDX_ASYNC][i]->m_worker->GetStats();
+                stats.Executed += workerStats.Executed;
+                stats.TotalLatency += workerStats.TotalLatency;
+                stats.MaxLatency = std::max(stats.MaxLatency, workerStats.MaxLatency);
+            }
         }
 
     private:
@@ -467,24 +569,93 @@ class DatabaseWorkerPool
             return mysql_real_escape_string(_connections[IDX_SYNCH][0]->GetHandle(), to, from, length);
         }
 
+        //! Queues the operation on the first asynchronous connection. Operations without affinity key keep the
+        //! order they were enqueued in, like the ones with a key, since callers rely on it (e.g. a delete and a
+        //! later insert of the same row). This is the queue of affinity key 0.
         void Enqueue(SQLOperation* op)
         {
-            _queue->enqueue(op);
+            ASSERT(!_queues.empty());
+
+            op->m_queueTime = getMSTime();
+            _queues.front()->enqueue(op);
+        }
+
+        //! Queues the operation on the asynchronous connection of the affinity key, operations with the same key
+        //! are executed by the same worker thread in the order they were enqueued
+        void Enqueue(SQLOperation* op, uint32 affinity)
+        {
+            ASSERT(!_queues.empty());
+
+            op->m_queueTime = getMSTime();
+            _queues[affinity % _queues.size()]->enqueue(op);
+        }
+
+        //! Enqueues a transaction on the queues of the affinity keys, the queue of the first key executes it
+        void CommitTransaction(SQLTransaction transaction, uint32 const* affinities, uint32 count)
+        {
+            ASSERT(!_queues.empty());
+
+            std::vector<ACE_Activation_Queue*> queues;
+            for (uint32 i = 0; i < count; ++i)
+            {
+                ACE_Activation_Queue* queue = _queues[affinities[i] % _queues.size()];
+                if (std::find(queues.begin(), queues.end(), queue) == queues.end())
+                    queues.push_back(queue);
+            }
+
+            EnqueueRendezvous(transaction, queues);
+        }
+
+        //! Queues the transaction on the first of the queues and a barrier on each of the others, the transaction runs
+        //! once the workers of all other queues have reached their barrier and holds them until it is done
+        void EnqueueRendezvous(SQLTransaction transaction, std::vector<ACE_Activation_Queue*> const& queues)
+        {
+            ASSERT(!queues.empty());
+
+            uint32 queueTime = getMSTime();
+            if (queues.size() == 1)
+            {
+                SQLOperation* task = new TransactionTask(transaction);
+                task->m_queueTime = queueTime;
+                queues.front()->enqueue(task);
+                return;
+            }
+
+            TransactionRendezvous* rendezvous = new TransactionRendezvous(queues.front(), uint32(queues.size() - 1));
+            SQLOperation* task = new TransactionRendezvousTask(transaction, rendezvous);
+            task->m_queueTime = queueTime;
+
+            //! All rendezvous are enqueued in the same order on every queue, so two of them never wait for each other
+            TRINITY_GUARD(ACE_Thread_Mutex, _rendezvousLock);
+            queues.front()->enqueue(task);
+            for (size_t i = 1; i < queues.size(); ++i)
+            {
+                SQLOperation* barrier = new TransactionRendezvousBarrier(rendezvous);
+                barrier->m_queueTime = queueTime;
+                queues[i]->enqueue(barrier);
+            }
         }
 
         //! Gets a free connection in the synchronous connection pool.
         //! Caller MUST call t->Unlock() after touching the MySQL context to prevent deadlocks.
         T* GetFreeConnection()
         {
-            uint8 i = 0;
             size_t num_cons = _connectionCount[IDX_SYNCH];
-            //! Block forever until a connection is free
+            size_t first = size_t(++_nextSynch) % num_cons;
+
+            //! Block forever until a connection is free, every caller starts at a different one
+            //! and gives up its time slice after each round over all of them
             for (;;)
             {
-                T* t = _connections[IDX_SYNCH][++i % num_cons];
-                //! Must be matched with t->Unlock() or you will get deadlocks
-                if (t->LockIfReady())
-                    return t;
+                for (size_t i = 0; i < num_cons; ++i)
+                {
+                    T* t = _connections[IDX_SYNCH][(first + i) % num_cons];
+                    //! Must be matched with t->Unlock() or you will get deadlocks
+                    if (t->LockIfReady())
+                        return t;
+                }
+
+                ACE_Thread::yield();
             }
 
             //! This will be called when Celine Dion learns to sing
@@ -504,10 +675,15 @@ class DatabaseWorkerPool
             IDX_SIZE,
         };
 
-        ACE_Activation_Queue*           _queue;             //! Queue shared by async worker threads.
+        //! Queue of each async connection. Not a LockFreeQueue although every queue has a single consumer:
+        //! the worker sleeps in a blocking dequeue and is woken by closing the queue on shutdown, and a
+        //! bounded ring can not hold a write backlog without stalling the map threads or dropping writes.
+        std::vector<ACE_Activation_Queue*> _queues;
         std::vector< std::vector<T*> >  _connections;
         uint32                          _connectionCount[2];       //! Counter of MySQL connections;
         MySQLConnectionInfo             _connectionInfo;
+        ACE_Atomic_Op<ACE_Thread_Mutex, long> _nextSynch;   //! Rotates the first synchronous connection tried.
+        ACE_Thread_Mutex _rendezvousLock;                   //! Enqueues the two operations of a rendezvous together.
 };
 
 #endif
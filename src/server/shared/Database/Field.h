@@ -258,7 +258,7 @@ class Field
         struct
         {
             uint32 length;          // Length (prepared strings only)
-            void* value;            // Actual data in memory
+            void* value;            // Actual data in memory, owned by the result set
             enum_field_types type;  // Field type
             bool raw;               // Raw bytes? (Prepared statement or ad hoc)
          } data;
@@ -268,14 +268,9 @@ class Field
         #pragma pack(pop)
         #endif
 
-        void SetByteValue(void const* newValue, size_t const newSize, enum_field_types newType, uint32 length);
-        void SetStructuredValue(char* newValue, enum_field_types newType);
-
-        void CleanUp()
-        {
-            delete[] ((char*)data.value);
-            data.value = NULL;
-        }
+        // values are not copied, they stay valid as long as the row is the current row of its result set
+        void SetByteValue(void const* newValue, enum_field_types newType, uint32 length);
+        void SetStructuredValue(char const* newValue, enum_field_types newType, uint32 length);
 
         static size_t SizeForType(MYSQL_FIELD* field)
         {
@@ -135,8 +135,8 @@ enum CharacterDatabaseStatements
     CHAR_UPD_MAIL_RETURNED,
     CHAR_UPD_MAIL_ITEM_RECEIVER,
     CHAR_UPD_ITEM_OWNER,
-    CHAR_SEL_ITEM_REFUNDS,
-    CHAR_SEL_ITEM_BOP_TRADE,
+    CHAR_SEL_CHARACTER_ITEM_REFUNDS,
+    CHAR_SEL_CHARACTER_ITEM_BOP_TRADE,
     CHAR_DEL_ITEM_BOP_TRADE,
     CHAR_INS_ITEM_BOP_TRADE,
     CHAR_REP_INVENTORY_ITEM,
@@ -35,6 +35,7 @@
 MySQLConnection::MySQLConnection(MySQLConnectionInfo& connInfo) :
 m_reconnecting(false),
 m_prepareError(false),
+m_inTransaction(false),
 m_queue(NULL),
 m_worker(NULL),
 m_Mysql(NULL),
@@ -46,6 +47,7 @@ m_connectionFlags(CONNECTION_SYNCH)
 MySQLConnection::MySQLConnection(ACE_Activation_Queue* queue, MySQLConnectionInfo& connInfo) :
 m_reconnecting(false),
 m_prepareError(false),
+m_inTransaction(false),
 m_queue(queue),
 m_Mysql(NULL),
 m_connectionInfo(connInfo),
@@ -210,10 +212,11 @@ bool MySQLConnection::Execute(PreparedStatement* stmt)
             uint32 lErrno = mysql_errno(m_Mysql);
             sLog->outSQLDriver("SQL(p): %s\n [ERROR]: [%u] %s", m_mStmt->getQueryString(m_queries[index].first).c_str(), lErrno, mysql_stmt_error(msql_STMT));
 
+            m_mStmt->ClearParameters();         // the statement is prepared again when reconnecting
+
             if (_HandleMySQLErrno(lErrno))  // If it returns true, an error was handled successfully (i.e. reconnection)
                 return Execute(stmt);       // Try again
 
-            m_mStmt->ClearParameters();
             return false;
         }
 
@@ -222,10 +225,11 @@ bool MySQLConnection::Execute(PreparedStatement* stmt)
             uint32 lErrno = mysql_errno(m_Mysql);
             sLog->outSQLDriver("SQL(p): %s\n [ERROR]: [%u] %s", m_mStmt->getQueryString(m_queries[index].first).c_str(), lErrno, mysql_stmt_error(msql_STMT));
 
+            m_mStmt->ClearParameters();         // the statement is prepared again when reconnecting
+
             if (_HandleMySQLErrno(lErrno))  // If it returns true, an error was handled successfully (i.e. reconnection)
                 return Execute(stmt);       // Try again
 
-            m_mStmt->ClearParameters();
             return false;
         }
 
@@ -263,10 +267,11 @@ bool MySQLConnection::_Query(PreparedStatement* stmt, MYSQL_RES **pResult, uint6
             uint32 lErrno = mysql_errno(m_Mysql);
             sLog->outSQLDriver("SQL(p): %s\n [ERROR]: [%u] %s", m_mStmt->getQueryString(m_queries[index].first).c_str(), lErrno, mysql_stmt_error(msql_STMT));
 
+            m_mStmt->ClearParameters();         // the statement is prepared again when reconnecting
+
             if (_HandleMySQLErrno(lErrno))  // If it returns true, an error was handled successfully (i.e. reconnection)
                 return _Query(stmt, pResult, pRowCount, pFieldCount);       // Try again
 
-            m_mStmt->ClearParameters();
             return false;
         }
 
@@ -276,10 +281,11 @@ bool MySQLConnection::_Query(PreparedStatement* stmt, MYSQL_RES **pResult, uint6
             sLog->outSQLDriver("SQL(p): %s\n [ERROR]: [%u] %s",
                 m_mStmt->getQueryString(m_queries[index].first).c_str(), lErrno, mysql_stmt_error(msql_STMT));
 
+            m_mStmt->ClearParameters();         // the statement is prepared again when reconnecting
+
             if (_HandleMySQLErrno(lErrno))  // If it returns true, an error was handled successfully (i.e. reconnection)
                 return _Query(stmt, pResult, pRowCount, pFieldCount);      // Try again
 
-            m_mStmt->ClearParameters();
             return false;
         }
 
@@ -361,15 +367,18 @@ bool MySQLConnection::_Query(const char *sql, MYSQL_RES **pResult, MYSQL_FIELD *
 void MySQLConnection::BeginTransaction()
 {
     Execute("START TRANSACTION");
+    m_inTransaction = true;
 }
 
 void MySQLConnection::RollbackTransaction()
 {
+    m_inTransaction = false;
     Execute("ROLLBACK");
 }
 
 void MySQLConnection::CommitTransaction()
 {
+    m_inTransaction = false;
     Execute("COMMIT");
 }
 
@@ -510,6 +519,15 @@ bool MySQLConnection::_HandleMySQLErrno(uint32 errNo)
                             (m_connectionFlags & CONNECTION_ASYNC) ? "asynchronous" : "synchronous");
 
                 m_reconnecting = false;
+
+                // the server rolled back the open transaction with the old connection, retrying only the
+                // failed query would commit it without the queries before; the transaction fails instead
+                if (m_inTransaction)
+                {
+                    sLog->outSQLDriver("[Warning] Transaction lost with the connection, its queries are not retried.");
+                    return false;
+                }
+
                 return true;
             }
 
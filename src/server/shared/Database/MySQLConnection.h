@@ -123,6 +123,7 @@ class MySQLConnection
         PreparedStatementMap                 m_queries;       //! Query storage
         bool                                 m_reconnecting;  //! Are we reconnecting?
         bool                                 m_prepareError;  //! Was there any error while preparing statements?
+        bool                                 m_inTransaction; //! Between BeginTransaction and its commit or rollback
 
     private:
         bool _HandleMySQLErrno(uint32 errNo);
@@ -37,7 +37,10 @@ m_rBind(NULL),
 m_stmt(stmt),
 m_res(result),
 m_isNull(NULL),
-m_length(NULL)
+m_length(NULL),
+m_rowBuffer(NULL),
+m_rowSize(0),
+m_currentRow(NULL)
 {
     if (!m_res)
         return;
@@ -64,15 +67,18 @@ m_length(NULL)
     }
 
     //- This is where we prepare the buffer based on metadata
+    //- Every column starts 8 byte aligned so that the values can be read in place
+    m_columnOffsets.resize(m_fieldCount);
     uint32 i = 0;
     MYSQL_FIELD* field = mysql_fetch_field(m_res);
     while (field)
     {
         size_t size = Field::SizeForType(field);
 
+        m_columnOffsets[i] = m_rowSize;
+        m_rowSize += (size + 7) & ~size_t(7);
+
         m_rBind[i].buffer_type = field->type;
-        m_rBind[i].buffer = malloc(size);
-        memset(m_rBind[i].buffer, 0, size);
         m_rBind[i].buffer_length = size;
         m_rBind[i].length = &m_length[i];
         m_rBind[i].is_null = &m_isNull[i];
@@ -83,10 +89,15 @@ m_length(NULL)
         field = mysql_fetch_field(m_res);
     }
 
+    m_rowBuffer = static_cast<char*>(calloc(m_rowSize ? m_rowSize : 1, 1));
+    for (i = 0; i < m_fieldCount; ++i)
+        m_rBind[i].buffer = m_rowBuffer + m_columnOffsets[i];
+
     //- This is where we bind the bind the buffer to the statement
     if (mysql_stmt_bind_result(m_stmt, m_rBind))
     {
         sLog->outSQLDriver("%s:mysql_stmt_bind_result, cannot bind result from MySQL server. Error: %s", __FUNCTION__, mysql_stmt_error(m_stmt));
+        free(m_rowBuffer);
         delete[] m_rBind;
         delete[] m_isNull;
         delete[] m_length;
@@ -95,42 +106,38 @@ m_length(NULL)
 
     m_rowCount = mysql_stmt_num_rows(m_stmt);
 
-    m_rows.resize(uint32(m_rowCount));
+    m_rowData.resize(size_t(m_rowCount) * m_rowSize);
+    m_lengths.resize(size_t(m_rowCount) * m_fieldCount);
     while (_NextRow())
     {
-        m_rows[uint32(m_rowPosition)] = new Field[m_fieldCount];
-        for (uint64 fIndex = 0; fIndex < m_fieldCount; ++fIndex)
+        char* row = GetRowData();
+        uint32* lengths = GetRowLengths();
+
+        memcpy(row, m_rowBuffer, m_rowSize);
+
+        for (uint32 fIndex = 0; fIndex < m_fieldCount; ++fIndex)
         {
-            if (!*m_rBind[fIndex].is_null)
-                m_rows[uint32(m_rowPosition)][fIndex].SetByteValue( m_rBind[fIndex].buffer,
-                                                            m_rBind[fIndex].buffer_length,
-                                                            m_rBind[fIndex].buffer_type,
-                                                           *m_rBind[fIndex].length );
+            // NULL reads as 0 or an empty string
+            if (m_isNull[fIndex])
+            {
+                memset(row + m_columnOffsets[fIndex], 0, m_rBind[fIndex].buffer_length);
+                lengths[fIndex] = 0;
+            }
             else
-                switch (m_rBind[fIndex].buffer_type)
-                {
-                    case MYSQL_TYPE_TINY_BLOB:
-                    case MYSQL_TYPE_MEDIUM_BLOB:
-                    case MYSQL_TYPE_LONG_BLOB:
-                    case MYSQL_TYPE_BLOB:
-                    case MYSQL_TYPE_STRING:
-                    case MYSQL_TYPE_VAR_STRING:
-                    m_rows[uint32(m_rowPosition)][fIndex].SetByteValue( "",
-                                                            m_rBind[fIndex].buffer_length,
-                                                            m_rBind[fIndex].buffer_type,
-                                                           *m_rBind[fIndex].length );
-                    break;
-                    default:
-                    m_rows[uint32(m_rowPosition)][fIndex].SetByteValue( 0,
-                                                            m_rBind[fIndex].buffer_length,
-                                                            m_rBind[fIndex].buffer_type,
-                                                           *m_rBind[fIndex].length );
-                }
+                lengths[fIndex] = m_length[fIndex];
         }
+
         m_rowPosition++;
     }
     m_rowPosition = 0;
 
+    m_currentRow = new Field[m_fieldCount];
+    for (i = 0; i < m_fieldCount; ++i)
+        m_currentRow[i].data.type = m_rBind[i].buffer_type;
+
+    if (m_rowCount)
+        SetCurrentRow();
+
     /// All data is buffered, let go of mysql c api structures
     CleanUp();
 }
@@ -142,8 +149,7 @@ ResultSet::~ResultSet()
 
 PreparedResultSet::~PreparedResultSet()
 {
-    for (uint32 i = 0; i < uint32(m_rowCount); ++i)
-        delete[] m_rows[i];
+    delete[] m_currentRow;
 }
 
 bool ResultSet::NextRow()
@@ -160,8 +166,9 @@ bool ResultSet::NextRow()
         return false;
     }
 
+    unsigned long* lengths = mysql_fetch_lengths(_result);
     for (uint32 i = 0; i < _fieldCount; i++)
-        _currentRow[i].SetStructuredValue(row[i], _fields[i].type);
+        _currentRow[i].SetStructuredValue(row[i], _fields[i].type, lengths[i]);
 
     return true;
 }
@@ -173,9 +180,19 @@ bool PreparedResultSet::NextRow()
     if (++m_rowPosition >= m_rowCount)
         return false;
 
+    SetCurrentRow();
     return true;
 }
 
+void PreparedResultSet::SetCurrentRow()
+{
+    char* row = GetRowData();
+    uint32 const* lengths = GetRowLengths();
+
+    for (uint32 i = 0; i < m_fieldCount; ++i)
+        m_currentRow[i].SetByteValue(row + m_columnOffsets[i], m_currentRow[i].data.type, lengths[i]);
+}
+
 bool PreparedResultSet::_NextRow()
 {
     /// Only called in low-level code, namely the constructor
@@ -223,6 +240,6 @@ void PreparedResultSet::CleanUp()
 
 void PreparedResultSet::FreeBindBuffer()
 {
-    for (uint32 i = 0; i < m_fieldCount; ++i)
-        free (m_rBind[i].buffer);
+    free(m_rowBuffer);
+    m_rowBuffer = NULL;
 }
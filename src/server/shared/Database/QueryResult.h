@@ -21,6 +21,7 @@
 
 #include "AutoPtr.h"
 #include <ace/Thread_Mutex.h>
+#include <vector>
 
 #include "Field.h"
 #include "Log.h"
@@ -73,18 +74,17 @@ class PreparedResultSet
         Field* Fetch() const
         {
             ASSERT(m_rowPosition < m_rowCount);
-            return m_rows[uint32(m_rowPosition)];
+            return m_currentRow;
         }
 
         const Field & operator [] (uint32 index) const
         {
             ASSERT(m_rowPosition < m_rowCount);
             ASSERT(index < m_fieldCount);
-            return m_rows[uint32(m_rowPosition)][index];
+            return m_currentRow[index];
         }
 
     protected:
-        std::vector<Field*> m_rows;
         uint64 m_rowCount;
         uint64 m_rowPosition;
         uint32 m_fieldCount;
@@ -97,6 +97,18 @@ class PreparedResultSet
         my_bool* m_isNull;
         unsigned long* m_length;
 
+        // The bind buffers of all columns are one block of m_rowSize bytes, each fetched row is copied
+        // as a whole into m_rowData. Fields of the current row point into it, no memory is allocated per row.
+        char* m_rowBuffer;
+        uint32 m_rowSize;
+        std::vector<uint32> m_columnOffsets;
+        std::vector<char> m_rowData;
+        std::vector<uint32> m_lengths;                      // of every value, row by row
+        Field* m_currentRow;
+
+        char* GetRowData() { return m_rowSize ? &m_rowData[size_t(m_rowPosition) * m_rowSize] : m_rowBuffer; }
+        uint32* GetRowLengths() { return m_fieldCount ? &m_lengths[size_t(m_rowPosition) * m_fieldCount] : NULL; }
+        void SetCurrentRow();
         void FreeBindBuffer();
         void CleanUp();
         bool _NextRow();
@@ -59,7 +59,7 @@ class MySQLConnection;
 class SQLOperation : public ACE_Method_Request
 {
     public:
-        SQLOperation(): m_conn(NULL) {};
+        SQLOperation(): m_conn(NULL), m_queueTime(0) {};
         virtual int call()
         {
             Execute();
@@ -69,6 +69,7 @@ class SQLOperation : public ACE_Method_Request
         virtual void SetConnection(MySQLConnection* con) { m_conn = con; }
 
         MySQLConnection* m_conn;
+        uint32 m_queueTime;                                 //! getMSTime() of enqueueing
 };
 
 #endif
@@ -90,3 +90,66 @@ bool TransactionTask::Execute()
 
     return false;
 }
+
+TransactionRendezvous::TransactionRendezvous(ACE_Activation_Queue* taskQueue, uint32 barriers) : m_mutex(), m_condition(m_mutex),
+m_taskQueue(taskQueue), m_references(barriers + 1), m_barriers(barriers), m_reached(0), m_started(false), m_released(false)
+{
+}
+
+void TransactionRendezvous::WaitForBarrier()
+{
+    TRINITY_GUARD(ACE_Thread_Mutex, m_mutex);
+    m_started = true;
+    while (m_reached < m_barriers)
+        m_condition.wait();
+}
+
+void TransactionRendezvous::Release()
+{
+    TRINITY_GUARD(ACE_Thread_Mutex, m_mutex);
+    m_released = true;
+    m_condition.broadcast();
+}
+
+void TransactionRendezvous::Hold()
+{
+    TRINITY_GUARD(ACE_Thread_Mutex, m_mutex);
+    ++m_reached;
+    m_condition.broadcast();
+
+    while (!m_released)
+    {
+        // the queue of the task is flushed when the pool is closed, don't wait for a task that never runs
+        if (!m_started && m_taskQueue->queue()->deactivated())
+            return;
+
+        ACE_Time_Value timeout = ACE_OS::gettimeofday() + ACE_Time_Value(1);
+        m_condition.wait(&timeout);
+    }
+}
+
+void TransactionRendezvous::RemoveReference()
+{
+    bool last;
+    {
+        TRINITY_GUARD(ACE_Thread_Mutex, m_mutex);
+        last = --m_references == 0;
+    }
+
+    if (last)
+        delete this;
+}
+
+bool TransactionRendezvousTask::Execute()
+{
+    m_rendezvous->WaitForBarrier();
+    bool result = TransactionTask::Execute();
+    m_rendezvous->Release();
+    return result;
+}
+
+bool TransactionRendezvousBarrier::Execute()
+{
+    m_rendezvous->Hold();
+    return true;
+}
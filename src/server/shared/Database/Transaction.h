@@ -20,6 +20,9 @@
 
 #include "SQLOperation.h"
 
+#include <ace/Thread_Mutex.h>
+#include <ace/Condition_Thread_Mutex.h>
+
 //- Forward declare (don't include header to prevent circular includes)
 class PreparedStatement;
 
@@ -65,4 +68,55 @@ class TransactionTask : public SQLOperation
         SQLTransaction m_trans;
 };
 
+/*! Low level class: orders a transaction with the operations of other asynchronous connections (e.g. a trade
+    of two characters, or a statement touching the rows of all characters). The transaction task runs on one
+    connection once the workers of the other connections have reached their barriers, which hold these workers
+    until the transaction is done. */
+class TransactionRendezvous
+{
+    public:
+        TransactionRendezvous(ACE_Activation_Queue* taskQueue, uint32 barriers);
+
+        void WaitForBarrier();                              //! Transaction task, before executing
+        void Release();                                     //! Transaction task, after executing
+        void Hold();                                        //! Barrier on another connection
+
+        void RemoveReference();                             //! Deleted by the last of the task and the barriers
+
+    private:
+        ACE_Thread_Mutex m_mutex;
+        ACE_Condition_Thread_Mutex m_condition;
+        ACE_Activation_Queue* m_taskQueue;                  //! A closed queue never runs a task not started yet
+        uint32 m_references;
+        uint32 m_barriers;
+        uint32 m_reached;
+        bool m_started;
+        bool m_released;
+};
+
+class TransactionRendezvousTask : public TransactionTask
+{
+    public:
+        TransactionRendezvousTask(SQLTransaction trans, TransactionRendezvous* rendezvous) : TransactionTask(trans), m_rendezvous(rendezvous) {}
+        ~TransactionRendezvousTask() { m_rendezvous->RemoveReference(); }
+
+    protected:
+        bool Execute();
+
+    private:
+        TransactionRendezvous* m_rendezvous;
+};
+
+class TransactionRendezvousBarrier : public SQLOperation
+{
+    public:
+        explicit TransactionRendezvousBarrier(TransactionRendezvous* rendezvous) : m_rendezvous(rendezvous) {}
+        ~TransactionRendezvousBarrier() { m_rendezvous->RemoveReference(); }
+
+        bool Execute();
+
+    private:
+        TransactionRendezvous* m_rendezvous;
+};
+
 #endif
\ No newline at end of file
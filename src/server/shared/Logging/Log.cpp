@@ -20,6 +20,7 @@
 #include "Log.h"
 #include "Configuration/Config.h"
 #include "Util.h"
+#include "LogWorker.h"
 
 #include "Implementation/LoginDatabase.h" // For logging
 extern LoginDatabaseWorkerPool LoginDatabase;
@@ -31,13 +32,15 @@ Log::Log() :
     raLogfile(NULL), logfile(NULL), gmLogfile(NULL), charLogfile(NULL),
     dberLogfile(NULL), chatLogfile(NULL), arenaLogFile(NULL), sqlLogFile(NULL), sqlDevLogFile(NULL), wardenLogFile(NULL),
     m_gmlog_per_account(false), m_enableLogDBLater(false),
-    m_enableLogDB(false), m_colored(false)
+    m_enableLogDB(false), m_colored(false), m_worker(NULL)
 {
     Initialize();
 }
 
 Log::~Log()
 {
+    StopAsyncWriter();
+
     if (logfile != NULL)
         fclose(logfile);
     logfile = NULL;
@@ -190,6 +193,19 @@ void Log::Initialize()
             if ((m_dumpsDir.at(m_dumpsDir.length() - 1) != '/') && (m_dumpsDir.at(m_dumpsDir.length() - 1) != '\\'))
                 m_dumpsDir.push_back('/');
     }
+
+    // Writer thread for the asynchronous mode, started once
+    if (!m_worker && ConfigMgr::GetBoolDefault("LogAsync", false))
+    {
+        LogWorker* worker = new LogWorker();
+        if (worker->Start())
+        {
+            TRINITY_WRITE_GUARD(ACE_RW_Thread_Mutex, m_workerLock);
+            m_worker = worker;
+        }
+        else
+            delete worker;
+    }
 }
 
 void Log::ReloadConfig()
@@ -370,6 +386,106 @@ std::string Log::GetTimestampStr()
     return std::string(buf);
 }
 
+void Log::StopAsyncWriter()
+{
+    // log calls from now on are written directly, the writer finishes what was queued so far;
+    // the write lock waits for log calls still handing messages to the writer
+    LogWorker* worker;
+    {
+        TRINITY_WRITE_GUARD(ACE_RW_Thread_Mutex, m_workerLock);
+        worker = m_worker;
+        m_worker = NULL;
+    }
+
+    if (!worker)
+        return;
+
+    worker->Stop();
+    delete worker;
+}
+
+void Log::outConsole(bool stdoutStream, int8 color, const char* text, bool newLine)
+{
+    FILE* out = stdoutStream ? stdout : stderr;
+
+    if (!m_colored)
+        color = -1;
+
+    {
+        TRINITY_READ_GUARD(ACE_RW_Thread_Mutex, m_workerLock);
+        if (m_worker)
+        {
+            LogMessage* message = new LogMessage();
+            message->File = out;
+            message->Color = color;
+            message->NewLine = newLine;
+            message->Text = text;
+            m_worker->Enqueue(message);
+            return;
+        }
+    }
+
+    if (color >= 0)
+        SetColor(stdoutStream, ColorTypes(color));
+
+    utf8printf(out, "%s", text);
+
+    if (color >= 0)
+        ResetColor(stdoutStream);
+
+    if (newLine)
+    {
+        fprintf(out, "\n");
+        fflush(out);
+    }
+}
+
+void Log::outFile(FILE* file, bool timestamp, const char* prefix, const char* text, bool newLine, bool closeFile)
+{
+    {
+        TRINITY_READ_GUARD(ACE_RW_Thread_Mutex, m_workerLock);
+        if (m_worker)
+        {
+            LogMessage* message = new LogMessage();
+            message->File = file;
+            message->NewLine = newLine;
+            message->CloseFile = closeFile;
+
+            if (timestamp)
+            {
+                char buf[21];
+                time_t t = time(NULL);
+                tm* aTm = localtime(&t);
+                snprintf(buf, 21, "%-4d-%02d-%02d %02d:%02d:%02d ", aTm->tm_year+1900, aTm->tm_mon+1, aTm->tm_mday, aTm->tm_hour, aTm->tm_min, aTm->tm_sec);
+                message->Text = buf;
+            }
+
+            if (prefix)
+                message->Text += prefix;
+
+            message->Text += text;
+            m_worker->Enqueue(message);
+            return;
+        }
+    }
+
+    if (timestamp)
+        outTimestamp(file);
+
+    if (prefix)
+        fputs(prefix, file);
+
+    fputs(text, file);
+
+    if (newLine)
+        fputc('\n', file);
+
+    if (closeFile)
+        fclose(file);
+    else if (newLine)
+        fflush(file);
+}
+
 void Log::outDB(LogTypes type, const char * str)
 {
     if (!str || type >= MAX_LOG_TYPES)
@@ -379,6 +495,21 @@ void Log::outDB(LogTypes type, const char * str)
     if (logStr.empty())
         return;
 
+    {
+        TRINITY_READ_GUARD(ACE_RW_Thread_Mutex, m_workerLock);
+        if (m_worker)
+        {
+            // rows are collected by the writer and inserted together
+            LogMessage* message = new LogMessage();
+            message->Realm = realm;
+            message->Type = uint8(type);
+            message->Time = uint32(time(NULL));
+            message->Text = logStr;
+            m_worker->Enqueue(message);
+            return;
+        }
+    }
+
     PreparedStatement* stmt = LoginDatabase.GetPreparedStatement(LOGIN_INS_LOG);
 
     stmt->setInt32(0, realm);
@@ -393,6 +524,12 @@ void Log::outString(const char * str, ...)
     if (!str)
         return;
 
+    char text[MAX_QUERY_LEN];
+    va_list ap;
+    va_start(ap, str);
+    vsnprintf(text, MAX_QUERY_LEN, str, ap);
+    va_end(ap);
+
     if (m_enableLogDB)
     {
         // we don't want empty strings in the DB
@@ -400,50 +537,21 @@ void Log::outString(const char * str, ...)
         if (s.empty() || s == " ")
             return;
 
-        va_list ap2;
-        va_start(ap2, str);
-        char nnew_str[MAX_QUERY_LEN];
-        vsnprintf(nnew_str, MAX_QUERY_LEN, str, ap2);
-        outDB(LOG_TYPE_STRING, nnew_str);
-        va_end(ap2);
+        outDB(LOG_TYPE_STRING, text);
     }
 
-    if (m_colored)
-        SetColor(true, m_colors[LOGL_NORMAL]);
-
-    va_list ap;
-
-    va_start(ap, str);
-    vutf8printf(stdout, str, &ap);
-    va_end(ap);
+    outConsole(true, m_colors[LOGL_NORMAL], text);
 
-    if (m_colored)
-        ResetColor(true);
-
-    printf("\n");
     if (logfile)
-    {
-        outTimestamp(logfile);
-        va_start(ap, str);
-        vfprintf(logfile, str, ap);
-        fprintf(logfile, "\n");
-        va_end(ap);
-
-        fflush(logfile);
-    }
-    fflush(stdout);
+        outFile(logfile, true, NULL, text);
 }
 
 void Log::outString()
 {
-    printf("\n");
+    outConsole(true, -1, "");
+
     if (logfile)
-    {
-        outTimestamp(logfile);
-        fprintf(logfile, "\n");
-        fflush(logfile);
-    }
-    fflush(stdout);
+        outFile(logfile, true, NULL, "");
 }
 
 void Log::outCrash(const char * err, ...)
@@ -451,42 +559,19 @@ void Log::outCrash(const char * err, ...)
     if (!err)
         return;
 
-    if (m_enableLogDB)
-    {
-        va_list ap2;
-        va_start(ap2, err);
-        char nnew_str[MAX_QUERY_LEN];
-        vsnprintf(nnew_str, MAX_QUERY_LEN, err, ap2);
-        outDB(LOG_TYPE_CRASH, nnew_str);
-        va_end(ap2);
-    }
-
-    if (m_colored)
-        SetColor(false, LRED);
-
+    char text[MAX_QUERY_LEN];
     va_list ap;
-
     va_start(ap, err);
-    vutf8printf(stderr, err, &ap);
+    vsnprintf(text, MAX_QUERY_LEN, err, ap);
     va_end(ap);
 
-    if (m_colored)
-        ResetColor(false);
-
-    fprintf(stderr, "\n");
-    if (logfile)
-    {
-        outTimestamp(logfile);
-        fprintf(logfile, "CRASH ALERT: ");
+    if (m_enableLogDB)
+        outDB(LOG_TYPE_CRASH, text);
 
-        va_start(ap, err);
-        vfprintf(logfile, err, ap);
-        va_end(ap);
+    outConsole(false, LRED, text);
 
-        fprintf(logfile, "\n");
-        fflush(logfile);
-    }
-    fflush(stderr);
+    if (logfile)
+        outFile(logfile, true, "CRASH ALERT: ", text);
 }
 
 void Log::outError(const char * err, ...)
@@ -494,42 +579,19 @@ void Log::outError(const char * err, ...)
     if (!err)
         return;
 
-    if (m_enableLogDB)
-    {
-        va_list ap2;
-        va_start(ap2, err);
-        char nnew_str[MAX_QUERY_LEN];
-        vsnprintf(nnew_str, MAX_QUERY_LEN, err, ap2);
-        outDB(LOG_TYPE_ERROR, nnew_str);
-        va_end(ap2);
-    }
-
-    if (m_colored)
-        SetColor(false, LRED);
-
+    char text[MAX_QUERY_LEN];
     va_list ap;
-
     va_start(ap, err);
-    vutf8printf(stderr, err, &ap);
+    vsnprintf(text, MAX_QUERY_LEN, err, ap);
     va_end(ap);
 
-    if (m_colored)
-        ResetColor(false);
-
-    fprintf( stderr, "\n");
-    if (logfile)
-    {
-        outTimestamp(logfile);
-        fprintf(logfile, "ERROR: ");
+    if (m_enableLogDB)
+        outDB(LOG_TYPE_ERROR, text);
 
-        va_start(ap, err);
-        vfprintf(logfile, err, ap);
-        va_end(ap);
+    outConsole(false, LRED, text);
 
-        fprintf(logfile, "\n");
-        fflush(logfile);
-    }
-    fflush(stderr);
+    if (logfile)
+        outFile(logfile, true, "ERROR: ", text);
 }
 
 void Log::outArena(const char * str, ...)
@@ -539,13 +601,13 @@ void Log::outArena(const char * str, ...)
 
     if (arenaLogFile)
     {
+        char text[MAX_QUERY_LEN];
         va_list ap;
-        outTimestamp(arenaLogFile);
         va_start(ap, str);
-        vfprintf(arenaLogFile, str, ap);
-        fprintf(arenaLogFile, "\n");
+        vsnprintf(text, MAX_QUERY_LEN, str, ap);
         va_end(ap);
-        fflush(arenaLogFile);
+
+        outFile(arenaLogFile, true, NULL, text);
     }
 }
 
@@ -554,27 +616,16 @@ void Log::outSQLDriver(const char* str, ...)
     if (!str)
         return;
 
+    char text[MAX_QUERY_LEN];
     va_list ap;
     va_start(ap, str);
-    vutf8printf(stdout, str, &ap);
+    vsnprintf(text, MAX_QUERY_LEN, str, ap);
     va_end(ap);
 
-    printf("\n");
+    outConsole(true, -1, text);
 
     if (sqlLogFile)
-    {
-        outTimestamp(sqlLogFile);
-
-        va_list apSQL;
-        va_start(apSQL, str);
-        vfprintf(sqlLogFile, str, apSQL);
-        va_end(apSQL);
-
-        fprintf(sqlLogFile, "\n");
-        fflush(sqlLogFile);
-    }
-
-    fflush(stdout);
+        outFile(sqlLogFile, true, NULL, text);
 }
 
 void Log::outErrorDb(const char * err, ...)
@@ -582,44 +633,19 @@ void Log::outErrorDb(const char * err, ...)
     if (!err)
         return;
 
-    if (m_colored)
-        SetColor(false, LRED);
-
+    char text[MAX_QUERY_LEN];
     va_list ap;
-
     va_start(ap, err);
-    vutf8printf(stderr, err, &ap);
+    vsnprintf(text, MAX_QUERY_LEN, err, ap);
     va_end(ap);
 
-    if (m_colored)
-        ResetColor(false);
-
-    fprintf( stderr, "\n" );
+    outConsole(false, LRED, text);
 
     if (logfile)
-    {
-        outTimestamp(logfile);
-        fprintf(logfile, "ERROR: " );
-
-        va_start(ap, err);
-        vfprintf(logfile, err, ap);
-        va_end(ap);
-
-        fprintf(logfile, "\n" );
-        fflush(logfile);
-    }
+        outFile(logfile, true, "ERROR: ", text);
 
     if (dberLogfile)
-    {
-        outTimestamp(dberLogfile);
-        va_start(ap, err);
-        vfprintf(dberLogfile, err, ap);
-        va_end(ap);
-
-        fprintf(dberLogfile, "\n" );
-        fflush(dberLogfile);
-    }
-    fflush(stderr);
+        outFile(dberLogfile, true, NULL, text);
 }
 
 void Log::outBasic(const char * str, ...)
@@ -627,43 +653,26 @@ void Log::outBasic(const char * str, ...)
     if (!str)
         return;
 
-    if (m_enableLogDB && m_dbLogLevel > LOGL_NORMAL)
-    {
-        va_list ap2;
-        va_start(ap2, str);
-        char nnew_str[MAX_QUERY_LEN];
-        vsnprintf(nnew_str, MAX_QUERY_LEN, str, ap2);
-        outDB(LOG_TYPE_BASIC, nnew_str);
-        va_end(ap2);
-    }
-
-    if (m_logLevel > LOGL_NORMAL)
-    {
-        if (m_colored)
-            SetColor(true, m_colors[LOGL_BASIC]);
+    bool db = m_enableLogDB && m_dbLogLevel > LOGL_NORMAL;
+    if (!db && m_logLevel <= LOGL_NORMAL)
+        return;
 
-        va_list ap;
-        va_start(ap, str);
-        vutf8printf(stdout, str, &ap);
-        va_end(ap);
+    char text[MAX_QUERY_LEN];
+    va_list ap;
+    va_start(ap, str);
+    vsnprintf(text, MAX_QUERY_LEN, str, ap);
+    va_end(ap);
 
-        if (m_colored)
-            ResetColor(true);
+    if (db)
+        outDB(LOG_TYPE_BASIC, text);
 
-        printf("\n");
+    if (m_logLevel > LOGL_NORMAL)
+    {
+        outConsole(true, m_colors[LOGL_BASIC], text);
 
         if (logfile)
-        {
-            outTimestamp(logfile);
-            va_list ap2;
-            va_start(ap2, str);
-            vfprintf(logfile, str, ap2);
-            fprintf(logfile, "\n" );
-            va_end(ap2);
-            fflush(logfile);
-        }
+            outFile(logfile, true, NULL, text);
     }
-    fflush(stdout);
 }
 
 void Log::outDetail(const char * str, ...)
@@ -671,45 +680,26 @@ void Log::outDetail(const char * str, ...)
     if (!str)
         return;
 
-    if (m_enableLogDB && m_dbLogLevel > LOGL_BASIC)
-    {
-        va_list ap2;
-        va_start(ap2, str);
-        char nnew_str[MAX_QUERY_LEN];
-        vsnprintf(nnew_str, MAX_QUERY_LEN, str, ap2);
-        outDB(LOG_TYPE_DETAIL, nnew_str);
-        va_end(ap2);
-    }
-
-    if (m_logLevel > LOGL_BASIC)
-    {
-        if (m_colored)
-            SetColor(true, m_colors[LOGL_DETAIL]);
+    bool db = m_enableLogDB && m_dbLogLevel > LOGL_BASIC;
+    if (!db && m_logLevel <= LOGL_BASIC)
+        return;
 
-        va_list ap;
-        va_start(ap, str);
-        vutf8printf(stdout, str, &ap);
-        va_end(ap);
+    char text[MAX_QUERY_LEN];
+    va_list ap;
+    va_start(ap, str);
+    vsnprintf(text, MAX_QUERY_LEN, str, ap);
+    va_end(ap);
 
-        if (m_colored)
-            ResetColor(true);
+    if (db)
+        outDB(LOG_TYPE_DETAIL, text);
 
-        printf("\n");
+    if (m_logLevel > LOGL_BASIC)
+    {
+        outConsole(true, m_colors[LOGL_DETAIL], text);
 
         if (logfile)
-        {
-            outTimestamp(logfile);
-            va_list ap2;
-            va_start(ap2, str);
-            vfprintf(logfile, str, ap2);
-            va_end(ap2);
-
-            fprintf(logfile, "\n");
-            fflush(logfile);
-        }
+            outFile(logfile, true, NULL, text);
     }
-
-    fflush(stdout);
 }
 
 void Log::outDebugInLine(const char * str, ...)
@@ -719,21 +709,16 @@ void Log::outDebugInLine(const char * str, ...)
 
     if (m_logLevel > LOGL_DETAIL)
     {
+        char text[MAX_QUERY_LEN];
         va_list ap;
         va_start(ap, str);
-        vutf8printf(stdout, str, &ap);
+        vsnprintf(text, MAX_QUERY_LEN, str, ap);
         va_end(ap);
 
-        //if (m_colored)
-        //    ResetColor(true);
+        outConsole(true, -1, text, false);
 
         if (logfile)
-        {
-            va_list ap2;
-            va_start(ap2, str);
-            vfprintf(logfile, str, ap2);
-            va_end(ap2);
-        }
+            outFile(logfile, false, NULL, text, false);
     }
 }
 
@@ -742,25 +727,16 @@ void Log::outSQLDev(const char* str, ...)
     if (!str)
         return;
 
+    char text[MAX_QUERY_LEN];
     va_list ap;
     va_start(ap, str);
-    vutf8printf(stdout, str, &ap);
+    vsnprintf(text, MAX_QUERY_LEN, str, ap);
     va_end(ap);
 
-    printf("\n");
+    outConsole(true, -1, text);
 
     if (sqlDevLogFile)
-    {
-        va_list ap2;
-        va_start(ap2, str);
-        vfprintf(sqlDevLogFile, str, ap2);
-        va_end(ap2);
-
-        fprintf(sqlDevLogFile, "\n");
-        fflush(sqlDevLogFile);
-    }
-
-    fflush(stdout);
+        outFile(sqlDevLogFile, false, NULL, text);
 }
 
 void Log::outDebug(DebugLogFilters f, const char * str, ...)
@@ -771,44 +747,26 @@ void Log::outDebug(DebugLogFilters f, const char * str, ...)
     if (!str)
         return;
 
-    if (m_enableLogDB && m_dbLogLevel > LOGL_DETAIL)
-    {
-        va_list ap2;
-        va_start(ap2, str);
-        char nnew_str[MAX_QUERY_LEN];
-        vsnprintf(nnew_str, MAX_QUERY_LEN, str, ap2);
-        outDB(LOG_TYPE_DEBUG, nnew_str);
-        va_end(ap2);
-    }
-
-    if ( m_logLevel > LOGL_DETAIL )
-    {
-        if (m_colored)
-            SetColor(true, m_colors[LOGL_DEBUG]);
+    bool db = m_enableLogDB && m_dbLogLevel > LOGL_DETAIL;
+    if (!db && m_logLevel <= LOGL_DETAIL)
+        return;
 
-        va_list ap;
-        va_start(ap, str);
-        vutf8printf(stdout, str, &ap);
-        va_end(ap);
+    char text[MAX_QUERY_LEN];
+    va_list ap;
+    va_start(ap, str);
+    vsnprintf(text, MAX_QUERY_LEN, str, ap);
+    va_end(ap);
 
-        if (m_colored)
-            ResetColor(true);
+    if (db)
+        outDB(LOG_TYPE_DEBUG, text);
 
-        printf( "\n" );
+    if (m_logLevel > LOGL_DETAIL)
+    {
+        outConsole(true, m_colors[LOGL_DEBUG], text);
 
         if (logfile)
-        {
-            outTimestamp(logfile);
-            va_list ap2;
-            va_start(ap2, str);
-            vfprintf(logfile, str, ap2);
-            va_end(ap2);
-
-            fprintf(logfile, "\n" );
-            fflush(logfile);
-        }
+            outFile(logfile, true, NULL, text);
     }
-    fflush(stdout);
 }
 
 void Log::outStaticDebug(const char * str, ...)
@@ -816,44 +774,26 @@ void Log::outStaticDebug(const char * str, ...)
     if (!str)
         return;
 
-    if (m_enableLogDB && m_dbLogLevel > LOGL_DETAIL)
-    {
-        va_list ap2;
-        va_start(ap2, str);
-        char nnew_str[MAX_QUERY_LEN];
-        vsnprintf(nnew_str, MAX_QUERY_LEN, str, ap2);
-        outDB(LOG_TYPE_DEBUG, nnew_str);
-        va_end(ap2);
-    }
-
-    if ( m_logLevel > LOGL_DETAIL )
-    {
-        if (m_colored)
-            SetColor(true, m_colors[LOGL_DEBUG]);
+    bool db = m_enableLogDB && m_dbLogLevel > LOGL_DETAIL;
+    if (!db && m_logLevel <= LOGL_DETAIL)
+        return;
 
-        va_list ap;
-        va_start(ap, str);
-        vutf8printf(stdout, str, &ap);
-        va_end(ap);
+    char text[MAX_QUERY_LEN];
+    va_list ap;
+    va_start(ap, str);
+    vsnprintf(text, MAX_QUERY_LEN, str, ap);
+    va_end(ap);
 
-        if (m_colored)
-            ResetColor(true);
+    if (db)
+        outDB(LOG_TYPE_DEBUG, text);
 
-        printf( "\n" );
+    if (m_logLevel > LOGL_DETAIL)
+    {
+        outConsole(true, m_colors[LOGL_DEBUG], text);
 
         if (logfile)
-        {
-            outTimestamp(logfile);
-            va_list ap2;
-            va_start(ap2, str);
-            vfprintf(logfile, str, ap2);
-            va_end(ap2);
-
-            fprintf(logfile, "\n" );
-            fflush(logfile);
-        }
+            outFile(logfile, true, NULL, text);
     }
-    fflush(stdout);
 }
 
 void Log::outStringInLine(const char * str, ...)
@@ -861,18 +801,16 @@ void Log::outStringInLine(const char * str, ...)
     if (!str)
         return;
 
+    char text[MAX_QUERY_LEN];
     va_list ap;
-
     va_start(ap, str);
-    vutf8printf(stdout, str, &ap);
+    vsnprintf(text, MAX_QUERY_LEN, str, ap);
     va_end(ap);
 
+    outConsole(true, -1, text, false);
+
     if (logfile)
-    {
-        va_start(ap, str);
-        vfprintf(logfile, str, ap);
-        va_end(ap);
-    }
+        outFile(logfile, false, NULL, text, false);
 }
 
 void Log::outCommand(uint32 account, const char * str, ...)
@@ -880,69 +818,31 @@ void Log::outCommand(uint32 account, const char * str, ...)
     if (!str)
         return;
 
+    char text[MAX_QUERY_LEN];
+    va_list ap;
+    va_start(ap, str);
+    vsnprintf(text, MAX_QUERY_LEN, str, ap);
+    va_end(ap);
+
     // TODO: support accountid
     if (m_enableLogDB && m_dbGM)
-    {
-        va_list ap2;
-        va_start(ap2, str);
-        char nnew_str[MAX_QUERY_LEN];
-        vsnprintf(nnew_str, MAX_QUERY_LEN, str, ap2);
-        outDB(LOG_TYPE_GM, nnew_str);
-        va_end(ap2);
-    }
+        outDB(LOG_TYPE_GM, text);
 
     if (m_logLevel > LOGL_NORMAL)
     {
-        if (m_colored)
-            SetColor(true, m_colors[LOGL_BASIC]);
-
-        va_list ap;
-        va_start(ap, str);
-        vutf8printf(stdout, str, &ap);
-        va_end(ap);
-
-        if (m_colored)
-            ResetColor(true);
-
-        printf("\n");
+        outConsole(true, m_colors[LOGL_BASIC], text);
 
         if (logfile)
-        {
-            outTimestamp(logfile);
-            va_list ap2;
-            va_start(ap2, str);
-            vfprintf(logfile, str, ap2);
-            fprintf(logfile, "\n" );
-            va_end(ap2);
-            fflush(logfile);
-        }
+            outFile(logfile, true, NULL, text);
     }
 
     if (m_gmlog_per_account)
     {
         if (FILE* per_file = openGmlogPerAccount (account))
-        {
-            outTimestamp(per_file);
-            va_list ap;
-            va_start(ap, str);
-            vfprintf(per_file, str, ap);
-            fprintf(per_file, "\n" );
-            va_end(ap);
-            fclose(per_file);
-        }
+            outFile(per_file, true, NULL, text, true, true);
     }
     else if (gmLogfile)
-    {
-        outTimestamp(gmLogfile);
-        va_list ap;
-        va_start(ap, str);
-        vfprintf(gmLogfile, str, ap);
-        fprintf(gmLogfile, "\n" );
-        va_end(ap);
-        fflush(gmLogfile);
-    }
-
-    fflush(stdout);
+        outFile(gmLogfile, true, NULL, text);
 }
 
 void Log::outChar(const char * str, ...)
@@ -950,26 +850,21 @@ void Log::outChar(const char * str, ...)
     if (!str)
         return;
 
-    if (m_enableLogDB && m_dbChar)
-    {
-        va_list ap2;
-        va_start(ap2, str);
-        char nnew_str[MAX_QUERY_LEN];
-        vsnprintf(nnew_str, MAX_QUERY_LEN, str, ap2);
-        outDB(LOG_TYPE_CHAR, nnew_str);
-        va_end(ap2);
-    }
+    bool db = m_enableLogDB && m_dbChar;
+    if (!db && !charLogfile)
+        return;
+
+    char text[MAX_QUERY_LEN];
+    va_list ap;
+    va_start(ap, str);
+    vsnprintf(text, MAX_QUERY_LEN, str, ap);
+    va_end(ap);
+
+    if (db)
+        outDB(LOG_TYPE_CHAR, text);
 
     if (charLogfile)
-    {
-        outTimestamp(charLogfile);
-        va_list ap;
-        va_start(ap, str);
-        vfprintf(charLogfile, str, ap);
-        fprintf(charLogfile, "\n" );
-        va_end(ap);
-        fflush(charLogfile);
-    }
+        outFile(charLogfile, true, NULL, text);
 }
 
 void Log::outCharDump(const char * str, uint32 account_id, uint32 guid, const char * name)
@@ -987,11 +882,14 @@ void Log::outCharDump(const char * str, uint32 account_id, uint32 guid, const ch
         file = charLogfile;
     if (file)
     {
-        fprintf(file, "== START DUMP == (account: %u guid: %u name: %s )\n%s\n== END DUMP ==\n",
-            account_id, guid, name, str);
-        fflush(file);
-        if (m_charLog_Dump_Separate)
-            fclose(file);
+        char header[128];
+        snprintf(header, 128, "== START DUMP == (account: %u guid: %u name: %s )\n", account_id, guid, name);
+
+        std::string dump(header);
+        dump += str;
+        dump += "\n== END DUMP ==";
+
+        outFile(file, false, NULL, dump.c_str(), true, m_charLog_Dump_Separate);
     }
 }
 
@@ -1000,26 +898,21 @@ void Log::outRemote(const char * str, ...)
     if (!str)
         return;
 
-    if (m_enableLogDB && m_dbRA)
-    {
-        va_list ap2;
-        va_start(ap2, str);
-        char nnew_str[MAX_QUERY_LEN];
-        vsnprintf(nnew_str, MAX_QUERY_LEN, str, ap2);
-        outDB(LOG_TYPE_RA, nnew_str);
-        va_end(ap2);
-    }
+    bool db = m_enableLogDB && m_dbRA;
+    if (!db && !raLogfile)
+        return;
+
+    char text[MAX_QUERY_LEN];
+    va_list ap;
+    va_start(ap, str);
+    vsnprintf(text, MAX_QUERY_LEN, str, ap);
+    va_end(ap);
+
+    if (db)
+        outDB(LOG_TYPE_RA, text);
 
     if (raLogfile)
-    {
-        outTimestamp(raLogfile);
-        va_list ap;
-        va_start(ap, str);
-        vfprintf(raLogfile, str, ap);
-        fprintf(raLogfile, "\n" );
-        va_end(ap);
-        fflush(raLogfile);
-    }
+        outFile(raLogfile, true, NULL, text);
 }
 
 void Log::outChat(const char * str, ...)
@@ -1027,26 +920,21 @@ void Log::outChat(const char * str, ...)
     if (!str)
         return;
 
-    if (m_enableLogDB && m_dbChat)
-    {
-        va_list ap2;
-        va_start(ap2, str);
-        char nnew_str[MAX_QUERY_LEN];
-        vsnprintf(nnew_str, MAX_QUERY_LEN, str, ap2);
-        outDB(LOG_TYPE_CHAT, nnew_str);
-        va_end(ap2);
-    }
+    bool db = m_enableLogDB && m_dbChat;
+    if (!db && !chatLogfile)
+        return;
+
+    char text[MAX_QUERY_LEN];
+    va_list ap;
+    va_start(ap, str);
+    vsnprintf(text, MAX_QUERY_LEN, str, ap);
+    va_end(ap);
+
+    if (db)
+        outDB(LOG_TYPE_CHAT, text);
 
     if (chatLogfile)
-    {
-        outTimestamp(chatLogfile);
-        va_list ap;
-        va_start(ap, str);
-        vfprintf(chatLogfile, str, ap);
-        fprintf(chatLogfile, "\n" );
-        fflush(chatLogfile);
-        va_end(ap);
-    }
+        outFile(chatLogfile, true, NULL, text);
 }
 
 void Log::outErrorST(const char * str, ...)
@@ -1068,12 +956,12 @@ void Log::outWarden(const char * str, ...)
 
     if (wardenLogFile)
     {
-        outTimestamp(wardenLogFile);
+        char text[MAX_QUERY_LEN];
         va_list ap;
         va_start(ap, str);
-        vfprintf(wardenLogFile, str, ap);
-        fprintf(wardenLogFile, "\n" );
-        fflush(wardenLogFile);
+        vsnprintf(text, MAX_QUERY_LEN, str, ap);
         va_end(ap);
+
+        outFile(wardenLogFile, true, NULL, text);
     }
 }
@@ -23,6 +23,7 @@
 #include <ace/Singleton.h>
 
 class Config;
+class LogWorker;
 
 enum DebugLogFilters
 {
@@ -113,6 +114,10 @@ class Log
 
         void ReloadConfig();
 
+        // writes the lines queued in asynchronous mode and logs directly from then on,
+        // must be called before the login database is closed
+        void StopAsyncWriter();
+
         void InitColors(const std::string& init_str);
         void SetColor(bool stdout_stream, ColorTypes color);
         void ResetColor(bool stdout_stream);
@@ -161,6 +166,10 @@ class Log
         FILE* openLogFile(char const* configFileName, char const* configTimeStampFlag, char const* mode);
         FILE* openGmlogPerAccount(uint32 account);
 
+        // write a formatted line directly or hand it over to the writer thread
+        void outConsole(bool stdoutStream, int8 color, const char* text, bool newLine = true);
+        void outFile(FILE* file, bool timestamp, const char* prefix, const char* text, bool newLine = true, bool closeFile = false);
+
         FILE* raLogfile;
         FILE* logfile;
         FILE* gmLogfile;
@@ -206,6 +215,10 @@ class Log
         std::string m_dumpsDir;
 
         DebugLogFilters m_DebugLogMask;
+
+        // writer thread of the asynchronous mode, NULL when logging directly
+        LogWorker* m_worker;
+        ACE_RW_Thread_Mutex m_workerLock;                   // read locked while a message is handed to m_worker
 };
 
 #define sLog ACE_Singleton<Log, ACE_Thread_Mutex>::instance()
@@ -0,0 +1,188 @@
+/*
+ * Copyright (C) 2008-2012 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Common.h"
+#include "LogWorker.h"
+#include "Log.h"
+#include "Util.h"
+
+#include "Implementation/LoginDatabase.h" // For logging
+extern LoginDatabaseWorkerPool LoginDatabase;
+
+#include <ace/Guard_T.h>
+#include <ace/OS_NS_sys_time.h>
+
+#include <algorithm>
+
+LogWorker::LogWorker() : _mutex(), _condition(_mutex), _idle(false), _stopping(false)
+{
+}
+
+LogWorker::~LogWorker()
+{
+    Stop();
+}
+
+bool LogWorker::Start()
+{
+    _stopping = false;
+    return activate(THR_NEW_LWP | THR_JOINABLE, 1) != -1;
+}
+
+void LogWorker::Stop()
+{
+    if (thr_count() == 0)
+        return;
+
+    {
+        TRINITY_GUARD(ACE_Thread_Mutex, _mutex);
+        _stopping = true;
+        _condition.signal();
+    }
+
+    wait();
+}
+
+void LogWorker::Enqueue(LogMessage* message)
+{
+    // the writer is behind, wait for it instead of dropping lines
+    while (!_queue.add(message))
+        ACE_Thread::yield();
+
+    // a wakeup missed because of this unlocked check only delays the lines by IDLE_TIMEOUT
+    if (_idle)
+    {
+        TRINITY_GUARD(ACE_Thread_Mutex, _mutex);
+        _condition.signal();
+    }
+}
+
+int LogWorker::svc()
+{
+    std::vector<LogMessage*> batch;
+
+    for (;;)
+    {
+        // checked before draining so that everything queued before Stop() is still written
+        bool stopping = _stopping;
+
+        LogMessage* message;
+        while (batch.size() < QUEUE_SIZE && _queue.next(message))
+            batch.push_back(message);
+
+        if (!batch.empty())
+        {
+            Write(batch);
+            continue;
+        }
+
+        if (stopping)
+            break;
+
+        TRINITY_GUARD(ACE_Thread_Mutex, _mutex);
+        _idle = true;
+        if (_queue.empty() && !_stopping)
+        {
+            ACE_Time_Value timeout = ACE_OS::gettimeofday() + ACE_Time_Value(0, IDLE_TIMEOUT * 1000);
+            _condition.wait(&timeout);
+        }
+        _idle = false;
+    }
+
+    return 0;
+}
+
+void LogWorker::Write(std::vector<LogMessage*>& batch)
+{
+    std::vector<FILE*> written;
+    std::vector<LogMessage*> rows;
+
+    for (std::vector<LogMessage*>::const_iterator itr = batch.begin(); itr != batch.end(); ++itr)
+    {
+        LogMessage* message = *itr;
+        if (!message->File)
+        {
+            rows.push_back(message);
+            continue;
+        }
+
+        if (message->File == stdout || message->File == stderr)
+        {
+            bool stdoutStream = message->File == stdout;
+            if (message->Color >= 0)
+                sLog->SetColor(stdoutStream, ColorTypes(message->Color));
+
+            utf8printf(message->File, "%s", message->Text.c_str());
+
+            if (message->Color >= 0)
+                sLog->ResetColor(stdoutStream);
+        }
+        else
+            fputs(message->Text.c_str(), message->File);
+
+        if (message->NewLine)
+            fputc('\n', message->File);
+
+        if (message->CloseFile)
+            fclose(message->File);
+        else if (std::find(written.begin(), written.end(), message->File) == written.end())
+            written.push_back(message->File);
+    }
+
+    // one flush per file and batch instead of one per line
+    for (std::vector<FILE*>::const_iterator itr = written.begin(); itr != written.end(); ++itr)
+        fflush(*itr);
+
+    WriteRows(rows);
+
+    for (std::vector<LogMessage*>::const_iterator itr = batch.begin(); itr != batch.end(); ++itr)
+        delete *itr;
+
+    batch.clear();
+}
+
+void LogWorker::WriteRows(std::vector<LogMessage*> const& rows)
+{
+    std::string sql;
+    uint32 count = 0;
+
+    for (std::vector<LogMessage*>::const_iterator itr = rows.begin(); itr != rows.end(); ++itr)
+    {
+        LogMessage const* row = *itr;
+
+        std::string text = row->Text;
+        LoginDatabase.EscapeString(text);
+
+        char values[64];
+        snprintf(values, 64, "(%u, %u, %u, '", row->Time, row->Realm, uint32(row->Type));
+
+        sql += count ? "," : "INSERT INTO logs (time, realm, type, string) VALUES ";
+        sql += values;
+        sql += text;
+        sql += "')";
+
+        if (++count == MAX_ROWS)
+        {
+            LoginDatabase.Execute(sql.c_str());
+            sql.clear();
+            count = 0;
+        }
+    }
+
+    if (count)
+        LoginDatabase.Execute(sql.c_str());
+}
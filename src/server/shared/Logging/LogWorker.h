@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2008-2012 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITYCORE_LOGWORKER_H
+#define TRINITYCORE_LOGWORKER_H
+
+#include "Define.h"
+#include "Threading/LockFreeQueue.h"
+
+#include <ace/Task.h>
+#include <ace/Thread_Mutex.h>
+#include <ace/Condition_Thread_Mutex.h>
+
+#include <string>
+#include <vector>
+
+// One formatted line for a log file or the console, or one row for the logs table
+struct LogMessage
+{
+    LogMessage() : File(NULL), Color(-1), NewLine(true), CloseFile(false), Realm(0), Type(0), Time(0) { }
+
+    FILE* File;                                             // NULL for rows of the logs table
+    int8 Color;                                             // console color, -1 if not colored
+    bool NewLine;
+    bool CloseFile;                                         // file is closed after writing (per account gm logs, dumps)
+    uint32 Realm;
+    uint8 Type;                                             // LogTypes of a logs table row
+    uint32 Time;
+    std::string Text;
+};
+
+// Writer thread of the asynchronous logging mode.
+// Producers hand formatted messages over through a lock-free queue, the writer drains it in
+// batches: files are flushed once per batch and rows of the logs table become multi-row inserts.
+class LogWorker : protected ACE_Task_Base
+{
+    public:
+        enum
+        {
+            QUEUE_SIZE      = 8192,                         // messages waiting for the writer, producers wait when full
+            MAX_ROWS        = 100,                          // rows per insert into the logs table
+            IDLE_TIMEOUT    = 100                           // ms the idle writer waits at most before it checks the queue again
+        };
+
+        LogWorker();
+        virtual ~LogWorker();
+
+        bool Start();
+
+        // writes everything queued so far and stops the writer thread
+        void Stop();
+
+        // takes ownership of the message
+        void Enqueue(LogMessage* message);
+
+        virtual int svc();
+
+    private:
+        void Write(std::vector<LogMessage*>& batch);
+        void WriteRows(std::vector<LogMessage*> const& rows);
+
+        ACE_Based::LockFreeQueue<LogMessage*, QUEUE_SIZE> _queue;
+        ACE_Thread_Mutex _mutex;
+        ACE_Condition_Thread_Mutex _condition;              // signaled when messages are queued for an idle writer or it stops
+        volatile bool _idle;                                // writer waits on _condition, producers only lock when set
+        volatile bool _stopping;
+};
+
+#endif
@@ -0,0 +1,61 @@
+/*
+ * Copyright (C) 2008-2012 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "WorldPacket.h"
+
+#include <ace/Message_Block.h>
+#include <ace/Lock_Adapter_T.h>
+#include <ace/Thread_Mutex.h>
+
+// The shared contents are referenced from the map thread sending the packet and released
+// by the network threads, so the reference count of the data block has to be locked.
+// One lock for all packets is enough, it is only held to change the count.
+static ACE_Lock_Adapter<ACE_Thread_Mutex> SharedContentsLock;
+
+bool WorldPacket::BeginShare() const
+{
+    if (m_shareable)
+        return false;
+
+    m_shareable = true;
+    return true;
+}
+
+void WorldPacket::EndShare() const
+{
+    m_shareable = false;
+
+    if (m_sharedContents)
+    {
+        m_sharedContents->release();
+        m_sharedContents = NULL;
+    }
+}
+
+ACE_Message_Block* WorldPacket::GetSharedContents() const
+{
+    if (!m_shareable || empty())
+        return NULL;
+
+    if (!m_sharedContents)
+    {
+        m_sharedContents = new ACE_Message_Block(size(), ACE_Message_Block::MB_DATA, NULL, NULL, NULL, &SharedContentsLock);
+        m_sharedContents->copy((char const*)contents(), size());
+    }
+
+    return m_sharedContents->duplicate();
+}
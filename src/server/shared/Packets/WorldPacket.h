@@ -22,19 +22,34 @@
 #include "Common.h"
 #include "ByteBuffer.h"
 
+class ACE_Message_Block;
+
 class WorldPacket : public ByteBuffer
 {
     public:
                                                             // just container for later use
-        WorldPacket()                                       : ByteBuffer(0), m_opcode(0)
+        WorldPacket()                                       : ByteBuffer(0), m_opcode(0), m_shareable(false), m_sharedContents(NULL)
         {
         }
-        explicit WorldPacket(uint16 opcode, size_t res=200) : ByteBuffer(res), m_opcode(opcode) { }
+        explicit WorldPacket(uint16 opcode, size_t res=200) : ByteBuffer(res), m_opcode(opcode), m_shareable(false), m_sharedContents(NULL) { }
                                                             // copy constructor
-        WorldPacket(const WorldPacket &packet)              : ByteBuffer(packet), m_opcode(packet.m_opcode)
+        WorldPacket(const WorldPacket &packet)              : ByteBuffer(packet), m_opcode(packet.m_opcode), m_shareable(false), m_sharedContents(NULL)
         {
         }
 
+        ~WorldPacket() { EndShare(); }
+
+        WorldPacket& operator=(const WorldPacket &packet)
+        {
+            if (this != &packet)
+            {
+                EndShare();
+                ByteBuffer::operator=(packet);
+                m_opcode = packet.m_opcode;
+            }
+            return *this;
+        }
+
         void Initialize(uint16 opcode, size_t newres=200)
         {
             clear();
@@ -45,8 +60,36 @@ class WorldPacket : public ByteBuffer
         uint16 GetOpcode() const { return m_opcode; }
         void SetOpcode(uint16 opcode) { m_opcode = opcode; }
 
+        // Broadcasts: while shared, the sockets the packet is sent to reference one reference counted
+        // copy of the contents instead of copying them into their own buffers. The packet must not be
+        // changed until EndShare() and may only be sent from one thread meanwhile.
+        // Returns false if the packet was already shared.
+        bool BeginShare() const;
+        void EndShare() const;
+
+        // Creates the shared copy on first use, NULL if the packet is not shared.
+        // The caller gets its own reference and has to release() it.
+        ACE_Message_Block* GetSharedContents() const;
+
     protected:
         uint16 m_opcode;
+
+        mutable bool m_shareable;
+        mutable ACE_Message_Block* m_sharedContents;
+};
+
+// Shares a packet for the lifetime of the object, see WorldPacket::BeginShare
+class SharedPacketScope
+{
+    public:
+        explicit SharedPacketScope(WorldPacket const* packet) : _packet(packet->BeginShare() ? packet : NULL) { }
+        ~SharedPacketScope() { if (_packet) _packet->EndShare(); }
+
+    private:
+        SharedPacketScope(SharedPacketScope const&);
+        SharedPacketScope& operator=(SharedPacketScope const&);
+
+        WorldPacket const* _packet;
 };
 #endif
 
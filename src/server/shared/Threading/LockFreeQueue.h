@@ -0,0 +1,201 @@
+/*
+ * Copyright (C) 2008-2012 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LOCKFREEQUEUE_H
+#define LOCKFREEQUEUE_H
+
+#include "Define.h"
+
+#if PLATFORM == PLATFORM_WINDOWS
+#  include <intrin.h>
+#  pragma intrinsic(_InterlockedCompareExchange, _ReadWriteBarrier)
+#endif
+
+namespace ACE_Based
+{
+    namespace LockFree
+    {
+        //! Full memory barrier on weakly ordered cpus, compiler barrier only on x86.
+        inline void Barrier()
+        {
+#if PLATFORM == PLATFORM_WINDOWS
+            _ReadWriteBarrier();
+#elif defined(__i386__) || defined(__x86_64__)
+            __asm__ __volatile__("" ::: "memory");
+#else
+            __sync_synchronize();
+#endif
+        }
+
+        //! Reads a value written by another thread, later reads can not be moved before it.
+        inline long Load(volatile long const& value)
+        {
+            long result = value;
+            Barrier();
+            return result;
+        }
+
+        //! Publishes a value to other threads, earlier writes can not be moved after it.
+        inline void Store(volatile long& value, long newValue)
+        {
+            Barrier();
+            value = newValue;
+        }
+
+        inline bool CompareAndSwap(volatile long& value, long expected, long newValue)
+        {
+#if PLATFORM == PLATFORM_WINDOWS
+            return _InterlockedCompareExchange(&value, newValue, expected) == expected;
+#else
+            return __sync_bool_compare_and_swap(&value, expected, newValue);
+#endif
+        }
+
+        //! Difference of two positions, correct after the counters wrap around.
+        inline long Distance(long from, long to)
+        {
+            return long((unsigned long)(to) - (unsigned long)(from));
+        }
+
+        inline long Advance(long position, unsigned long count)
+        {
+            return long((unsigned long)(position) + count);
+        }
+    }
+
+    //! Bounded lock-free queue for many producers and a single consumer.
+    //! Every cell carries a sequence number telling whether it is free for the producer
+    //! reserving that position or holds an item for the consumer, so producers only
+    //! contend on the tail position and never wait for each other or for the consumer.
+    //! Only one thread may call next(), peek() and empty() at a time.
+    template <class T, size_t Capacity>
+        class LockFreeQueue
+    {
+        // positions are mapped to cells by masking
+        typedef char CapacityMustBePowerOfTwo[(Capacity & (Capacity - 1)) == 0 && Capacity > 1 ? 1 : -1];
+
+        struct Cell
+        {
+            volatile long Sequence;
+            T Item;
+        };
+
+        //! Storage backing the queue.
+        Cell _cells[Capacity];
+
+        //! Next position to be reserved by producers.
+        char _pad0[64];
+        volatile long _tail;
+        char _pad1[64];
+
+        //! Next position to be read by the consumer.
+        long _head;
+
+        public:
+
+            //! Create a LockFreeQueue.
+            LockFreeQueue()
+                : _tail(0), _head(0)
+            {
+                for (size_t i = 0; i < Capacity; ++i)
+                    _cells[i].Sequence = long(i);
+            }
+
+            //! Destroy a LockFreeQueue.
+            virtual ~LockFreeQueue()
+            {
+            }
+
+            //! Adds an item to the queue, returns false if the queue is full.
+            bool add(const T& item)
+            {
+                Cell* cell;
+                long pos = LockFree::Load(_tail);
+
+                for (;;)
+                {
+                    cell = &_cells[pos & (Capacity - 1)];
+                    long diff = LockFree::Distance(pos, LockFree::Load(cell->Sequence));
+
+                    if (diff == 0)
+                    {
+                        // cell is free, try to reserve it
+                        if (LockFree::CompareAndSwap(_tail, pos, LockFree::Advance(pos, 1)))
+                            break;
+                    }
+                    else if (diff < 0)
+                        return false;               // consumer did not free the cell yet
+
+                    pos = LockFree::Load(_tail);
+                }
+
+                cell->Item = item;
+                LockFree::Store(cell->Sequence, LockFree::Advance(pos, 1));
+                return true;
+            }
+
+            //! Gets the next result in the queue, if any.
+            bool next(T& result)
+            {
+                Cell& cell = _cells[_head & (Capacity - 1)];
+                if (LockFree::Load(cell.Sequence) != LockFree::Advance(_head, 1))
+                    return false;
+
+                result = cell.Item;
+                pop(cell);
+                return true;
+            }
+
+            template<class Checker>
+            bool next(T& result, Checker& check)
+            {
+                Cell& cell = _cells[_head & (Capacity - 1)];
+                if (LockFree::Load(cell.Sequence) != LockFree::Advance(_head, 1))
+                    return false;
+
+                result = cell.Item;
+                if (!check.Process(result))
+                    return false;
+
+                pop(cell);
+                return true;
+            }
+
+            //! Peeks at the top of the queue. Check if the queue is empty before calling!
+            T const& peek() const
+            {
+                return _cells[_head & (Capacity - 1)].Item;
+            }
+
+            //! Checks if there is nothing for the consumer to read.
+            bool empty() const
+            {
+                return LockFree::Load(_cells[_head & (Capacity - 1)].Sequence) != LockFree::Advance(_head, 1);
+            }
+
+        private:
+
+            //! Frees the cell for the producer that will reach it one lap later.
+            void pop(Cell& cell)
+            {
+                cell.Item = T();
+                LockFree::Store(cell.Sequence, LockFree::Advance(_head, Capacity));
+                _head = LockFree::Advance(_head, 1);
+            }
+    };
+}
+#endif
@@ -18,15 +18,20 @@
 
 #include "EventProcessor.h"
 
-EventProcessor::EventProcessor()
+#include <algorithm>
+#include <cstring>
+
+EventProcessor::EventProcessor() : m_wheel(NULL), m_overflow(NULL), m_wheelTime(0), m_nextWork(~uint64(0)), m_wheelCount(0)
 {
     m_time = 0;
     m_aborting = false;
+    memset(m_usedSlots, 0, sizeof(m_usedSlots));
 }
 
 EventProcessor::~EventProcessor()
 {
     KillAllEvents(true);
+    delete [] m_wheel;
 }
 
 void EventProcessor::Update(uint32 p_time)
@@ -34,13 +39,23 @@ void EventProcessor::Update(uint32 p_time)
     // update time
     m_time += p_time;
 
-    // main event loop
-    EventList::iterator i;
-    while (((i = m_events.begin()) != m_events.end()) && i->first <= m_time)
+    // move the events up to the new time out of the wheel, most updates have nothing to move
+    if (m_time < m_nextWork)
+        m_wheelTime = m_time;
+    else
+    {
+        Advance(m_time);
+        m_nextWork = NextWorkTime();
+    }
+
+    // main event loop, events added for a passed time while executing are executed in this loop too
+    while (BasicEvent* Event = m_due.Head)
     {
         // get and remove event from queue
-        BasicEvent* Event = i->second;
-        m_events.erase(i);
+        m_due.Head = Event->m_next;
+        if (!m_due.Head)
+            m_due.Tail = NULL;
+        Event->m_next = NULL;
 
         if (!Event->to_Abort)
         {
@@ -63,33 +78,44 @@ void EventProcessor::KillAllEvents(bool force)
     // prevent event insertions
     m_aborting = true;
 
-    // first, abort all existing events
-    for (EventList::iterator i = m_events.begin(); i != m_events.end();)
-    {
-        EventList::iterator i_old = i;
-        ++i;
+    // first, abort all existing events, non deletable ones stay queued unless forced
+    uint32 kept = 0;
+    m_due.Head = KillEvents(m_due.Head, force, kept, &m_due.Tail);
 
-        i_old->second->to_Abort = true;
-        i_old->second->Abort(m_time);
-        if (force || i_old->second->IsDeletable())
+    kept = 0;
+    if (m_wheel)
+    {
+        for (uint32 level = 0; level < WHEEL_LEVELS; ++level)
         {
-            delete i_old->second;
+            for (uint32 slot = 0; slot < WHEEL_SLOTS; ++slot)
+            {
+                BasicEvent*& list = m_wheel[level * WHEEL_SLOTS + slot];
+                if (!list)
+                    continue;
 
-            if (!force)                                      // need per-element cleanup
-                m_events.erase (i_old);
+                list = KillEvents(list, force, kept);
+                if (!list)
+                    m_usedSlots[level] &= uint16(~(1 << slot));
+            }
         }
     }
 
-    // fast clear event list (in force case)
-    if (force)
-        m_events.clear();
+    m_overflow = KillEvents(m_overflow, force, kept);
+    m_wheelCount = kept;
 }
 
 void EventProcessor::AddEvent(BasicEvent* Event, uint64 e_time, bool set_addtime)
 {
     if (set_addtime) Event->m_addTime = m_time;
     Event->m_execTime = e_time;
-    m_events.insert(std::pair<uint64, BasicEvent*>(e_time, Event));
+
+    if (e_time <= m_wheelTime)
+        AddDueEvent(Event);
+    else
+    {
+        Schedule(Event);
+        ++m_wheelCount;
+    }
 }
 
 uint64 EventProcessor::CalculateTime(uint64 t_offset) const
@@ -97,3 +123,241 @@ uint64 EventProcessor::CalculateTime(uint64 t_offset) const
     return(m_time + t_offset);
 }
 
+void EventProcessor::Schedule(BasicEvent* Event)
+{
+    uint64 diff = Event->m_execTime ^ m_wheelTime;
+    if (diff >> (WHEEL_LEVELS * WHEEL_BITS))
+    {
+        Event->m_next = m_overflow;
+        m_overflow = Event;
+        m_nextWork = std::min(m_nextWork, (m_wheelTime | ((uint64(1) << (WHEEL_LEVELS * WHEEL_BITS)) - 1)) + 1);
+        return;
+    }
+
+    // the highest digit in which the time differs from the wheel time selects the level,
+    // so the event is always ahead of the current slot of its level
+    uint32 level = 0;
+    while (diff >> ((level + 1) * WHEEL_BITS))
+        ++level;
+
+    uint32 slot = uint32(Event->m_execTime >> (level * WHEEL_BITS)) & WHEEL_MASK;
+
+    if (!m_wheel)
+    {
+        m_wheel = new BasicEvent*[WHEEL_LEVELS * WHEEL_SLOTS];
+        memset(m_wheel, 0, WHEEL_LEVELS * WHEEL_SLOTS * sizeof(BasicEvent*));
+    }
+
+    BasicEvent*& list = m_wheel[level * WHEEL_SLOTS + slot];
+    Event->m_next = list;
+    list = Event;
+    m_usedSlots[level] |= uint16(1 << slot);
+
+    // the slot is taken (level 0) or cascaded when the wheel reaches its start
+    m_nextWork = std::min(m_nextWork, Event->m_execTime >> (level * WHEEL_BITS) << (level * WHEEL_BITS));
+}
+
+void EventProcessor::RescheduleEvents(BasicEvent* list)
+{
+    // oldest first, so that events of the same time keep the order they were added in
+    list = Reverse(list);
+
+    while (list)
+    {
+        BasicEvent* Event = list;
+        list = Event->m_next;
+
+        if (Event->m_execTime <= m_wheelTime)
+        {
+            --m_wheelCount;
+            AddDueEvent(Event);
+        }
+        else
+            Schedule(Event);
+    }
+}
+
+BasicEvent* EventProcessor::TakeSlot(uint32 level, uint32 slot)
+{
+    BasicEvent*& list = m_wheel[level * WHEEL_SLOTS + slot];
+    BasicEvent* events = list;
+    list = NULL;
+    m_usedSlots[level] &= uint16(~(1 << slot));
+    return events;
+}
+
+void EventProcessor::Advance(uint64 time)
+{
+    while (m_wheelTime < time)
+    {
+        if (!m_wheelCount)
+        {
+            m_wheelTime = time;
+            return;
+        }
+
+        uint64 turnEnd = m_wheelTime | WHEEL_MASK;
+        if (m_wheelTime < turnEnd)
+        {
+            uint32 first = uint32(m_wheelTime & WHEEL_MASK) + 1;
+            m_wheelTime = std::min(time, turnEnd);
+            uint32 last = uint32(m_wheelTime & WHEEL_MASK);
+
+            // a level 0 slot holds the events of exactly one time
+            if (m_usedSlots[0])
+                for (uint32 slot = first; slot <= last; ++slot)
+                    if (m_usedSlots[0] & (1 << slot))
+                        RescheduleEvents(TakeSlot(0, slot));
+
+            if (m_wheelTime == time)
+                return;
+        }
+
+        // level 0 is empty at the end of its turn, the turns up to the next used slot of a higher level
+        // (or the next pass over the overflow list) would cascade nothing and are skipped
+        uint64 next = NextCascadeTime();
+        if (next > time)
+        {
+            m_wheelTime = time;
+            return;
+        }
+
+        m_wheelTime = next;
+        Cascade();
+    }
+}
+
+uint64 EventProcessor::NextCascadeTime() const
+{
+    // slots of a higher level start later than all slots of the lower levels
+    for (uint32 level = 1; level < WHEEL_LEVELS; ++level)
+    {
+        if (!m_usedSlots[level])
+            continue;
+
+        // used slots are always ahead of the current slot of their level
+        uint32 shift = level * WHEEL_BITS;
+        uint32 slot = (uint32(m_wheelTime >> shift) & WHEEL_MASK) + 1;
+        while (slot < WHEEL_MASK && !(m_usedSlots[level] & (1 << slot)))
+            ++slot;
+
+        return (m_wheelTime >> (shift + WHEEL_BITS) << (shift + WHEEL_BITS)) | (uint64(slot) << shift);
+    }
+
+    // only the overflow list is left, it is scheduled again when the last level starts a new turn
+    return (m_wheelTime | ((uint64(1) << (WHEEL_LEVELS * WHEEL_BITS)) - 1)) + 1;
+}
+
+uint64 EventProcessor::NextWorkTime() const
+{
+    if (!m_wheelCount)
+        return ~uint64(0);
+
+    // used level 0 slots are always ahead of the current one
+    for (uint32 slot = uint32(m_wheelTime & WHEEL_MASK) + 1; slot < WHEEL_SLOTS; ++slot)
+        if (m_usedSlots[0] & (1 << slot))
+            return (m_wheelTime & ~uint64(WHEEL_MASK)) | slot;
+
+    return NextCascadeTime();
+}
+
+void EventProcessor::Cascade()
+{
+    // highest level whose current slot starts at the wheel time
+    uint32 top = 1;
+    while (top < WHEEL_LEVELS && !(m_wheelTime & ((uint64(1) << ((top + 1) * WHEEL_BITS)) - 1)))
+        ++top;
+
+    if (top == WHEEL_LEVELS && m_overflow)
+    {
+        BasicEvent* list = m_overflow;
+        m_overflow = NULL;
+        RescheduleEvents(list);
+    }
+
+    for (uint32 level = std::min<uint32>(top, WHEEL_LEVELS - 1); level > 0; --level)
+    {
+        uint32 slot = uint32(m_wheelTime >> (level * WHEEL_BITS)) & WHEEL_MASK;
+        if (m_usedSlots[level] & (1 << slot))
+            RescheduleEvents(TakeSlot(level, slot));
+    }
+}
+
+void EventProcessor::AddDueEvent(BasicEvent* Event)
+{
+    Event->m_next = NULL;
+
+    if (!m_due.Head)
+    {
+        m_due.Head = m_due.Tail = Event;
+        return;
+    }
+
+    // usually the latest due event
+    if (m_due.Tail->m_execTime <= Event->m_execTime)
+    {
+        m_due.Tail->m_next = Event;
+        m_due.Tail = Event;
+        return;
+    }
+
+    if (Event->m_execTime < m_due.Head->m_execTime)
+    {
+        Event->m_next = m_due.Head;
+        m_due.Head = Event;
+        return;
+    }
+
+    BasicEvent* prev = m_due.Head;
+    while (prev->m_next->m_execTime <= Event->m_execTime)
+        prev = prev->m_next;
+
+    Event->m_next = prev->m_next;
+    prev->m_next = Event;
+}
+
+BasicEvent* EventProcessor::KillEvents(BasicEvent* list, bool force, uint32& kept, BasicEvent** tail)
+{
+    BasicEvent* keptHead = NULL;
+    BasicEvent* keptTail = NULL;
+
+    while (list)
+    {
+        BasicEvent* Event = list;
+        list = Event->m_next;
+
+        Event->to_Abort = true;
+        Event->Abort(m_time);
+        if (force || Event->IsDeletable())
+        {
+            delete Event;
+            continue;
+        }
+
+        Event->m_next = NULL;
+        if (keptTail)
+            keptTail->m_next = Event;
+        else
+            keptHead = Event;
+        keptTail = Event;
+        ++kept;
+    }
+
+    if (tail)
+        *tail = keptTail;
+
+    return keptHead;
+}
+
+BasicEvent* EventProcessor::Reverse(BasicEvent* list)
+{
+    BasicEvent* reversed = NULL;
+    while (list)
+    {
+        BasicEvent* Event = list;
+        list = Event->m_next;
+        Event->m_next = reversed;
+        reversed = Event;
+    }
+    return reversed;
+}
@@ -21,14 +21,12 @@
 
 #include "Define.h"
 
-#include<map>
-
 // Note. All times are in milliseconds here.
 
 class BasicEvent
 {
     public:
-        BasicEvent() { to_Abort = false; }
+        BasicEvent() : m_next(NULL) { to_Abort = false; }
         virtual ~BasicEvent()                               // override destructor to perform some actions on event removal
         {
         };
@@ -48,10 +46,17 @@ class BasicEvent
         // these can be used for time offset control
         uint64 m_addTime;                                   // time when the event was added to queue, filled by event handler
         uint64 m_execTime;                                  // planned time of next execution, filled by event handler
-};
 
-typedef std::multimap<uint64, BasicEvent*> EventList;
+    private:
+        friend class EventProcessor;
+
+        BasicEvent* m_next;                                 // next event in the same queue slot, filled by event handler
+};
 
+// Events are kept in a hierarchical timing wheel linked through the events themselves, so adding an event
+// allocates nothing and costs the same for any number of queued events. Level 0 has one slot per millisecond,
+// every further level one slot per full turn of the level below; events further away than the last level
+// wait in an overflow list. Events of the same time execute in the order they were added.
 class EventProcessor
 {
     public:
@@ -62,10 +67,45 @@ class EventProcessor
         void KillAllEvents(bool force);
         void AddEvent(BasicEvent* Event, uint64 e_time, bool set_addtime = true);
         uint64 CalculateTime(uint64 t_offset) const;
+
     protected:
+        enum
+        {
+            WHEEL_BITS      = 4,
+            WHEEL_SLOTS     = 1 << WHEEL_BITS,              // slots per level
+            WHEEL_MASK      = WHEEL_SLOTS - 1,
+            WHEEL_LEVELS    = 5                             // levels cover 2^20 ms (about 17 minutes) ahead
+        };
+
         uint64 m_time;
-        EventList m_events;
         bool m_aborting;
+
+    private:
+        struct EventQueue
+        {
+            EventQueue() : Head(NULL), Tail(NULL) { }
+
+            BasicEvent* Head;
+            BasicEvent* Tail;
+        };
+
+        void Schedule(BasicEvent* Event);
+        void RescheduleEvents(BasicEvent* list);
+        BasicEvent* TakeSlot(uint32 level, uint32 slot);
+        void Advance(uint64 time);
+        uint64 NextCascadeTime() const;
+        uint64 NextWorkTime() const;
+        void Cascade();
+        void AddDueEvent(BasicEvent* Event);
+        BasicEvent* KillEvents(BasicEvent* list, bool force, uint32& kept, BasicEvent** tail = NULL);
+        static BasicEvent* Reverse(BasicEvent* list);
+
+        EventQueue m_due;                                   // events to execute in this update, ordered by time
+        BasicEvent** m_wheel;                               // WHEEL_LEVELS * WHEEL_SLOTS lists, latest added first; allocated with the first event
+        uint16 m_usedSlots[WHEEL_LEVELS];                   // bit per non empty slot
+        BasicEvent* m_overflow;
+        uint64 m_wheelTime;                                 // all events up to this time are in the due queue
+        uint64 m_nextWork;                                  // no slot is taken or cascaded before this time
+        uint32 m_wheelCount;                                // events in the wheel and the overflow list
 };
 #endif
-
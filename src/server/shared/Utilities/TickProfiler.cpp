@@ -0,0 +1,234 @@
+/*
+ * Copyright (C) 2008-2012 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TickProfiler.h"
+#include "Common.h"
+#include "Configuration/Config.h"
+
+#include <ace/Guard_T.h>
+#include <ace/OS_NS_sys_time.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <map>
+
+static uint64 GetMicroseconds()
+{
+    ACE_Time_Value now = ACE_OS::gettimeofday();
+    return uint64(now.sec()) * 1000000 + uint64(now.usec());
+}
+
+static bool ProfilerEntryCompare(ProfilerEntry const& left, ProfilerEntry const& right)
+{
+    return left.TotalTime > right.TotalTime;
+}
+
+// prints a string as a JSON string literal
+static void WriteJsonString(FILE* file, char const* str)
+{
+    fputc('"', file);
+    for (; str && *str; ++str)
+    {
+        if (*str == '"' || *str == '\\')
+            fputc('\\', file);
+
+        if (uint8(*str) >= 0x20)
+            fputc(*str, file);
+    }
+    fputc('"', file);
+}
+
+TickProfiler::TickProfiler() : _enabled(true), _startTimestamp(GetTimestamp()), _startTime(GetMicroseconds())
+{
+}
+
+TickProfiler::~TickProfiler()
+{
+    for (std::vector<ThreadBuffer*>::iterator itr = _buffers.begin(); itr != _buffers.end(); ++itr)
+        delete *itr;
+}
+
+char const* TickProfiler::GetCategoryName(uint32 category)
+{
+    switch (category)
+    {
+        case PROFILE_WORLD:       return "world";
+        case PROFILE_MAP:         return "map";
+        case PROFILE_MAP_PHASE:   return "map phase";
+        case PROFILE_OPCODE:      return "opcode";
+        case PROFILE_SCRIPT:      return "script";
+        case PROFILE_SMARTSCRIPT: return "smartscript";
+        default:                  return "unknown";
+    }
+}
+
+TickProfiler::ThreadBuffer* TickProfiler::GetThreadBuffer()
+{
+    if (!_context->Buffer)
+    {
+        TRINITY_GUARD(ACE_Thread_Mutex, _lock);
+        _context->Buffer = new ThreadBuffer(uint32(_buffers.size()));
+        _buffers.push_back(_context->Buffer);
+    }
+
+    return _context->Buffer;
+}
+
+void TickProfiler::Record(ProfilerCategory category, char const* name, uint32 id, uint64 start, uint64 end)
+{
+    ThreadBuffer* buffer = GetThreadBuffer();
+
+    // only this thread writes the buffer, readers find out about the sample once Written moves past it
+    long position = buffer->Written;
+    ProfilerSample& sample = buffer->Samples[position & (BUFFER_SIZE - 1)];
+    sample.Start = start;
+    sample.End = end;
+    sample.Name = name;
+    sample.Id = id;
+    sample.Category = category;
+
+    ACE_Based::LockFree::Store(buffer->Written, ACE_Based::LockFree::Advance(position, 1));
+}
+
+void TickProfiler::Reset()
+{
+    TRINITY_GUARD(ACE_Thread_Mutex, _lock);
+
+    for (std::vector<ThreadBuffer*>::iterator itr = _buffers.begin(); itr != _buffers.end(); ++itr)
+        (*itr)->ResetMark = ACE_Based::LockFree::Load((*itr)->Written);
+}
+
+void TickProfiler::CollectSamples(SampleList& samples)
+{
+    TRINITY_GUARD(ACE_Thread_Mutex, _lock);
+
+    for (std::vector<ThreadBuffer*>::const_iterator itr = _buffers.begin(); itr != _buffers.end(); ++itr)
+    {
+        ThreadBuffer const* buffer = *itr;
+        long written = ACE_Based::LockFree::Load(buffer->Written);
+        long available = std::min<long>(ACE_Based::LockFree::Distance(buffer->ResetMark, written), BUFFER_SIZE);
+
+        size_t first = samples.size();
+        for (long i = available; i > 0; --i)
+        {
+            long position = ACE_Based::LockFree::Advance(written, (unsigned long)(-i));
+            samples.push_back(std::make_pair(buffer->ThreadId, buffer->Samples[position & (BUFFER_SIZE - 1)]));
+        }
+
+        // the writer kept going while copying, the oldest samples may have been overwritten
+        long overrun = ACE_Based::LockFree::Distance(written, ACE_Based::LockFree::Load(buffer->Written));
+        long valid = overrun < BUFFER_SIZE - 1 ? std::min<long>(available, BUFFER_SIZE - 1 - overrun) : 0;
+        samples.erase(samples.begin() + first, samples.begin() + first + (available - valid));
+    }
+}
+
+double TickProfiler::GetTicksPerMicrosecond() const
+{
+    uint64 elapsedTime = GetMicroseconds() - _startTime;
+    if (!elapsedTime)
+        return 1.0;
+
+    return double(GetTimestamp() - _startTimestamp) / double(elapsedTime);
+}
+
+void TickProfiler::GetTopEntries(std::vector<ProfilerEntry>& entries, uint32 count)
+{
+    SampleList samples;
+    CollectSamples(samples);
+
+    double ticksPerMicrosecond = GetTicksPerMicrosecond();
+
+    typedef std::pair<std::pair<uint32, uint32>, char const*> EntryKey;
+    std::map<EntryKey, ProfilerEntry> aggregated;
+
+    for (SampleList::const_iterator itr = samples.begin(); itr != samples.end(); ++itr)
+    {
+        ProfilerSample const& sample = itr->second;
+        ProfilerEntry& entry = aggregated[EntryKey(std::make_pair(sample.Category, sample.Id), sample.Name)];
+
+        uint64 time = uint64((sample.End - sample.Start) / ticksPerMicrosecond);
+        entry.Category = sample.Category;
+        entry.Name = sample.Name;
+        entry.Id = sample.Id;
+        ++entry.Calls;
+        entry.TotalTime += time;
+        entry.MaxTime = std::max(entry.MaxTime, time);
+    }
+
+    entries.clear();
+    entries.reserve(aggregated.size());
+    for (std::map<EntryKey, ProfilerEntry>::const_iterator itr = aggregated.begin(); itr != aggregated.end(); ++itr)
+        entries.push_back(itr->second);
+
+    std::sort(entries.begin(), entries.end(), ProfilerEntryCompare);
+    if (entries.size() > count)
+        entries.resize(count);
+}
+
+char const* TickProfiler::InternName(std::string const& name)
+{
+    TRINITY_GUARD(ACE_Thread_Mutex, _namesLock);
+    return _names.insert(name).first->c_str();
+}
+
+bool TickProfiler::IsValidTraceFileName(std::string const& fileName)
+{
+    return !fileName.empty() && fileName.find_first_of("/\\:") == std::string::npos && fileName.find("..") == std::string::npos;
+}
+
+bool TickProfiler::WriteChromeTrace(std::string const& fileName)
+{
+    if (!IsValidTraceFileName(fileName))
+        return false;
+
+    std::string logsDir = ConfigMgr::GetStringDefault("LogsDir", "");
+    if (!logsDir.empty() && logsDir[logsDir.length() - 1] != '/' && logsDir[logsDir.length() - 1] != '\\')
+        logsDir.push_back('/');
+
+    FILE* file = fopen((logsDir + fileName).c_str(), "w");
+    if (!file)
+        return false;
+
+    SampleList samples;
+    CollectSamples(samples);
+
+    double ticksPerMicrosecond = GetTicksPerMicrosecond();
+
+    uint64 base = 0;
+    for (SampleList::const_iterator itr = samples.begin(); itr != samples.end(); ++itr)
+        if (!base || itr->second.Start < base)
+            base = itr->second.Start;
+
+    fputs("{\"traceEvents\":[", file);
+    for (SampleList::const_iterator itr = samples.begin(); itr != samples.end(); ++itr)
+    {
+        ProfilerSample const& sample = itr->second;
+
+        if (itr != samples.begin())
+            fputc(',', file);
+
+        fputs("\n{\"name\":", file);
+        WriteJsonString(file, sample.Name);
+        fprintf(file, ",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"id\":%u}}",
+            GetCategoryName(sample.Category), itr->first, double(sample.Start - base) / ticksPerMicrosecond,
+            double(sample.End - sample.Start) / ticksPerMicrosecond, sample.Id);
+    }
+    fputs("\n]}\n", file);
+
+    fclose(file);
+    return true;
+}
@@ -0,0 +1,189 @@
+/*
+ * Copyright (C) 2008-2012 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_TICKPROFILER_H
+#define TRINITY_TICKPROFILER_H
+
+#include "Define.h"
+
+#include <ace/Singleton.h>
+#include <ace/Thread_Mutex.h>
+#include <ace/TSS_T.h>
+#include <ace/OS_NS_time.h>
+
+#include <set>
+#include <string>
+#include <vector>
+
+#if PLATFORM == PLATFORM_WINDOWS
+#  include <intrin.h>
+#  pragma intrinsic(__rdtsc)
+#endif
+
+enum ProfilerCategory
+{
+    PROFILE_WORLD           = 0,                            // World::Update
+    PROFILE_MAP             = 1,                            // whole map update, id is the map id
+    PROFILE_MAP_PHASE       = 2,                            // parts of Map::Update, id is the map id
+    PROFILE_OPCODE          = 3,                            // packet handler, id is the opcode
+    PROFILE_SCRIPT          = 4,                            // ScriptMgr hooks and script AIs, id is the entry or map id
+    PROFILE_SMARTSCRIPT     = 5,                            // SmartScript event, id is the entryOrGuid
+    PROFILE_CATEGORY_COUNT
+};
+
+struct ProfilerSample
+{
+    uint64 Start;                                           // timestamps in ticks of TickProfiler::GetTimestamp
+    uint64 End;
+    char const* Name;                                       // must stay valid for the whole server run
+    uint32 Id;
+    uint32 Category;
+};
+
+// Aggregated samples of one (category, name, id) key
+struct ProfilerEntry
+{
+    ProfilerEntry() : Category(0), Name(NULL), Id(0), Calls(0), TotalTime(0), MaxTime(0) { }
+
+    uint32 Category;
+    char const* Name;
+    uint32 Id;
+    uint32 Calls;
+    uint64 TotalTime;                                       // microseconds
+    uint64 MaxTime;                                         // microseconds
+};
+
+// Scoped, always-on profiler of the server tick.
+// Every thread records finished scopes into its own ring buffer without taking any lock, so only the
+// most recent BUFFER_SIZE samples of each thread are kept. Readers copy the buffers and drop the samples
+// that were overwritten while copying. Nested scopes show up as a hierarchy in the Chrome trace viewer.
+class TickProfiler
+{
+    friend class ACE_Singleton<TickProfiler, ACE_Thread_Mutex>;
+
+    private:
+        TickProfiler();
+        ~TickProfiler();
+
+    public:
+        enum
+        {
+            BUFFER_SIZE = 16384                             // samples per thread, power of two
+        };
+
+        static uint64 GetTimestamp()
+        {
+#if PLATFORM == PLATFORM_WINDOWS
+            return __rdtsc();
+#elif defined(__i386__) || defined(__x86_64__)
+            uint32 lo, hi;
+            __asm__ __volatile__("rdtsc" : "=a" (lo), "=d" (hi));
+            return (uint64(hi) << 32) | lo;
+#else
+            return uint64(ACE_OS::gethrtime());
+#endif
+        }
+
+        static char const* GetCategoryName(uint32 category);
+
+        bool IsEnabled() const { return _enabled; }
+        void SetEnabled(bool enabled) { _enabled = enabled; }
+
+        void Record(ProfilerCategory category, char const* name, uint32 id, uint64 start, uint64 end);
+
+        // drops all samples recorded so far
+        void Reset();
+
+        // aggregates the recorded samples, most expensive (total time) first
+        void GetTopEntries(std::vector<ProfilerEntry>& entries, uint32 count);
+
+        // returns a copy of name that stays valid for the whole server run, for names owned by reloadable data
+        char const* InternName(std::string const& name);
+
+        // file names for WriteChromeTrace must not leave LogsDir
+        static bool IsValidTraceFileName(std::string const& fileName);
+
+        // writes the recorded samples in Chrome trace event format (chrome://tracing), relative to LogsDir
+        bool WriteChromeTrace(std::string const& fileName);
+
+    private:
+        struct ThreadBuffer
+        {
+            explicit ThreadBuffer(uint32 threadId) : ThreadId(threadId), Written(0), ResetMark(0) { }
+
+            uint32 ThreadId;
+            volatile long Written;                          // samples written so far, wraps around
+            long ResetMark;                                 // samples before this position were dropped by Reset
+            ProfilerSample Samples[BUFFER_SIZE];
+        };
+
+        struct ThreadContext
+        {
+            ThreadContext() : Buffer(NULL) { }
+
+            ThreadBuffer* Buffer;
+        };
+
+        typedef std::vector<std::pair<uint32, ProfilerSample> > SampleList;
+
+        ThreadBuffer* GetThreadBuffer();
+        void CollectSamples(SampleList& samples);
+        double GetTicksPerMicrosecond() const;
+
+        bool _enabled;
+
+        ACE_Thread_Mutex _lock;                             // guards _buffers
+        std::vector<ThreadBuffer*> _buffers;                // never freed, threads come from long living pools
+        ACE_TSS<ThreadContext> _context;
+
+        ACE_Thread_Mutex _namesLock;                        // guards _names
+        std::set<std::string> _names;                       // interned names, never erased
+
+        uint64 _startTimestamp;                             // used to convert ticks into microseconds
+        uint64 _startTime;
+};
+
+#define sTickProfiler ACE_Singleton<TickProfiler, ACE_Thread_Mutex>::instance()
+
+// Records the time between its construction and destruction, scopes without a name are not recorded
+class ProfileScope
+{
+    public:
+        ProfileScope(ProfilerCategory category, char const* name, uint32 id = 0) :
+            _profiler(sTickProfiler), _category(category), _name(name), _id(id),
+            _start(name && _profiler->IsEnabled() ? TickProfiler::GetTimestamp() : 0)
+        {
+        }
+
+        ~ProfileScope()
+        {
+            if (_start)
+                _profiler->Record(_category, _name, _id, _start, TickProfiler::GetTimestamp());
+        }
+
+    private:
+        ProfileScope(ProfileScope const&);
+        ProfileScope& operator=(ProfileScope const&);
+
+        TickProfiler* _profiler;
+        ProfilerCategory _category;
+        char const* _name;
+        uint32 _id;
+        uint64 _start;
+};
+
+#endif
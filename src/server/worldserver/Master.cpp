@@ -460,6 +460,9 @@ bool Master::_StartDB()
 
 void Master::_StopDB()
 {
+    // queued rows of the logs table still need the login database
+    sLog->StopAsyncWriter();
+
     CharacterDatabase.Close();
     WorldDatabase.Close();
     LoginDatabase.Close();
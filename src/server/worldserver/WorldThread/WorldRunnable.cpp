@@ -85,6 +85,7 @@ void WorldRunnable::run()
 
     sWorld->KickAll();                                       // save and kick all players
     sWorld->UpdateSessions( 1 );                             // real players unload required UpdateSessions call
+    sWorld->GetPlayerLoginLoader()->deactivate();            // logins still being loaded have no session anymore
 
     // unload battleground templates before different singletons destroyed
     sBattlegroundMgr->DeleteAllBattlegrounds();
@@ -0,0 +1,146 @@
+/*
+ * Copyright (C) 2008-2012 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Compares the timing wheel of EventProcessor with the multimap it replaced: every unit owns a processor
+// with a few events that re-add themselves with a random delay, all processors are updated every tick.
+// usage: eventbench [units] [events per unit] [ticks] [tick length in ms]
+
+#include "Common.h"
+#include "EventProcessor.h"
+
+#include <ace/OS_NS_sys_time.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <vector>
+
+// deterministic delays, both processors see the same schedule
+static uint32 NextDelay(uint32& seed)
+{
+    seed = seed * 1103515245 + 12345;
+    uint32 value = (seed >> 8) % 1000;
+    // mostly short timers (spell ticks, ai timers), some long ones (respawns, auras)
+    return value < 900 ? 100 + value * 5 : 60000 + value * 100;
+}
+
+// the EventProcessor of before the timing wheel
+class MultimapEventProcessor
+{
+    public:
+        ~MultimapEventProcessor()
+        {
+            for (EventList::iterator itr = m_events.begin(); itr != m_events.end(); ++itr)
+                delete itr->second;
+        }
+
+        void Update(uint32 p_time)
+        {
+            m_time += p_time;
+
+            EventList::iterator i;
+            while (((i = m_events.begin()) != m_events.end()) && i->first <= m_time)
+            {
+                BasicEvent* Event = i->second;
+                m_events.erase(i);
+
+                if (Event->Execute(m_time, p_time))
+                    delete Event;
+            }
+        }
+
+        void AddEvent(BasicEvent* Event, uint64 e_time)
+        {
+            Event->m_addTime = m_time;
+            Event->m_execTime = e_time;
+            m_events.insert(std::pair<uint64, BasicEvent*>(e_time, Event));
+        }
+
+        uint64 CalculateTime(uint64 t_offset) const { return m_time + t_offset; }
+
+        MultimapEventProcessor() : m_time(0) { }
+
+    private:
+        typedef std::multimap<uint64, BasicEvent*> EventList;
+
+        EventList m_events;
+        uint64 m_time;
+};
+
+template<class Processor>
+class RepeatingEvent : public BasicEvent
+{
+    public:
+        RepeatingEvent(Processor& processor, uint32& seed, uint64& executed) : _processor(processor), _seed(seed), _executed(executed) { }
+
+        bool Execute(uint64 /*e_time*/, uint32 /*p_time*/)
+        {
+            ++_executed;
+            _processor.AddEvent(this, _processor.CalculateTime(NextDelay(_seed)));
+            return false;
+        }
+
+    private:
+        Processor& _processor;
+        uint32& _seed;
+        uint64& _executed;
+};
+
+template<class Processor>
+static void Run(char const* name, uint32 units, uint32 eventsPerUnit, uint32 ticks, uint32 tickLength)
+{
+    uint32 seed = 1;
+    uint64 executed = 0;
+
+    std::vector<Processor*> processors(units);
+    for (uint32 i = 0; i < units; ++i)
+    {
+        processors[i] = new Processor();
+        for (uint32 j = 0; j < eventsPerUnit; ++j)
+            processors[i]->AddEvent(new RepeatingEvent<Processor>(*processors[i], seed, executed), processors[i]->CalculateTime(NextDelay(seed)));
+    }
+
+    ACE_Time_Value start = ACE_OS::gettimeofday();
+    for (uint32 tick = 0; tick < ticks; ++tick)
+        for (uint32 i = 0; i < units; ++i)
+            processors[i]->Update(tickLength);
+    ACE_Time_Value elapsed = ACE_OS::gettimeofday() - start;
+
+    for (uint32 i = 0; i < units; ++i)
+        delete processors[i];
+
+    printf("%-14s %lu ms, %.2f ms per tick, " UI64FMTD " events executed\n", name, (unsigned long)elapsed.msec(),
+        double(elapsed.msec()) / ticks, executed);
+}
+
+int main(int argc, char** argv)
+{
+    uint32 units = argc > 1 ? uint32(atoi(argv[1])) : 50000;
+    uint32 eventsPerUnit = argc > 2 ? uint32(atoi(argv[2])) : 4;
+    uint32 ticks = argc > 3 ? uint32(atoi(argv[3])) : 200;
+    uint32 tickLength = argc > 4 ? uint32(atoi(argv[4])) : 50;
+    if (!units || !ticks || !tickLength)
+    {
+        printf("usage: %s [units] [events per unit] [ticks] [tick length in ms]\n", argv[0]);
+        return 1;
+    }
+
+    printf("%u units, %u events each, %u ticks of %u ms\n", units, eventsPerUnit, ticks, tickLength);
+    Run<EventProcessor>("timing wheel", units, eventsPerUnit, ticks, tickLength);
+    Run<MultimapEventProcessor>("multimap", units, eventsPerUnit, ticks, tickLength);
+    return 0;
+}
@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2008-2012 TrinityCore <http://www.trinitycore.org/>
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Compares the session receive queue (LockFreeQueue) with the LockedQueue it replaced:
+// several network threads add packets while one thread drains them, like WorldSession::Update.
+// usage: queuebench [producers] [packets per producer]
+
+#include "Threading/LockFreeQueue.h"
+#include "Threading/LockedQueue.h"
+
+#include <ace/OS_NS_sys_time.h>
+#include <ace/OS_NS_Thread.h>
+#include <ace/Thread.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+enum
+{
+    QUEUE_CAPACITY = 256                                    // MAX_QUEUED_PACKETS of WorldSession
+};
+
+typedef ACE_Based::LockFreeQueue<long, QUEUE_CAPACITY> FreeQueue;
+typedef ACE_Based::LockedQueue<long, ACE_Thread_Mutex> MutexQueue;
+
+struct ProducerArgs
+{
+    void* Queue;
+    long Count;
+};
+
+// like the network threads, a full queue is retried until the consumer made room
+static ACE_THR_FUNC_RETURN FreeQueueProducer(void* arg)
+{
+    ProducerArgs* args = static_cast<ProducerArgs*>(arg);
+    FreeQueue* queue = static_cast<FreeQueue*>(args->Queue);
+    for (long i = 1; i <= args->Count; ++i)
+        while (!queue->add(i))
+            ACE_OS::thr_yield();
+
+    return 0;
+}
+
+static ACE_THR_FUNC_RETURN MutexQueueProducer(void* arg)
+{
+    ProducerArgs* args = static_cast<ProducerArgs*>(arg);
+    MutexQueue* queue = static_cast<MutexQueue*>(args->Queue);
+    for (long i = 1; i <= args->Count; ++i)
+        queue->add(i);
+
+    return 0;
+}
+
+template<class Queue>
+static void Run(char const* name, Queue& queue, ACE_THR_FUNC producer, int producers, long count)
+{
+    ProducerArgs args;
+    args.Queue = &queue;
+    args.Count = count;
+
+    ACE_Time_Value start = ACE_OS::gettimeofday();
+    std::vector<ACE_hthread_t> threads(producers);
+    for (int i = 0; i < producers; ++i)
+        ACE_Thread::spawn(producer, &args, THR_NEW_LWP | THR_JOINABLE, NULL, &threads[i]);
+
+    long received = 0;
+    long long sum = 0;
+    long total = count * producers;
+    while (received < total)
+    {
+        long item;
+        if (queue.next(item))
+        {
+            sum += item;
+            ++received;
+        }
+        else
+            ACE_OS::thr_yield();
+    }
+
+    for (int i = 0; i < producers; ++i)
+        ACE_Thread::join(threads[i]);
+    ACE_Time_Value elapsed = ACE_OS::gettimeofday() - start;
+
+    long long expected = (long long)producers * count * (count + 1) / 2;
+    printf("%-14s %ld items in %lu ms, %.1f ns per item%s\n", name, total, (unsigned long)elapsed.msec(),
+        total ? elapsed.msec() * 1000000.0 / total : 0.0, sum == expected ? "" : " (ITEMS LOST)");
+}
+
+int main(int argc, char** argv)
+{
+    int producers = argc > 1 ? atoi(argv[1]) : 4;
+    long count = argc > 2 ? atol(argv[2]) : 1000000;
+    if (producers < 1 || count < 1)
+    {
+        printf("usage: %s [producers] [packets per producer]\n", argv[0]);
+        return 1;
+    }
+
+    printf("%d producers, %ld packets each, one consumer\n", producers, count);
+
+    FreeQueue* freeQueue = new FreeQueue();
+    Run("LockFreeQueue", *freeQueue, FreeQueueProducer, producers, count);
+    delete freeQueue;
+
+    MutexQueue mutexQueue;
+    Run("LockedQueue", mutexQueue, MutexQueueProducer, producers, count);
+    return 0;
+}